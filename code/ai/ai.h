@@ -550,6 +550,9 @@ void ai_free_slot(int ai_index);
 // stuff by adding new paramters.
 void ai_object_init(object * obj, int ai_index);
 
+// Called once a frame before any ship is moved, does the work of ai_process() that can be done for all ships at once
+void ai_think_all();
+
 // Called once a frame
 void ai_process( object * obj, int ai_index, float frametime );
 
@@ -66,6 +66,8 @@
 #include "ship/ship.h"
 #include "ship/shipfx.h"
 #include "ship/shiphit.h"
+#include "tracing/tracing.h"
+#include "utils/parallel.h"
 #include "weapon/beam.h"
 #include "weapon/flak.h"
 #include "weapon/swarm.h"
@@ -1688,16 +1690,13 @@ int object_is_targetable(object *target, ship *viewer)
  */
 int num_enemies_attacking(int objnum)
 {
-	object		*objp;
 	ship			*sp;
 	ship_subsys	*ssp;
-	ship_obj		*so;
 	int			count;
 
 	count = 0;
 
-	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-		objp = &Objects[so->objnum];
+	for ( auto objp : obj_type_range(OBJ_SHIP) ) {
 		Assert(objp->instance != -1);
 		sp = &Ships[objp->instance];
 
@@ -1931,6 +1930,7 @@ typedef struct eval_nearest_objnum {
 	int	nearest_objnum;
 	float	nearest_dist;
 	int	check_danger_weapon_objnum;
+	const int	*attacker_counts;	//	Number of enemies attacking each object at the start of the frame, NULL to count them now
 } eval_nearest_objnum;
 
 
@@ -2012,7 +2012,11 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 					dist = dist * 0.5f;
 				}
 
-				num_attacking = num_enemies_attacking(OBJ_INDEX(eno->trial_objp));
+				if (eno->attacker_counts != NULL) {
+					num_attacking = eno->attacker_counts[OBJ_INDEX(eno->trial_objp)];
+				} else {
+					num_attacking = num_enemies_attacking(OBJ_INDEX(eno->trial_objp));
+				}
                 
                 if (!sip->is_big_or_huge() && num_attacking < eno->max_attackers) {
                     dist *= (float)(num_attacking + 2) / 2.0f;				//	prevents lots of ships from attacking same target
@@ -2035,6 +2039,7 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
 
 }
 
+static int get_nearest_objnum_sub(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, const int *attacker_counts);
 
 /**
  * Given an object and an enemy team, return the index of the nearest enemy object.
@@ -2048,6 +2053,17 @@ void evaluate_object_as_nearest_objnum(eval_nearest_objnum *eno)
  * @param ship_info_index	If >=0, the enemy object must be of the specified ship class
  */
 int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index)
+{
+	return get_nearest_objnum_sub(objnum, enemy_team_mask, enemy_wing, range, max_attackers, ship_info_index, NULL);
+}
+
+/**
+ * Does the work of get_nearest_objnum().
+ *
+ * If attacker_counts is not NULL it is used instead of num_enemies_attacking() and the search does not modify any
+ * shared state, so it can run for several ships at once.
+ */
+static int get_nearest_objnum_sub(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index, const int *attacker_counts)
 {
 	object	*danger_weapon_objp;
 	ai_info	*aip;
@@ -2064,6 +2080,7 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	eno.nearest_dist = range;
 	eno.nearest_objnum = -1;
 	eno.check_danger_weapon_objnum = 0;
+	eno.attacker_counts = attacker_counts;
 
 	// go through the list of all ships and evaluate as potential targets
 	for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
@@ -2099,7 +2116,7 @@ int get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float ra
 	//	If only looking for target in certain wing and couldn't find anything in
 	//	that wing, look for any object.
 	if ((eno.nearest_objnum == -1) && (enemy_wing != -1)) {
-		return get_nearest_objnum(objnum, enemy_team_mask, -1, range, max_attackers, ship_info_index);
+		return get_nearest_objnum_sub(objnum, enemy_team_mask, -1, range, max_attackers, ship_info_index, attacker_counts);
 	}
 
 	return eno.nearest_objnum;
@@ -2198,6 +2215,65 @@ int get_enemy_timestamp()
 	return (NUM_SKILL_LEVELS - Game_skill_level) * ( (myrand() % 500) + 500);
 }
 
+// The result of the enemy search ai_think_all() did for a ship at the start of the frame
+typedef struct ai_think_info {
+	int	frame;					//	Framecount of the search, results of earlier frames are never used
+	int	objnum;					//	The searching ship
+	int	signature;
+	int	enemy_team_mask;
+	int	enemy_wing;
+	int	max_attackers;
+	int	nearest_objnum;			//	-1 if there is no enemy in range
+	int	nearest_signature;
+} ai_think_info;
+
+static ai_think_info Ai_think_info[MAX_AI_INFO];
+
+// Number of enemies attacking each object at the start of the frame, indexed by object number
+static SCP_vector<int> Ai_think_attacker_counts;
+static SCP_vector<int> Ai_think_objnums;
+
+// A single enemy search looks at every ship so it is worth handing off even small groups of ships
+static const size_t AI_THINK_MIN_CHUNK_SIZE = 4;
+
+/**
+ * Return the enemy found for objnum by ai_think_all() if it can stand in for a search now, else return -2.
+ */
+static int ai_think_get_nearest_objnum(int objnum, int enemy_team_mask, int enemy_wing, float range, int max_attackers, int ship_info_index)
+{
+	ai_think_info *tip = &Ai_think_info[Ships[Objects[objnum].instance].ai_index];
+
+	if ((tip->frame != Framecount) || (tip->objnum != objnum) || (tip->signature != Objects[objnum].signature)) {
+		return -2;
+	}
+
+	// only the search ai_frame() does when a ship needs a new target is done in advance
+	if ((range != MAX_ENEMY_DISTANCE) || (ship_info_index >= 0) || (tip->enemy_team_mask != enemy_team_mask)
+		|| (tip->enemy_wing != enemy_wing) || (tip->max_attackers != max_attackers)) {
+		return -2;
+	}
+
+	// a result is only good once
+	tip->frame = -1;
+
+	if (tip->nearest_objnum < 0) {
+		return -1;
+	}
+
+	// the ships handled earlier in this frame may have picked the same enemy
+	object *enemy_objp = &Objects[tip->nearest_objnum];
+	if ((enemy_objp->signature != tip->nearest_signature) || (enemy_objp->type != OBJ_SHIP)
+		|| (Ships[enemy_objp->instance].flags[Ship::Ship_Flags::Dying])) {
+		return -2;
+	}
+
+	if (!Ship_info[Ships[enemy_objp->instance].ship_info_index].is_big_or_huge() && (num_enemies_attacking(tip->nearest_objnum) >= max_attackers)) {
+		return -2;
+	}
+
+	return tip->nearest_objnum;
+}
+
 /**
  * Return objnum if enemy found, else return -1;
  *
@@ -2237,6 +2313,11 @@ int find_enemy(int objnum, float range, int max_attackers, int ship_info_index)
 			}
 		}
 		
+		int nearest_objnum = ai_think_get_nearest_objnum(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, ship_info_index);
+		if (nearest_objnum != -2) {
+			return nearest_objnum;
+		}
+
 		return get_nearest_objnum(objnum, enemy_team_mask, aip->enemy_wing, range, max_attackers, ship_info_index);
 		
 	} else {
@@ -14151,6 +14232,87 @@ static void ai_control_info_check(ai_info *aip, physics_info *pi)
 
 int Last_ai_obj = -1;
 
+/**
+ * Search enemies for all ships which will look for one in ai_frame() this frame.
+ *
+ * The searches only read the state of the world at the start of the frame, with the number of enemies attacking each
+ * ship counted once up front, so they are done on all cores. find_enemy() picks up the results while the ships are
+ * processed in order and does a search of its own if the enemy has become unsuitable in the meantime. The results do
+ * not depend on the number of threads.
+ */
+void ai_think_all()
+{
+	TRACE_SCOPE(tracing::AIThink);
+
+	if (MULTIPLAYER_CLIENT) {
+		return;
+	}
+
+	Ai_think_attacker_counts.assign(MAX_OBJECTS, 0);
+	Ai_think_objnums.clear();
+
+	for ( auto objp : obj_type_range(OBJ_SHIP) ) {
+		ship *shipp = &Ships[objp->instance];
+		ai_info *aip = &Ai_info[shipp->ai_index];
+
+		if ((aip->target_objnum >= 0) && (aip->target_objnum < MAX_OBJECTS)) {
+			Ai_think_attacker_counts[aip->target_objnum]++;
+		}
+
+		// consider turrets that may be attacking objnum (but only turrets on SIF_BIG_SHIP ships)
+		if (Ship_info[shipp->ship_info_index].is_big_ship()) {
+			for (ship_subsys *ssp = GET_FIRST(&shipp->subsys_list); ssp != END_OF_LIST(&shipp->subsys_list); ssp = GET_NEXT(ssp)) {
+				if ((ssp->system_info->type == SUBSYSTEM_TURRET) && (ssp->current_hits > 0)
+					&& (ssp->turret_enemy_objnum >= 0) && (ssp->turret_enemy_objnum < MAX_OBJECTS)) {
+					Ai_think_attacker_counts[ssp->turret_enemy_objnum]++;
+				}
+			}
+		}
+
+		Ai_think_info[shipp->ai_index].frame = -1;
+
+		// the same conditions ai_frame() checks before calling find_enemy()
+		if (objp->flags[Object::Object_Flags::Should_be_dead] || shipp->flags[Ship::Ship_Flags::Dying]) {
+			continue;
+		}
+		if ((objp->flags[Object::Object_Flags::Player_ship]) && !Player_use_ai) {
+			continue;
+		}
+		if (!timestamp_elapsed(aip->choose_enemy_timestamp) || !ai_need_new_target(objp, aip->target_objnum)) {
+			continue;
+		}
+
+		ship_info *sip = &Ship_info[shipp->ship_info_index];
+		if ((sip->class_type < 0) || !(Ship_types[sip->class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks])) {
+			continue;
+		}
+
+		Ai_think_objnums.push_back(OBJ_INDEX(objp));
+	}
+
+	const int max_attackers = The_mission.ai_profile->max_attackers[Game_skill_level];
+	const int frame = Framecount;
+
+	util::parallel_for(Ai_think_objnums.size(), AI_THINK_MIN_CHUNK_SIZE, [max_attackers, frame](size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i) {
+			int objnum = Ai_think_objnums[i];
+			object *objp = &Objects[objnum];
+			ai_info *aip = &Ai_info[Ships[objp->instance].ai_index];
+			ai_think_info *tip = &Ai_think_info[Ships[objp->instance].ai_index];
+
+			tip->objnum = objnum;
+			tip->signature = objp->signature;
+			tip->enemy_team_mask = iff_get_attackee_mask(obj_team(objp));
+			tip->enemy_wing = aip->enemy_wing;
+			tip->max_attackers = max_attackers;
+			tip->nearest_objnum = get_nearest_objnum_sub(objnum, tip->enemy_team_mask, tip->enemy_wing, MAX_ENEMY_DISTANCE,
+				max_attackers, -1, Ai_think_attacker_counts.data());
+			tip->nearest_signature = (tip->nearest_objnum >= 0) ? Objects[tip->nearest_objnum].signature : -1;
+			tip->frame = frame;
+		}
+	});
+}
+
 void ai_process( object * obj, int ai_index, float frametime )
 {
 	if (obj->flags[Object::Object_Flags::Should_be_dead])
@@ -798,6 +798,140 @@ int is_target_beam_valid(ship_weapon *swp, object *objp)
 	return 1;
 }
 
+// An object the turrets of a ship may pick as target. The signature catches objects that were deleted during the frame.
+typedef struct turret_candidate {
+	object	*objp;
+	int		signature;
+} turret_candidate;
+
+// Objects the turrets of a ship could target, gathered once per frame for all turrets of that ship. Everything that
+// only depends on the ship and not on the individual turret is checked here so that each turret only has to look at
+// the few objects that are left.
+typedef struct turret_candidate_cache {
+	int		parent_objnum = -1;
+	int		parent_signature = -1;
+	int		framecount = -1;
+	int		enemy_team_mask = 0;
+
+	SCP_vector<turret_candidate>	objects;		// All candidates, in obj_used_list order
+	SCP_vector<turret_candidate>	bombs;			// Bombs and interceptable weapons, in Missile_obj_list order
+	SCP_vector<turret_candidate>	ships;			// in Ship_obj_list order
+	SCP_vector<turret_candidate>	asteroids;		// in Asteroid_obj_list order
+} turret_candidate_cache;
+
+static turret_candidate_cache Turret_candidates;
+
+static bool turret_candidate_valid(const turret_candidate &candidate)
+{
+	return candidate.objp->signature == candidate.signature && candidate.objp->type != OBJ_NONE;
+}
+
+/**
+ * Can an object ever be picked by evaluate_obj_as_target() for any turret of the parent ship?
+ *
+ * @param objp              Object to test
+ * @param turret_parent     Ship the turrets sit on
+ * @param enemy_team_mask   OR'ed TEAM_ flags for the enemy of the turret parent ship
+ * @param max_range         Longest range of all turrets of the parent ship
+ */
+static bool turret_candidate_possible(object *objp, object *turret_parent, int enemy_team_mask, float max_range)
+{
+	if ( !valid_turret_enemy(objp, turret_parent) ) {
+		return false;
+	}
+
+	if (objp->type == OBJ_SHIP) {
+		if ( !iff_matches_mask(Ships[objp->instance].team, enemy_team_mask) ) {
+			return false;
+		}
+
+		// Ships are only attacked within the range of a turret, which may sit anywhere on the parent ship. That range
+		// is checked with vm_vec_mag_quick() which can be about 10% shorter than the real distance.
+		float dist = vm_vec_dist(&objp->pos, &turret_parent->pos) - turret_parent->radius;
+		if (0.88f * dist - objp->radius >= max_range) {
+			return false;
+		}
+	} else if (objp->type == OBJ_ASTEROID) {
+		if (asteroid_collide_objnum(objp) != OBJ_INDEX(turret_parent)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void turret_candidates_build(turret_candidate_cache *cache, int turret_parent_objnum, int enemy_team_mask)
+{
+	object *turret_parent = &Objects[turret_parent_objnum];
+	ship *parent_shipp = &Ships[turret_parent->instance];
+
+	cache->parent_objnum = turret_parent_objnum;
+	cache->parent_signature = turret_parent->signature;
+	cache->framecount = Framecount;
+	cache->enemy_team_mask = enemy_team_mask;
+
+	cache->objects.clear();
+	cache->bombs.clear();
+	cache->ships.clear();
+	cache->asteroids.clear();
+
+	float max_range = 0.0f;
+	for (auto ss = GET_FIRST(&parent_shipp->subsys_list); ss != END_OF_LIST(&parent_shipp->subsys_list); ss = GET_NEXT(ss)) {
+		if (ss->system_info->type == SUBSYSTEM_TURRET) {
+			max_range = MAX(max_range, longest_turret_weapon_range(&ss->weapons));
+		}
+	}
+
+	for (auto objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
+		if (turret_candidate_possible(objp, turret_parent, enemy_team_mask, max_range)) {
+			cache->objects.push_back({objp, objp->signature});
+		}
+	}
+
+	for (auto mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo)) {
+		auto objp = &Objects[mo->objnum];
+		Assert(objp->type == OBJ_WEAPON);
+
+		auto wip = &Weapon_info[Weapons[objp->instance].weapon_info_index];
+		if ( (wip->wi_flags[Weapon::Info_Flags::Bomb] || wip->wi_flags[Weapon::Info_Flags::Turret_Interceptable]) &&
+			turret_candidate_possible(objp, turret_parent, enemy_team_mask, max_range) ) {
+			cache->bombs.push_back({objp, objp->signature});
+		}
+	}
+
+	for (auto so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+		auto objp = &Objects[so->objnum];
+		if (turret_candidate_possible(objp, turret_parent, enemy_team_mask, max_range)) {
+			cache->ships.push_back({objp, objp->signature});
+		}
+	}
+
+	for (auto ao = GET_FIRST(&Asteroid_obj_list); ao != END_OF_LIST(&Asteroid_obj_list); ao = GET_NEXT(ao)) {
+		auto objp = &Objects[ao->objnum];
+		if (turret_candidate_possible(objp, turret_parent, enemy_team_mask, max_range)) {
+			cache->asteroids.push_back({objp, objp->signature});
+		}
+	}
+}
+
+/**
+ * Returns the target candidates for the turrets of a ship, building them if this is the first turret of the ship
+ * looking for a target this frame.
+ */
+static const turret_candidate_cache &turret_get_candidates(int turret_parent_objnum, int enemy_team_mask)
+{
+	// The turrets of a ship are processed one after another so remembering the last ship is enough
+	auto cache = &Turret_candidates;
+
+	if ( (cache->parent_objnum != turret_parent_objnum) ||
+		(cache->parent_signature != Objects[turret_parent_objnum].signature) ||
+		(cache->framecount != Framecount) || (cache->enemy_team_mask != enemy_team_mask) ) {
+		turret_candidates_build(cache, turret_parent_objnum, enemy_team_mask);
+	}
+
+	return *cache;
+}
+
 /**
  * Given an object and an enemy team, return the index of the nearest enemy object.
  *
@@ -819,13 +953,11 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 {
 	//float					weapon_travel_dist;
 	int					weapon_system_ok;
-	object				*objp;
 	eval_enemy_obj_struct eeo;
 	ship_weapon *swp = &turret_subsys->weapons;
 
 	// list of stuff to go thru
-	ship_obj		*so;
-	missile_obj *mo;
+	auto &candidates = turret_get_candidates(turret_parent_objnum, enemy_team_mask);
 
 	//wip=&Weapon_info[tp->turret_weapon_type];
 	//weapon_travel_dist = MIN(wip->lifetime * wip->max_speed, wip->weapon_range);
@@ -916,9 +1048,13 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 			int n_w_classes = (int)tt->weapon_class.size();
 			
 			bool found_something;
-			object *ptr = GET_FIRST(&obj_used_list);
-			
-			while (ptr != END_OF_LIST(&obj_used_list)) {
+
+			for (auto &candidate : candidates.objects) {
+				if (!turret_candidate_valid(candidate)) {
+					continue;
+				}
+
+				object *ptr = candidate.objp;
 				found_something = false;
 
 				if(tt->obj_type > -1 && (ptr->type == tt->obj_type)) {
@@ -969,15 +1105,11 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 				if(!(found_something)) {
 					//we didnt find this object within this priority group
 					//skip to next without evaluating the object as target
-					ptr = GET_NEXT(ptr);
-
 					continue;
 				}
 
 
 				evaluate_obj_as_target(ptr, &eeo);
-
-				ptr = GET_NEXT(ptr);
 			}
 
 			//homing weapon entry...
@@ -1047,13 +1179,9 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 					if ( !((aip->ai_profile_flags[AI::Profile_Flags::Huge_turret_weapons_ignore_bombs]) && big_only_flag) )
 					{
 						// Missile_obj_list
-						for( mo = GET_FIRST(&Missile_obj_list); mo != END_OF_LIST(&Missile_obj_list); mo = GET_NEXT(mo) ) {
-							objp = &Objects[mo->objnum];
-							
-							Assert(objp->type == OBJ_WEAPON);
-							if ((Weapon_info[Weapons[objp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Bomb]) || (Weapon_info[Weapons[objp->instance].weapon_info_index].wi_flags[Weapon::Info_Flags::Turret_Interceptable]))
-							{
-								evaluate_obj_as_target(objp, &eeo);
+						for (auto &candidate : candidates.bombs) {
+							if (turret_candidate_valid(candidate)) {
+								evaluate_obj_as_target(candidate.objp, &eeo);
 							}
 						}
 						// highest priority
@@ -1068,9 +1196,10 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 				case 1:
 					//Return if a ship is found
 					// Ship_used_list
-					for ( so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
-						objp = &Objects[so->objnum];
-						evaluate_obj_as_target(objp, &eeo);
+					for (auto &candidate : candidates.ships) {
+						if (turret_candidate_valid(candidate)) {
+							evaluate_obj_as_target(candidate.objp, &eeo);
+						}
 					}
 
 					Assert(eeo.nearest_attacker_objnum < 0 || is_target_beam_valid(swp, &Objects[eeo.nearest_attacker_objnum]));
@@ -1083,8 +1212,6 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 				case 2:
 					//Return if an asteroid is found
 					// asteroid check - taylor
-					asteroid_obj *ao;
-
 					// don't use turrets that are better for other things:
 					// - no cap ship beams
 					// - no flak
@@ -1097,9 +1224,10 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
                     
 					if ( !all_turret_weapons_have_flags(swp, tmp_flagset) ) {
 						// Asteroid_obj_list
-						for ( ao = GET_FIRST(&Asteroid_obj_list); ao != END_OF_LIST(&Asteroid_obj_list); ao = GET_NEXT(ao) ) {
-							objp = &Objects[ao->objnum];
-							evaluate_obj_as_target(objp, &eeo);
+						for (auto &candidate : candidates.asteroids) {
+							if (turret_candidate_valid(candidate)) {
+								evaluate_obj_as_target(candidate.objp, &eeo);
+							}
 						}
 
 						if (eeo.nearest_objnum != -1) {
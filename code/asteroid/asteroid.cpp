@@ -35,10 +35,12 @@
 #include "scripting/scripting.h"
 #include "particle/particle.h"
 #include "render/3d.h"
+#include "render/3dinternal.h"
 #include "ship/ship.h"
 #include "ship/shiphit.h"
 #include "species_defs/species_defs.h"
 #include "stats/scoring.h"
+#include "tracing/tracing.h"
 #include "weapon/weapon.h"
 
 #include <algorithm>
@@ -73,6 +75,127 @@ float	Asteroid_icon_closeup_zoom;
 #define	ASTEROID_UPDATE_COLLIDE_TIMESTAMP	2000	// how often asteroid is checked for impending collisions with escort ships
 #define	ASTEROID_MIN_COLLIDE_TIME				24		// time in seconds to check for asteroid colliding
 
+#define	ASTEROID_INTERACTION_RANGE			1500.0f	// far asteroids closer than this to a ship become full objects
+#define	ASTEROID_DEMOTE_RANGE				2000.0f	// full asteroids farther than this from all ships may become far asteroids again
+#define	ASTEROID_FAR_CHECK_TIME				0.5f	// time in seconds until every far asteroid has been checked for promotion
+#define	ASTEROID_RESERVED_SLOTS				32		// slots left free for thrown asteroids and asteroids breaking up
+
+int	Asteroid_tiers_enabled = 1;
+
+// Whether the current mission keeps distant asteroids in the far field, decided by asteroid_create_all()
+static bool Asteroid_tiers_active = false;
+
+/**
+ * Asteroids that are far away from all ships
+ *
+ * These are not objects and only store what is needed to move, wrap and render them. They are stored as separate
+ * arrays so the per frame update only touches the data it needs. A far asteroid becomes a full object as soon as a ship
+ * comes within ::ASTEROID_INTERACTION_RANGE, see asteroid_far_field_promote().
+ */
+typedef struct asteroid_far_field {
+	SCP_vector<float>	pos_x, pos_y, pos_z;
+	SCP_vector<float>	vel_x, vel_y, vel_z;
+	SCP_vector<angles>	orient;
+	SCP_vector<angles>	rotvel;			// change of orient per second
+	SCP_vector<float>	radius;
+	SCP_vector<int>		asteroid_type;
+	SCP_vector<int>		asteroid_subtype;
+
+	size_t size() const { return pos_x.size(); }
+} asteroid_far_field;
+
+static asteroid_far_field Asteroid_far_field;
+
+// Next far asteroid to check for promotion, the checks are spread over ::ASTEROID_FAR_CHECK_TIME
+static size_t Asteroid_far_check_index = 0;
+static bool Asteroid_far_check_all = false;
+
+// The ships asteroids can interact with, gathered once per frame
+typedef struct asteroid_interactor {
+	vec3d	pos;
+	float	radius;
+} asteroid_interactor;
+
+static SCP_vector<asteroid_interactor> Asteroid_interactors;
+
+void asteroid_far_field_clear()
+{
+	Asteroid_far_field = asteroid_far_field();
+	Asteroid_far_check_index = 0;
+	Asteroid_far_check_all = false;
+	Asteroid_interactors.clear();
+}
+
+static void asteroid_far_field_add(const vec3d *pos, const vec3d *vel, const angles *orient, const angles *rotvel, float radius, int asteroid_type, int asteroid_subtype)
+{
+	auto& field = Asteroid_far_field;
+
+	field.pos_x.push_back(pos->xyz.x);
+	field.pos_y.push_back(pos->xyz.y);
+	field.pos_z.push_back(pos->xyz.z);
+	field.vel_x.push_back(vel->xyz.x);
+	field.vel_y.push_back(vel->xyz.y);
+	field.vel_z.push_back(vel->xyz.z);
+	field.orient.push_back(*orient);
+	field.rotvel.push_back(*rotvel);
+	field.radius.push_back(radius);
+	field.asteroid_type.push_back(asteroid_type);
+	field.asteroid_subtype.push_back(asteroid_subtype);
+}
+
+/**
+ * Remove a far asteroid by moving the last one into its place
+ */
+static void asteroid_far_field_remove(size_t index)
+{
+	auto& field = Asteroid_far_field;
+	auto last = field.size() - 1;
+
+	Assert(index <= last);
+
+	field.pos_x[index] = field.pos_x[last];
+	field.pos_y[index] = field.pos_y[last];
+	field.pos_z[index] = field.pos_z[last];
+	field.vel_x[index] = field.vel_x[last];
+	field.vel_y[index] = field.vel_y[last];
+	field.vel_z[index] = field.vel_z[last];
+	field.orient[index] = field.orient[last];
+	field.rotvel[index] = field.rotvel[last];
+	field.radius[index] = field.radius[last];
+	field.asteroid_type[index] = field.asteroid_type[last];
+	field.asteroid_subtype[index] = field.asteroid_subtype[last];
+
+	field.pos_x.pop_back();
+	field.pos_y.pop_back();
+	field.pos_z.pop_back();
+	field.vel_x.pop_back();
+	field.vel_y.pop_back();
+	field.vel_z.pop_back();
+	field.orient.pop_back();
+	field.rotvel.pop_back();
+	field.radius.pop_back();
+	field.asteroid_type.pop_back();
+	field.asteroid_subtype.pop_back();
+}
+
+/**
+ * Distance from an asteroid to the closest ship surface it could interact with
+ */
+static float asteroid_interactor_dist(const vec3d *pos, float radius)
+{
+	float closest = FLT_MAX;
+
+	for (auto& interactor : Asteroid_interactors) {
+		float dist = vm_vec_dist(pos, &interactor.pos) - interactor.radius - radius;
+
+		if (dist < closest) {
+			closest = dist;
+		}
+	}
+
+	return closest;
+}
+
 /**
  * Force updating of pair stuff for asteroid *objp.
  */
@@ -224,6 +347,14 @@ static void inner_bound_pos_fixup(asteroid_field *asfieldp, vec3d *pos)
 	}
 }
 
+/**
+ * Hull strength of a new asteroid
+ */
+static float asteroid_get_initial_strength(asteroid_info *asip)
+{
+	return asip->initial_asteroid_strength * (0.8f + (float)Game_skill_level/NUM_SKILL_LEVELS)/2.0f;
+}
+
 /**
  * Create a single asteroid 
  */
@@ -394,7 +525,7 @@ object *asteroid_create(asteroid_field *asfieldp, int asteroid_type, int asteroi
 	objp->phys_info.I_body_inv.vec.rvec.xyz.x = 1.0f / (objp->phys_info.mass*asip->modelp[asteroid_subtype]->rad);
 	objp->phys_info.I_body_inv.vec.uvec.xyz.y = objp->phys_info.I_body_inv.vec.rvec.xyz.x;
 	objp->phys_info.I_body_inv.vec.fvec.xyz.z = objp->phys_info.I_body_inv.vec.rvec.xyz.x;
-	objp->hull_strength = asip->initial_asteroid_strength * (0.8f + (float)Game_skill_level/NUM_SKILL_LEVELS)/2.0f;
+	objp->hull_strength = asteroid_get_initial_strength(asip);
 
 	// ensure vel is valid
 	Assert( !vm_is_vec_nan(&objp->phys_info.vel) );	
@@ -443,6 +574,45 @@ void asteroid_sub_create(object *parent_objp, int asteroid_type, vec3d *relvec)
 	vm_vec_scale_add(&new_objp->last_pos, &new_objp->pos, &new_objp->phys_info.vel, -flFrametime);
 }
 
+/**
+ * Add a far asteroid at a random position of the field, this matches what asteroid_create() does for full asteroids
+ */
+static void asteroid_far_field_create(asteroid_field *asfieldp, int asteroid_type, int asteroid_subtype)
+{
+	asteroid_info *asip = &Asteroid_info[asteroid_type];
+
+	if (asip->modelp[asteroid_subtype] == NULL) {
+		return;
+	}
+
+	vec3d pos, delta_bound, vel, rand_vec;
+	angles orient, rotvel;
+
+	vm_vec_sub(&delta_bound, &asfieldp->max_bound, &asfieldp->min_bound);
+
+	pos.xyz.x = asfieldp->min_bound.xyz.x + delta_bound.xyz.x * frand();
+	pos.xyz.y = asfieldp->min_bound.xyz.y + delta_bound.xyz.y * frand();
+	pos.xyz.z = asfieldp->min_bound.xyz.z + delta_bound.xyz.z * frand();
+
+	inner_bound_pos_fixup(asfieldp, &pos);
+	orient.p = frand() * PI2;
+	orient.b = frand() * PI2;
+	orient.h = frand() * PI2;
+
+	vm_vec_rand_vec_quick(&rand_vec);
+	vm_vec_scale(&rand_vec, frand()/4.0f + 0.1f);
+	rotvel.p = rand_vec.xyz.x;
+	rotvel.h = rand_vec.xyz.y;
+	rotvel.b = rand_vec.xyz.z;
+
+	vm_vec_rand_vec_quick(&vel);
+	vm_vec_scale(&vel, asteroid_cap_speed(asteroid_type, asfieldp->speed*frand_range(0.5f + (float) Game_skill_level/NUM_SKILL_LEVELS, 2.0f + (float) (2*Game_skill_level)/NUM_SKILL_LEVELS)));
+
+	float radius = model_get_radius(asip->model_num[asteroid_subtype]);
+
+	asteroid_far_field_add(&pos, &vel, &orient, &rotvel, radius, asteroid_type, asteroid_subtype);
+}
+
 /**
  * Load in an asteroid model
  */
@@ -539,6 +709,15 @@ void asteroid_create_all()
 
 	int max_asteroids = Asteroid_field.num_initial_asteroids; // * (1.0f - 0.1f*(MAX_DETAIL_LEVEL-Detail.asteroid_density)));
 
+	// Multiplayer keeps every asteroid as an object since the asteroids are synchronized through their net signatures
+	Asteroid_tiers_active = Asteroid_tiers_enabled && !(Game_mode & GM_MULTIPLAYER);
+
+	int max_count = Asteroid_tiers_active ? MAX_FIELD_ASTEROIDS : MAX_ASTEROIDS;
+	if (max_asteroids > max_count) {
+		mprintf(("Asteroid field has %d asteroids but only %d are supported, reducing the number of asteroids.\n", max_asteroids, max_count));
+		max_asteroids = max_count;
+	}
+
 	int num_debris_types = 0;
 
 	// get number of ship debris types
@@ -594,7 +773,11 @@ void asteroid_create_all()
 				subtype = (subtype + 1) % NUM_DEBRIS_POFS;
 			}
 
-			asteroid_create(&Asteroid_field, ASTEROID_TYPE_LARGE, subtype);
+			if (Asteroid_tiers_active) {
+				asteroid_far_field_create(&Asteroid_field, ASTEROID_TYPE_LARGE, subtype);
+			} else {
+				asteroid_create(&Asteroid_field, ASTEROID_TYPE_LARGE, subtype);
+			}
 		} else {
 			Assert(num_debris_types > 0);
 
@@ -603,12 +786,19 @@ void asteroid_create_all()
 			for (idx=0; idx<MAX_ACTIVE_DEBRIS_TYPES; idx++) {
 				// for ship debris, choose type according to odds table
 				if (rand_choice < ship_debris_odds_table[idx].random_threshold) {
-					asteroid_create(&Asteroid_field, ship_debris_odds_table[idx].debris_type, 0);
+					if (Asteroid_tiers_active) {
+						asteroid_far_field_create(&Asteroid_field, ship_debris_odds_table[idx].debris_type, 0);
+					} else {
+						asteroid_create(&Asteroid_field, ship_debris_odds_table[idx].debris_type, 0);
+					}
 					break;
 				}
 			}
 		}
 	}
+
+	// asteroids that start close to a ship have to be objects right away
+	Asteroid_far_check_all = true;
 }
 
 /**
@@ -620,6 +810,8 @@ void asteroid_level_init()
 	Num_asteroids = 0;
 	Next_asteroid_throw = timestamp(1);
 	asteroid_obj_list_init();
+	asteroid_far_field_clear();
+	Asteroid_tiers_active = false;
 	SCP_vector<asteroid_info>::iterator ast;
 	for (ast = Asteroid_info.begin(); ast != Asteroid_info.end(); ++ast)
 		ast->damage_type_idx = ast->damage_type_idx_sav;
@@ -631,40 +823,40 @@ void asteroid_level_init()
  *
  * @return !0 if asteroid should be wrapped, 0 otherwise.  
  */
-static int asteroid_should_wrap(object *objp, asteroid_field *asfieldp)
+static int asteroid_should_wrap(const vec3d *pos, asteroid_field *asfieldp)
 {
 	if ( MULTIPLAYER_CLIENT )
 		return 0;
 
-	if (objp->pos.xyz.x < asfieldp->min_bound.xyz.x) {
+	if (pos->xyz.x < asfieldp->min_bound.xyz.x) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.y < asfieldp->min_bound.xyz.y) {
+	if (pos->xyz.y < asfieldp->min_bound.xyz.y) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.z < asfieldp->min_bound.xyz.z) {
+	if (pos->xyz.z < asfieldp->min_bound.xyz.z) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.x > asfieldp->max_bound.xyz.x) {
+	if (pos->xyz.x > asfieldp->max_bound.xyz.x) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.y > asfieldp->max_bound.xyz.y) {
+	if (pos->xyz.y > asfieldp->max_bound.xyz.y) {
 		return 1;
 	}
 
-	if (objp->pos.xyz.z > asfieldp->max_bound.xyz.z) {
+	if (pos->xyz.z > asfieldp->max_bound.xyz.z) {
 		return 1;
 	}
 
 	// check against inner bound
 	if (asfieldp->has_inner_bound) {
-		if ( (objp->pos.xyz.x > asfieldp->inner_min_bound.xyz.x) && (objp->pos.xyz.x < asfieldp->inner_max_bound.xyz.x)
-		  && (objp->pos.xyz.y > asfieldp->inner_min_bound.xyz.y) && (objp->pos.xyz.y < asfieldp->inner_max_bound.xyz.y)
-		  && (objp->pos.xyz.z > asfieldp->inner_min_bound.xyz.z) && (objp->pos.xyz.z < asfieldp->inner_max_bound.xyz.z) ) {
+		if ( (pos->xyz.x > asfieldp->inner_min_bound.xyz.x) && (pos->xyz.x < asfieldp->inner_max_bound.xyz.x)
+		  && (pos->xyz.y > asfieldp->inner_min_bound.xyz.y) && (pos->xyz.y < asfieldp->inner_max_bound.xyz.y)
+		  && (pos->xyz.z > asfieldp->inner_min_bound.xyz.z) && (pos->xyz.z < asfieldp->inner_max_bound.xyz.z) ) {
 
 			return 1;
 		}
@@ -676,34 +868,34 @@ static int asteroid_should_wrap(object *objp, asteroid_field *asfieldp)
 /**
  * Wrap an asteroid from one end of the asteroid field to the other
  */
-static void asteroid_wrap_pos(object *objp, asteroid_field *asfieldp)
+static void asteroid_wrap_pos(vec3d *pos, asteroid_field *asfieldp)
 {
-	if (objp->pos.xyz.x < asfieldp->min_bound.xyz.x) {
-		objp->pos.xyz.x = asfieldp->max_bound.xyz.x + (objp->pos.xyz.x - asfieldp->min_bound.xyz.x);
+	if (pos->xyz.x < asfieldp->min_bound.xyz.x) {
+		pos->xyz.x = asfieldp->max_bound.xyz.x + (pos->xyz.x - asfieldp->min_bound.xyz.x);
 	}
 
-	if (objp->pos.xyz.y < asfieldp->min_bound.xyz.y) {
-		objp->pos.xyz.y = asfieldp->max_bound.xyz.y + (objp->pos.xyz.y - asfieldp->min_bound.xyz.y);
+	if (pos->xyz.y < asfieldp->min_bound.xyz.y) {
+		pos->xyz.y = asfieldp->max_bound.xyz.y + (pos->xyz.y - asfieldp->min_bound.xyz.y);
 	}
 	
-	if (objp->pos.xyz.z < asfieldp->min_bound.xyz.z) {
-		objp->pos.xyz.z = asfieldp->max_bound.xyz.z + (objp->pos.xyz.z - asfieldp->min_bound.xyz.z);
+	if (pos->xyz.z < asfieldp->min_bound.xyz.z) {
+		pos->xyz.z = asfieldp->max_bound.xyz.z + (pos->xyz.z - asfieldp->min_bound.xyz.z);
 	}
 
-	if (objp->pos.xyz.x > asfieldp->max_bound.xyz.x) {
-		objp->pos.xyz.x = asfieldp->min_bound.xyz.x + (objp->pos.xyz.x - asfieldp->max_bound.xyz.x);
+	if (pos->xyz.x > asfieldp->max_bound.xyz.x) {
+		pos->xyz.x = asfieldp->min_bound.xyz.x + (pos->xyz.x - asfieldp->max_bound.xyz.x);
 	}
 
-	if (objp->pos.xyz.y > asfieldp->max_bound.xyz.y) {
-		objp->pos.xyz.y = asfieldp->min_bound.xyz.y + (objp->pos.xyz.y - asfieldp->max_bound.xyz.y);
+	if (pos->xyz.y > asfieldp->max_bound.xyz.y) {
+		pos->xyz.y = asfieldp->min_bound.xyz.y + (pos->xyz.y - asfieldp->max_bound.xyz.y);
 	}
 
-	if (objp->pos.xyz.z > asfieldp->max_bound.xyz.z) {
-		objp->pos.xyz.z = asfieldp->min_bound.xyz.z + (objp->pos.xyz.z - asfieldp->max_bound.xyz.z);
+	if (pos->xyz.z > asfieldp->max_bound.xyz.z) {
+		pos->xyz.z = asfieldp->min_bound.xyz.z + (pos->xyz.z - asfieldp->max_bound.xyz.z);
 	}
 
 	// wrap on inner bound, check all 3 axes as needed, use of rand ok for multiplayer with send_asteroid_throw()
-	inner_bound_pos_fixup(asfieldp, &objp->pos);
+	inner_bound_pos_fixup(asfieldp, pos);
 
 }
 
@@ -809,6 +1001,20 @@ static void maybe_throw_asteroid(int count)
 
 }
 
+/**
+ * Add a far asteroid with the position, velocity and orientation of a full asteroid
+ */
+void asteroid_far_field_add_object(const object *objp, int asteroid_type, int asteroid_subtype)
+{
+	angles orient, rotvel;
+	vm_extract_angles_matrix(&orient, &objp->orient);
+	rotvel.p = objp->phys_info.rotvel.xyz.x;
+	rotvel.h = objp->phys_info.rotvel.xyz.y;
+	rotvel.b = objp->phys_info.rotvel.xyz.z;
+
+	asteroid_far_field_add(&objp->pos, &objp->phys_info.vel, &orient, &rotvel, objp->radius, asteroid_type, asteroid_subtype);
+}
+
 /**
  * Delete asteroid from Asteroid_used_list
  */
@@ -822,6 +1028,10 @@ void asteroid_delete( object * obj )
 
 	asp = &Asteroids[num];
 
+	if (asp->flags & AF_DEMOTED) {
+		asteroid_far_field_add_object(obj, asp->asteroid_type, asp->asteroid_subtype);
+	}
+
 	if (asp->model_instance_num >= 0)
 		model_delete_instance(asp->model_instance_num);
 
@@ -843,7 +1053,7 @@ static void asteroid_maybe_reposition(object *objp, asteroid_field *asfieldp)
 		return;
 	}
 
-	if ( asteroid_should_wrap(objp, asfieldp) ) {
+	if ( asteroid_should_wrap(&objp->pos, asfieldp) ) {
 		vec3d	vec_to_asteroid, old_asteroid_pos, old_vel;
 		float		dot, dist;
 
@@ -862,7 +1072,7 @@ static void asteroid_maybe_reposition(object *objp, asteroid_field *asfieldp)
 					objp->flags.set(Object::Object_Flags::Should_be_dead);
 				} else {
 					// check to ensure player won't see asteroid appear either
-					asteroid_wrap_pos(objp, asfieldp);
+					asteroid_wrap_pos(&objp->pos, asfieldp);
 					Asteroids[objp->instance].target_objnum = -1;
 
 					dist = vm_vec_normalized_dir(&vec_to_asteroid, &objp->pos, &Eye_position);
@@ -889,6 +1099,237 @@ static void asteroid_maybe_reposition(object *objp, asteroid_field *asfieldp)
 	}
 }
 
+/**
+ * Turn a far asteroid into a full object
+ *
+ * @return @c false if there was no free asteroid slot
+ */
+static bool asteroid_far_field_promote(size_t index)
+{
+	auto& field = Asteroid_far_field;
+
+	object *objp = asteroid_create(&Asteroid_field, field.asteroid_type[index], field.asteroid_subtype[index]);
+
+	if (objp == NULL) {
+		return false;
+	}
+
+	asteroid_far_field_copy_to_object(index, objp);
+	asteroid_far_field_remove(index);
+
+	return true;
+}
+
+/**
+ * Give an object the position, velocity and orientation of a far asteroid
+ */
+void asteroid_far_field_copy_to_object(size_t index, object *objp)
+{
+	auto& field = Asteroid_far_field;
+
+	Assert(index < field.size());
+
+	objp->pos.xyz.x = field.pos_x[index];
+	objp->pos.xyz.y = field.pos_y[index];
+	objp->pos.xyz.z = field.pos_z[index];
+	vm_angles_2_matrix(&objp->orient, &field.orient[index]);
+
+	objp->phys_info.vel.xyz.x = field.vel_x[index];
+	objp->phys_info.vel.xyz.y = field.vel_y[index];
+	objp->phys_info.vel.xyz.z = field.vel_z[index];
+	objp->phys_info.desired_vel = objp->phys_info.vel;
+	objp->phys_info.max_vel.xyz.z = vm_vec_mag(&objp->phys_info.desired_vel);
+
+	objp->phys_info.rotvel.xyz.x = field.rotvel[index].p;
+	objp->phys_info.rotvel.xyz.y = field.rotvel[index].h;
+	objp->phys_info.rotvel.xyz.z = field.rotvel[index].b;
+
+	vm_vec_scale_add(&objp->last_pos, &objp->pos, &objp->phys_info.vel, -flFrametime);
+	objp->last_orient = objp->orient;
+}
+
+/**
+ * Mark a full asteroid for moving back into the far field if no ship is close to it
+ */
+static void asteroid_maybe_demote(object *objp)
+{
+	asteroid *asp = &Asteroids[objp->instance];
+
+	if (!Asteroid_tiers_active || (asp->flags & AF_DEMOTED) || objp->flags[Object::Object_Flags::Should_be_dead]) {
+		return;
+	}
+
+	// anything that is about to hit something, breaking up or has been damaged has to stay a full object
+	if ( (asp->target_objnum >= 0) || (asp->collide_objnum >= 0) || (asp->final_death_time > 0)
+		|| (objp->hull_strength < asteroid_get_initial_strength(&Asteroid_info[asp->asteroid_type])) ) {
+		return;
+	}
+
+	if (asteroid_interactor_dist(&objp->pos, objp->radius) < ASTEROID_DEMOTE_RANGE) {
+		return;
+	}
+
+	if (asteroid_is_targeted(objp)) {
+		return;
+	}
+
+	asp->flags |= AF_DEMOTED;
+	objp->flags.set(Object::Object_Flags::Should_be_dead);
+}
+
+/**
+ * Move and wrap the far asteroids
+ */
+void asteroid_far_field_move(float frametime)
+{
+	auto& field = Asteroid_far_field;
+	auto count = field.size();
+
+	for (size_t i = 0; i < count; ++i) {
+		field.pos_x[i] += field.vel_x[i] * frametime;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		field.pos_y[i] += field.vel_y[i] * frametime;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		field.pos_z[i] += field.vel_z[i] * frametime;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		auto& orient = field.orient[i];
+		auto& rotvel = field.rotvel[i];
+
+		orient.p = fmodf(orient.p + rotvel.p * frametime, PI2);
+		orient.b = fmodf(orient.b + rotvel.b * frametime, PI2);
+		orient.h = fmodf(orient.h + rotvel.h * frametime, PI2);
+	}
+
+	// passive field does not wrap
+	if (Asteroid_field.field_type == FT_PASSIVE) {
+		return;
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		vec3d pos;
+		pos.xyz.x = field.pos_x[i];
+		pos.xyz.y = field.pos_y[i];
+		pos.xyz.z = field.pos_z[i];
+
+		if ( !asteroid_should_wrap(&pos, &Asteroid_field) ) {
+			continue;
+		}
+
+		// same as asteroid_maybe_reposition(), only wrap if player won't see asteroid disappear or appear
+		vec3d vec_to_asteroid;
+		float dist = vm_vec_normalized_dir(&vec_to_asteroid, &pos, &Eye_position);
+		float dot = vm_vec_dot(&Eye_matrix.vec.fvec, &vec_to_asteroid);
+
+		if ( (dot >= 0.7f) && (dist <= Asteroid_field.bound_rad) ) {
+			continue;
+		}
+
+		asteroid_wrap_pos(&pos, &Asteroid_field);
+
+		dist = vm_vec_normalized_dir(&vec_to_asteroid, &pos, &Eye_position);
+		dot = vm_vec_dot(&Eye_matrix.vec.fvec, &vec_to_asteroid);
+
+		if ( (dot > 0.7f) && (dist < (Asteroid_field.bound_rad * 1.3f)) ) {
+			// player would see asteroid pop out other side, so reverse velocity instead of wrapping
+			field.vel_x[i] = -field.vel_x[i];
+			field.vel_y[i] = -field.vel_y[i];
+			field.vel_z[i] = -field.vel_z[i];
+		} else {
+			field.pos_x[i] = pos.xyz.x;
+			field.pos_y[i] = pos.xyz.y;
+			field.pos_z[i] = pos.xyz.z;
+		}
+	}
+}
+
+/**
+ * Turn far asteroids that a ship came close to into full objects
+ *
+ * The asteroids are checked round robin so that each one is checked once every ::ASTEROID_FAR_CHECK_TIME. The
+ * interaction range is large enough that nothing can get close to an asteroid between two checks.
+ */
+static void asteroid_far_field_check_promotion(float frametime)
+{
+	auto& field = Asteroid_far_field;
+
+	if (field.size() == 0 || Asteroid_interactors.empty()) {
+		return;
+	}
+
+	size_t num_checks;
+	if (Asteroid_far_check_all) {
+		num_checks = field.size();
+		Asteroid_far_check_all = false;
+	} else {
+		num_checks = std::min(field.size(), (size_t)(field.size() * frametime / ASTEROID_FAR_CHECK_TIME) + 1);
+	}
+
+	for (size_t k = 0; k < num_checks && field.size() > 0; ++k) {
+		if (Asteroid_far_check_index >= field.size()) {
+			Asteroid_far_check_index = 0;
+		}
+
+		auto index = Asteroid_far_check_index;
+
+		vec3d pos;
+		pos.xyz.x = field.pos_x[index];
+		pos.xyz.y = field.pos_y[index];
+		pos.xyz.z = field.pos_z[index];
+
+		if ( (asteroid_interactor_dist(&pos, field.radius[index]) < ASTEROID_INTERACTION_RANGE)
+			&& (Num_asteroids < MAX_ASTEROIDS - ASTEROID_RESERVED_SLOTS) && asteroid_far_field_promote(index) ) {
+			// the last asteroid has been moved into this slot so check the same index again
+			continue;
+		}
+
+		++Asteroid_far_check_index;
+	}
+}
+
+/**
+ * Gather the ships that asteroids can interact with
+ */
+static void asteroid_update_interactors()
+{
+	Asteroid_interactors.clear();
+
+	for ( ship_obj *so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so) ) {
+		object *ship_objp = &Objects[so->objnum];
+
+		if (ship_objp->flags[Object::Object_Flags::Should_be_dead]) {
+			continue;
+		}
+
+		asteroid_interactor interactor;
+		interactor.pos = ship_objp->pos;
+		interactor.radius = ship_objp->radius;
+
+		Asteroid_interactors.push_back(interactor);
+	}
+}
+
+static void asteroid_far_field_frame()
+{
+	if (!Asteroid_tiers_active) {
+		return;
+	}
+
+	TRACE_SCOPE(tracing::AsteroidFarField);
+
+	asteroid_update_interactors();
+
+	if (Asteroid_far_field.size() == 0) {
+		return;
+	}
+
+	asteroid_far_field_move(flFrametime);
+	asteroid_far_field_check_promotion(flFrametime);
+}
+
 static void lerp(float *goal, float f1, float f2, float scale)
 {
 	*goal = (f2 - f1) * scale + f1;
@@ -1188,6 +1629,65 @@ void asteroid_render(object * obj, model_draw_list *scene)
 	}
 }
 
+/**
+ * Queue the far asteroids that are in view
+ *
+ * All far asteroids are queued with the same render settings so the sorted draw list submits the asteroids sharing a
+ * model back to back without any state changes in between.
+ */
+void asteroid_render_far_field(model_draw_list *scene)
+{
+	auto& field = Asteroid_far_field;
+
+	if (!Asteroids_enabled || field.size() == 0) {
+		return;
+	}
+
+	TRACE_SCOPE(tracing::QueueAsteroidFarField);
+
+	model_render_params render_info;
+	render_info.set_flags(MR_IS_ASTEROID);
+
+	// model_render_queue() skips asteroids this far away since they would be too dark to see
+	float max_dist = render_info.get_depth_scale() * 32.0f;
+
+	// The view space is scaled so the view frustum planes are x = +-z and y = +-z. These are the lengths of the
+	// plane normals which turn the distance of a sphere to a plane into view space units.
+	float side_scale = sqrtf(Matrix_scale.xyz.x * Matrix_scale.xyz.x + Matrix_scale.xyz.z * Matrix_scale.xyz.z);
+	float top_scale = sqrtf(Matrix_scale.xyz.y * Matrix_scale.xyz.y + Matrix_scale.xyz.z * Matrix_scale.xyz.z);
+
+	for (size_t i = 0; i < field.size(); ++i) {
+		vec3d pos, tmp, view_pos;
+		pos.xyz.x = field.pos_x[i];
+		pos.xyz.y = field.pos_y[i];
+		pos.xyz.z = field.pos_z[i];
+
+		float radius = field.radius[i];
+
+		vm_vec_sub(&tmp, &pos, &View_position);
+
+		if (vm_vec_mag_squared(&tmp) > max_dist * max_dist) {
+			continue;
+		}
+
+		vm_vec_rotate(&view_pos, &tmp, &View_matrix);
+
+		if ( (view_pos.xyz.z < -radius * Matrix_scale.xyz.z)
+			|| (view_pos.xyz.x - view_pos.xyz.z > radius * side_scale) || (-view_pos.xyz.x - view_pos.xyz.z > radius * side_scale)
+			|| (view_pos.xyz.y - view_pos.xyz.z > radius * top_scale) || (-view_pos.xyz.y - view_pos.xyz.z > radius * top_scale) ) {
+			continue;
+		}
+
+		matrix orient;
+		vm_angles_2_matrix(&orient, &field.orient[i]);
+
+		int model_num = Asteroid_info[field.asteroid_type[i]].model_num[field.asteroid_subtype[i]];
+
+		model_clear_instance(model_num);
+		model_render_queue(&render_info, scene, model_num, &orient, &pos);
+	}
+}
+
 /**
  * Create a normalized vector generally in the direction from *hitpos to other_obj->pos
  */
@@ -1410,10 +1910,13 @@ void asteroid_level_close()
 		}
 	}
 
+	asteroid_far_field_clear();
+
 	Asteroid_field.num_initial_asteroids=0;
 }
 
 DCF_BOOL2(asteroids, Asteroids_enabled, "enables or disables asteroids", "Usage: asteroids [bool]\nTurns asteroid system on/off.  If nothing passed, then toggles it.\n");
+DCF_BOOL2(asteroid_tiers, Asteroid_tiers_enabled, "enables or disables the far asteroid field", "Usage: asteroid_tiers [bool]\nKeeps asteroids far away from all ships out of the object system, takes effect with the next mission.  If nothing passed, then toggles it.\n");
 
 
 /**
@@ -1424,6 +1927,14 @@ int asteroid_count()
 	return Num_asteroids;
 }
 
+/**
+ * Return the number of asteroids that are too far away from all ships to be objects
+ */
+int asteroid_far_field_count()
+{
+	return (int)Asteroid_far_field.size();
+}
+
 /**
  * See if asteroid should split up.  
  * We delay splitting up to allow the explosion animation to play for a bit.
@@ -1701,6 +2212,7 @@ void asteroid_process_post(object * obj)
 
 		if ( timestamp_elapsed(asp->check_for_collide) ) {
 			asteroid_update_collide_flag(obj);
+			asteroid_maybe_demote(obj);
 			asp->check_for_collide = timestamp(ASTEROID_UPDATE_COLLIDE_TIMESTAMP);
 		}
 
@@ -2055,6 +2567,8 @@ static int set_asteroid_throw_objnum()
 
 void asteroid_frame()
 {
+	asteroid_far_field_frame();
+
 	if (Num_asteroids < 1)
 		return;
 
@@ -23,6 +23,10 @@ class model_draw_list;
 
 #define	MAX_ASTEROIDS			512
 
+// Asteroids that are far away from all ships are not objects, so a field can have many more asteroids than there are
+// asteroid slots. Only MAX_ASTEROIDS of them can be full objects at the same time.
+#define	MAX_FIELD_ASTEROIDS		16384
+
 #define NUM_DEBRIS_SIZES		3
 #define	NUM_DEBRIS_POFS			3				// Number of POFs per debris size
 
@@ -94,6 +98,7 @@ public:
 
 
 #define	AF_USED					(1<<0)			// Set means used.
+#define	AF_DEMOTED				(1<<1)			// Asteroid is moved back to the far field when its object is deleted
 
 typedef	struct asteroid {
 	int		flags;
@@ -144,6 +149,7 @@ extern asteroid_field	Asteroid_field;
 
 extern int	Num_asteroids;
 extern int	Asteroids_enabled;
+extern int	Asteroid_tiers_enabled;
 extern char		Asteroid_icon_closeup_model[NAME_LENGTH];	// model for asteroid field briefing icon rendering
 extern vec3d	Asteroid_icon_closeup_position;  // closeup position for asteroid field briefing icon rendering
 extern float	Asteroid_icon_closeup_zoom;		 // zoom position for asteroid field briefing icon rendering
@@ -153,12 +159,18 @@ void	asteroid_level_init();
 void	asteroid_level_close();
 void	asteroid_create_all();
 void	asteroid_render(object * obj, model_draw_list *scene);
+void	asteroid_render_far_field(model_draw_list *scene);
 void	asteroid_delete( object *asteroid_objp );
 void	asteroid_process_pre( object *asteroid_objp );
 void	asteroid_process_post( object *asteroid_objp);
 int	asteroid_check_collision( object *asteroid_objp, object * other_obj, vec3d * hitpos, collision_info_struct *asteroid_hit_info=NULL, vec3d* hitnormal=NULL );
 void	asteroid_hit( object *pasteroid_objp, object *other_objp, vec3d *hitpos, float damage );
 int	asteroid_count();
+int	asteroid_far_field_count();
+void	asteroid_far_field_clear();
+void	asteroid_far_field_add_object(const object *objp, int asteroid_type, int asteroid_subtype);
+void	asteroid_far_field_copy_to_object(size_t index, object *objp);
+void	asteroid_far_field_move(float frametime);
 int	asteroid_collide_objnum(object *asteroid_objp);
 float asteroid_time_to_impact(object *asteroid_objp);
 void	asteroid_show_brackets();
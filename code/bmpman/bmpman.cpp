@@ -1815,7 +1815,7 @@ int bm_load_sub_slow(const char *real_filename, const int num_ext, const char **
 	if (!res.found)
 		return -1;
 
-	CFILE *test = cfopen_special(res.full_name.c_str(), "rb", res.size, res.offset, res.data_ptr, dir_type);
+	CFILE *test = cfopen_special(res, "rb", dir_type);
 
 	if (test != NULL) {
 		if (img_cfp != NULL)
@@ -112,6 +112,7 @@ static int cfget_cfile_block();
 static CFILE *cf_open_fill_cfblock(const char* source, int line, FILE * fp, int type);
 static CFILE *cf_open_packed_cfblock(const char* source, int line, FILE *fp, int type, size_t offset, size_t size);
 static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const void* data, size_t size, int dir_type);
+static CFILE *cf_open_compressed_cfblock(const char* source, int line, FILE *fp, int type, size_t offset, size_t size, size_t stored_size, bool whole_file);
 
 #if defined _WIN32
 static CFILE *cf_open_mapped_fill_cfblock(const char* source, int line, HANDLE hFile, int type);
@@ -751,9 +752,24 @@ CFILE* _cfopen(const char* source, int line, const char* file_path, const char*
 		nprintf(("CFileDebug", "Requested file %s found at: %s\n", file_path, find_res.full_name.c_str()));
 
 		if ( type & CFILE_MEMORY_MAPPED ) {
-		
-			// Can't open memory mapped files out of pack or memory files
-			if ( find_res.offset == 0 && find_res.data_ptr != nullptr )	{
+
+			if ( find_res.data_ptr != nullptr ) {
+				// In-memory files and files in mapped packs can be used directly
+				return cf_open_memory_fill_cfblock(source, line, find_res.data_ptr, find_res.size, dir_type);
+			}
+
+			if ( find_res.stored_size != 0 ) {
+				// Compressed files are decompressed into memory completely so their data can be accessed directly
+				FILE* fp = fopen(find_res.full_name.c_str(), "rb");
+				if (fp) {
+					return cf_open_compressed_cfblock(source, line, fp, dir_type, find_res.offset, find_res.size,
+						find_res.stored_size, true);
+				}
+				return NULL;
+			}
+
+			// Can't open memory mapped files out of packs that are not mapped
+			if ( find_res.offset == 0 )	{
 #if defined _WIN32
 				HANDLE hFile;
 
@@ -772,8 +788,7 @@ CFILE* _cfopen(const char* source, int line, const char* file_path, const char*
 
 		} else {
 			// since cfopen_special already has all the code to handle the opening we can just use that here
-			return _cfopen_special(source, line, find_res.full_name.c_str(), mode, find_res.size, find_res.offset,
-			                       find_res.data_ptr, dir_type);
+			return _cfopen_special(source, line, find_res, mode, dir_type);
 		}
 
 	}
@@ -831,6 +846,59 @@ CFILE *_cfopen_special(const char* source, int line, const char *file_path, cons
 	return NULL;
 }
 
+CFILE *_cfopen_special(const char* source, int line, const CFileLocation& location, const char *mode, int dir_type)
+{
+	if ( location.stored_size == 0 ) {
+		return _cfopen_special(source, line, location.full_name.c_str(), mode, location.size, location.offset,
+		                       location.data_ptr, dir_type);
+	}
+
+	if ( !cfile_inited) {
+		Int3();
+		return NULL;
+	}
+
+	Assert( mode != NULL );
+
+	// Compressed files can only be read
+	if ( strchr(mode, 'w') ) {
+		Int3();
+		return NULL;
+	}
+
+	FILE *fp = fopen(location.full_name.c_str(), "rb");
+	if (!fp) {
+		return NULL;
+	}
+
+	return cf_open_compressed_cfblock(source, line, fp, dir_type, location.offset, location.size, location.stored_size,
+		false);
+}
+
+bool cf_read_location(const CFileLocation& location, void* buffer)
+{
+	if (location.data_ptr != nullptr) {
+		memcpy(static_cast<ubyte*>(buffer), location.data_ptr, location.size);
+		return true;
+	}
+
+	FILE* fp = fopen(location.full_name.c_str(), "rb");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	bool success;
+	if (location.stored_size != 0) {
+		success = cf_inflate_file(fp, location.offset, location.stored_size, buffer, location.size);
+	} else {
+		success = fseek(fp, (long)location.offset, SEEK_SET) == 0 && fread(buffer, 1, location.size, fp) == location.size;
+	}
+
+	fclose(fp);
+
+	return success;
+}
+
 
 // ------------------------------------------------------------------------
 // ctmpfile() 
@@ -869,6 +937,8 @@ static int cfget_cfile_block()
 		if (cfile->type == CFILE_BLOCK_UNUSED) {
 			cfile->data = nullptr;
 			cfile->fp = nullptr;
+			cfile->owns_data = false;
+			cfile->inflate = nullptr;
 			cfile->type = CFILE_BLOCK_USED;
 			return i;
 		}
@@ -899,7 +969,13 @@ int cfclose( CFILE * cfile )
 	Assert(cfile != NULL);
 
 	result = 0;
-	if ( cfile->data && cfile->mem_mapped ) {
+	if ( cfile->inflate != nullptr ) {
+		cf_inflate_close(cfile);
+	} else if ( cfile->owns_data ) {
+		vm_free(const_cast<void*>(cfile->data));
+		cfile->data = nullptr;
+		cfile->owns_data = false;
+	} else if ( cfile->data && cfile->mem_mapped ) {
 		// close memory mapped file
 #if defined _WIN32
 		result = UnmapViewOfFile((void*)cfile->data);
@@ -1104,6 +1180,58 @@ static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const vo
 	}
 }
 
+// Compressed files up to this size are decompressed completely when they are opened, larger ones while they are read
+#define CF_MAX_INFLATE_ON_OPEN		(4 * 1024 * 1024)
+
+// cf_open_compressed_cfblock() will fill up a Cfile_block element in the Cfile_block_list[] array
+// for the case of a compressed file in a pack file being opened by cf_open();
+//
+// returns:   success ==> ptr to CFILE structure.  
+//            error   ==> NULL
+//
+static CFILE *cf_open_compressed_cfblock(const char* source, int line, FILE *fp, int type, size_t offset, size_t size, size_t stored_size, bool whole_file)
+{
+	int cfile_block_index;
+
+	cfile_block_index = cfget_cfile_block();
+	if ( cfile_block_index == -1 ) {
+		fclose(fp);
+		return NULL;
+	}
+
+	CFILE *cfp = &Cfile_block_list[cfile_block_index];
+
+	cfp->max_read_len = 0;
+	cfp->mem_mapped = false;
+	cfp->dir_type = type;
+
+	cfp->source_file = source;
+	cfp->line_num = line;
+
+	if ( whole_file || size <= CF_MAX_INFLATE_ON_OPEN ) {
+		auto buffer = vm_malloc(size);
+		bool success = cf_inflate_file(fp, offset, stored_size, buffer, size);
+		fclose(fp);
+
+		if ( !success ) {
+			mprintf(("CFILE: Could not decompress a file at offset " SIZE_T_ARG " of a pack file!\n", offset));
+			vm_free(buffer);
+			cfp->type = CFILE_BLOCK_UNUSED;
+			return NULL;
+		}
+
+		cfp->data = buffer;
+		cfp->owns_data = true;
+	} else if ( !cf_inflate_open(cfp, fp, offset, stored_size) ) {
+		cfp->type = CFILE_BLOCK_UNUSED;
+		return NULL;
+	}
+
+	cf_init_lowlevel_read_code(cfp, 0, size, 0);
+
+	return cfp;
+}
+
 int cf_get_dir_type(CFILE *cfile)
 {
 	return cfile->dir_type;
@@ -190,6 +190,12 @@ CFILE *_cfopen_special(const char* source_file, int line, const char *file_path,
 	const size_t size, const size_t offset, const void* data, int dir_type = CF_TYPE_ANY);
 #define cfopen_special(...) _cfopen_special(LOCATION, __VA_ARGS__) // Pass source location to the function
 
+struct CFileLocation;
+// like cfopen_special(), but takes the location returned by cf_find_file_location() which is needed to open compressed
+// files in packs
+CFILE *_cfopen_special(const char* source_file, int line, const CFileLocation& location, const char *mode,
+	int dir_type = CF_TYPE_ANY);
+
 // Flush the open file buffer
 int cflush(CFILE *cfile);
 
@@ -372,10 +378,15 @@ struct CFileLocation {
 	size_t size          = 0;
 	size_t offset        = 0;
 	const void* data_ptr = nullptr;
+	size_t stored_size   = 0; // For compressed files in packs, the size of the compressed data. 0 if not compressed.
 
 	explicit CFileLocation(bool found_in = false) : found(found_in) {}
 };
 
+// Reads the complete contents of a file found by cf_find_file_location() into buffer which must have room for
+// location.size bytes. This does not touch any cfile state so it may be called from other threads.
+bool cf_read_location(const CFileLocation& location, void* buffer);
+
 // Searches for a file.   Follows all rules and precedence and searches
 // CD's and pack files.
 // Input:  filespace   - Filename & extension
@@ -26,12 +26,147 @@
 #include "cfile/cfilearchive.h"
 #include "luaconf.h"
 
+#include <zlib.h>
+
 #include <sstream>
+#include <memory>
 #include <limits>
+#include <algorithm>
 
 
 #define CHECK_POSITION
 
+#define CF_INFLATE_INPUT_SIZE	(64 * 1024)
+
+struct cf_inflate_stream {
+	FILE* fp = nullptr;
+	size_t stored_offset = 0;	// Where the compressed data starts in fp
+	size_t stored_size = 0;
+	size_t stored_read = 0;		// How much of the compressed data has been passed to zlib
+	size_t position = 0;		// The position in the decompressed data the stream is at
+
+	z_stream stream;
+	ubyte input[CF_INFLATE_INPUT_SIZE];
+};
+
+static bool cf_inflate_init(cf_inflate_stream* s, FILE* fp, size_t offset, size_t stored_size)
+{
+	s->fp = fp;
+	s->stored_offset = offset;
+	s->stored_size = stored_size;
+
+	memset(&s->stream, 0, sizeof(s->stream));
+	if (inflateInit(&s->stream) != Z_OK) {
+		return false;
+	}
+
+	return fseek(fp, (long)offset, SEEK_SET) == 0;
+}
+
+// Goes back to the start of the decompressed data
+static bool cf_inflate_rewind(cf_inflate_stream* s)
+{
+	s->stored_read = 0;
+	s->position = 0;
+	s->stream.avail_in = 0;
+
+	return inflateReset(&s->stream) == Z_OK && fseek(s->fp, (long)s->stored_offset, SEEK_SET) == 0;
+}
+
+// Decompresses the next bytes of the stream, returns how many bytes were written to buf
+static size_t cf_inflate_next(cf_inflate_stream* s, void* buf, size_t size)
+{
+	s->stream.next_out = reinterpret_cast<Bytef*>(buf);
+	s->stream.avail_out = (uInt)size;
+
+	while (s->stream.avail_out > 0) {
+		if (s->stream.avail_in == 0) {
+			auto to_read = std::min(sizeof(s->input), s->stored_size - s->stored_read);
+			auto bytes_read = to_read > 0 ? fread(s->input, 1, to_read, s->fp) : 0;
+
+			if (bytes_read == 0) {
+				break;
+			}
+
+			s->stored_read += bytes_read;
+			s->stream.next_in = s->input;
+			s->stream.avail_in = (uInt)bytes_read;
+		}
+
+		auto ret = inflate(&s->stream, Z_NO_FLUSH);
+		if (ret == Z_STREAM_END) {
+			break;
+		}
+		if (ret != Z_OK) {
+			mprintf(("CFILE: Decompressing packed file failed with zlib error %d!\n", ret));
+			break;
+		}
+	}
+
+	auto produced = size - s->stream.avail_out;
+	s->position += produced;
+
+	return produced;
+}
+
+// Reads from a compressed file at its current position
+static size_t cf_inflate_read(CFILE* cfile, void* buf, size_t size)
+{
+	auto s = cfile->inflate;
+
+	// Seeking only changes raw_position so the stream may have to catch up first. Going backwards means starting over.
+	if (cfile->raw_position < s->position && !cf_inflate_rewind(s)) {
+		return 0;
+	}
+
+	ubyte skip_buffer[4096];
+	while (s->position < cfile->raw_position) {
+		if (cf_inflate_next(s, skip_buffer, std::min(sizeof(skip_buffer), cfile->raw_position - s->position)) == 0) {
+			return 0;
+		}
+	}
+
+	return cf_inflate_next(s, buf, size);
+}
+
+bool cf_inflate_open(CFILE* cfile, FILE* fp, size_t offset, size_t stored_size)
+{
+	std::unique_ptr<cf_inflate_stream> s(new cf_inflate_stream());
+
+	if (!cf_inflate_init(s.get(), fp, offset, stored_size)) {
+		inflateEnd(&s->stream);
+		fclose(fp);
+		return false;
+	}
+
+	cfile->inflate = s.release();
+	return true;
+}
+
+void cf_inflate_close(CFILE* cfile)
+{
+	if (cfile->inflate == nullptr) {
+		return;
+	}
+
+	inflateEnd(&cfile->inflate->stream);
+	fclose(cfile->inflate->fp);
+
+	delete cfile->inflate;
+	cfile->inflate = nullptr;
+}
+
+bool cf_inflate_file(FILE* fp, size_t offset, size_t stored_size, void* buffer, size_t size)
+{
+	std::unique_ptr<cf_inflate_stream> s(new cf_inflate_stream());
+
+	bool success = cf_inflate_init(s.get(), fp, offset, stored_size) && cf_inflate_next(s.get(), buffer, size) == size;
+
+	inflateEnd(&s->stream);
+
+	return success;
+}
+
 // Called once to setup the low-level reading code.
 
 void cf_init_lowlevel_read_code( CFILE * cfile, size_t lib_offset, size_t size, size_t pos )
@@ -198,7 +333,10 @@ int cfread(void *buf, int elsize, int nelem, CFILE *cfile)
 	}
 
 	size_t bytes_read;
-	if (cfile->data != nullptr) {
+	if (cfile->inflate != nullptr) {
+		// This is a compressed file that gets decompressed while it is read
+		bytes_read = cf_inflate_read(cfile, buf, size);
+	} else if (cfile->data != nullptr) {
 		// This is a file from memory
 		bytes_read = size;
 		memcpy(buf, reinterpret_cast<const char*>(cfile->data) + cfile->raw_position, size);
@@ -229,13 +367,6 @@ int cfread_lua_number(double *buf, CFILE *cfile)
 	if(buf == NULL)
 		return 0;
 
-	// cfread() not supported for memory-mapped files
-	if(cfile->data != nullptr)
-	{
-		Warning(LOCATION, "Writing is not supported for mem-mapped files");
-		return 0;
-	}
-
 	size_t advance = 0;
 	int items_read;
 	if (cfile->fp) {
@@ -243,10 +374,17 @@ int cfread_lua_number(double *buf, CFILE *cfile)
 		items_read = fscanf(cfile->fp, LUA_NUMBER_SCAN, buf);
 		advance = (size_t) (ftell(cfile->fp)-orig_pos);
 	} else {
-		int read;
+		// The data is not null terminated so the number is scanned from a terminated copy of the next few bytes
+		char number_buf[128];
+		auto start = cfile->raw_position;
+		auto len = cfread(number_buf, 1, sizeof(number_buf) - 1, cfile);
+		number_buf[len] = '\0';
+		cfile->raw_position = start;
+
+		int read = 0;
 		// %n returns the number of bytes currently read so we append that to the scan format at the end so it will return
 		// how many bytes we have consumed
-		items_read = sscanf(reinterpret_cast<const char*>(cfile->data), LUA_NUMBER_SCAN "%n", buf, &read);
+		items_read = sscanf(number_buf, LUA_NUMBER_SCAN "%n", buf, &read);
 		if (items_read == 2) {
 			// We need to correct the items read counter since we read one additional item
 			items_read = 1;
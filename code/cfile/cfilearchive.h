@@ -22,12 +22,16 @@
 #define CFILE_BLOCK_UNUSED		0
 #define CFILE_BLOCK_USED		1
 
+struct cf_inflate_stream;
+
 struct CFILE {
 	int type = CFILE_BLOCK_UNUSED;                // CFILE_BLOCK_UNUSED, CFILE_BLOCK_USED
 	int dir_type;        // directory location
 	FILE* fp;                // File pointer if opening an individual file
 	const void* data;            // Pointer for memory-mapped file access.  NULL if not mem-mapped.
 	bool mem_mapped; // Flag for memory mapped files (if data is not null and this is false it means that it's an embedded file)
+	bool owns_data = false;	// data holds the decompressed contents of a compressed file and is freed on close
+	cf_inflate_stream* inflate = nullptr;	// Decompression state of a large compressed file that is decompressed while reading
 #ifdef _WIN32
 	HANDLE	hInFile;			// Handle from CreateFile()
 	HANDLE	hMapFile;		// Handle from CreateFileMapping()
@@ -50,4 +54,11 @@ extern std::array<CFILE, MAX_CFILE_BLOCKS> Cfile_block_list;
 // Called once to setup the low-level reading code.
 void cf_init_lowlevel_read_code( CFILE * cfile, size_t lib_offset, size_t size, size_t pos );
 
+// Starts decompressing the compressed file at offset in fp while it is read. The CFILE takes ownership of fp.
+bool cf_inflate_open( CFILE * cfile, FILE *fp, size_t offset, size_t stored_size );
+void cf_inflate_close( CFILE * cfile );
+
+// Decompresses a complete compressed file at offset in fp into buffer which must have room for size bytes
+bool cf_inflate_file( FILE *fp, size_t offset, size_t stored_size, void *buffer, size_t size );
+
 #endif
@@ -31,10 +31,13 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <libgen.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #endif
 
 #include "cfile/cfile.h"
 #include "cfile/cfilesystem.h"
+#include "cfile/vpformat.h"
 #include "cmdline/cmdline.h"
 #include "globalincs/pstypes.h"
 #include "def_files/def_files.h"
@@ -57,6 +60,14 @@ typedef struct cf_root {
 	char	path[CF_MAX_PATHNAME_LENGTH];	// Contains something like c:\projects\freespace or c:\projects\freespace\freespace.vp
 	int		roottype;						// CF_ROOTTYPE_PATH  = Path, CF_ROOTTYPE_PACK =Pack file, CF_ROOTTYPE_MEMORY=In memory
 	uint32_t location_flags;
+
+	bool		cached;					// The files of this root were taken from the file list cache
+
+	const void*	map_data;				// For pack files, the whole pack mapped into memory. nullptr if it is read through stdio
+	size_t		map_size;
+#ifdef _WIN32
+	HANDLE		map_handle;
+#endif
 } cf_root;
 
 // convenient type for sorting (see cf_build_pack_list())
@@ -89,6 +100,7 @@ typedef struct cf_file {
 	int			pack_offset;						// For pack files, where it is at.   0 if not in a pack file.  This can be used to tell if in a pack file.
 	char*		real_name;							// For real files, the full path
 	const void*	data;								// For in-memory files, the data pointer
+	int			stored_size;						// For compressed files in pack files, the size of the compressed data. 0 if the file is not compressed.
 } cf_file;
 
 #define CF_NUM_FILES_PER_BLOCK   512
@@ -157,7 +169,110 @@ cf_root *cf_create_root()
 
 	Num_roots++;
 
-	return &Root_blocks[block]->roots[offset];
+	auto root = &Root_blocks[block]->roots[offset];
+	root->cached = false;
+	root->map_data = nullptr;
+	root->map_size = 0;
+#ifdef _WIN32
+	root->map_handle = NULL;
+#endif
+
+	return root;
+}
+
+// Maps a whole pack file into memory so the files in it can be opened as views of the mapping instead of being read
+// through stdio
+static void cf_map_pack(cf_root *root)
+{
+	// A 32-bit process does not have the address space for the packs of a large mod
+	if (Cmdline_no_vp_mmap || sizeof(void*) < 8) {
+		return;
+	}
+
+#ifdef _WIN32
+	HANDLE hFile = CreateFile(root->path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || size.QuadPart <= 0) {
+		CloseHandle(hFile);
+		return;
+	}
+
+	// The mapping keeps the file open by itself
+	HANDLE hMapFile = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(hFile);
+
+	if (hMapFile == NULL) {
+		mprintf(("Could not map pack file '%s', reading it through stdio\n", root->path));
+		return;
+	}
+
+	void* data = MapViewOfFile(hMapFile, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		mprintf(("Could not map pack file '%s', reading it through stdio\n", root->path));
+		CloseHandle(hMapFile);
+		return;
+	}
+
+	root->map_handle = hMapFile;
+	root->map_data = data;
+	root->map_size = (size_t)size.QuadPart;
+#else
+	int fd = open(root->path, O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+		close(fd);
+		return;
+	}
+
+	// The mapping stays valid after the descriptor is closed
+	void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (data == MAP_FAILED) {
+		mprintf(("Could not map pack file '%s', reading it through stdio\n", root->path));
+		return;
+	}
+
+	root->map_data = data;
+	root->map_size = (size_t)st.st_size;
+#endif
+}
+
+static void cf_unmap_pack(cf_root *root)
+{
+	if (root->map_data == nullptr) {
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(root->map_data);
+	CloseHandle(root->map_handle);
+	root->map_handle = NULL;
+#else
+	munmap(const_cast<void*>(root->map_data), root->map_size);
+#endif
+
+	root->map_data = nullptr;
+	root->map_size = 0;
+}
+
+// Returns the bytes of a file in a pack if that pack is mapped into memory
+static const void* cf_get_pack_view(const cf_root *root, const cf_file *f)
+{
+	// Compressed files have to be decompressed before they can be used
+	if (root->map_data == nullptr || f->stored_size != 0 || (size_t)f->pack_offset + (size_t)f->size > root->map_size) {
+		return nullptr;
+	}
+
+	return static_cast<const ubyte*>(root->map_data) + f->pack_offset;
 }
 
 // return the # of packfiles which exist
@@ -360,6 +475,8 @@ void cf_build_pack_list( cf_root *root )
 		// to find the files.
 		strcpy_s(new_root->path, temp_roots_sort[i].path);		
 		new_root->roottype = CF_ROOTTYPE_PACK;		
+
+		cf_map_pack(new_root);
 	}
 
 	// free up the temp list
@@ -551,7 +668,10 @@ int is_ext_in_list( const char *ext_list, const char *ext )
 	return 0;
 }
 
-void cf_search_root_path(int root_index)
+// Adds all files of a root directory. The directories that were searched are added to searched_dirs if it is not null.
+// The cache directory is left out of those since the file list cache is written to it and files in it are always
+// looked up on disk.
+void cf_search_root_path(int root_index, SCP_vector<SCP_string>* searched_dirs = nullptr)
 {
 	int i;
 	int num_files = 0;
@@ -615,6 +735,10 @@ void cf_search_root_path(int root_index)
 		find_handle = _findfirst( search_path, &find );
 
  		if (find_handle != -1) {
+			if (searched_dirs != nullptr && i != CF_TYPE_CACHE) {
+				searched_dirs->push_back(search_directory);
+			}
+
 			do {
 				if (!(find.attrib & _A_SUBDIR)) {
 
@@ -712,6 +836,10 @@ void cf_search_root_path(int root_index)
 		}
 
 		if ( dirp ) {
+			if (searched_dirs != nullptr && i != CF_TYPE_CACHE) {
+				searched_dirs->push_back(search_dir);
+			}
+
 			struct dirent *dir = nullptr;
 			while ((dir = readdir (dirp)) != NULL)
 			{
@@ -809,6 +937,9 @@ void cf_search_root_pack(int root_index)
 	VP_header.index_offset = INTEL_INT( VP_header.index_offset ); //-V570
 	VP_header.num_files = INTEL_INT( VP_header.num_files ); //-V570
 
+	// Compressed packs have a few more fields in every index entry
+	bool compressed = VP_header.version == VP_VERSION_COMPRESSED;
+
 	mprintf(( "Searching root pack '%s' ... ", root->path ));
 
 	// Read index info
@@ -833,6 +964,21 @@ void cf_search_root_pack(int root_index)
 		find.write_time = INTEL_INT( find.write_time ); //-V570
 		find.filename[sizeof(find.filename)-1] = '\0';
 
+		int stored_size = 0;
+		if ( compressed ) {
+			int compression[2];
+
+			if (fread( compression, sizeof(compression), 1, fp ) != 1) {
+				mprintf(("Failed to read file entry (currently in directory %s)!\n", search_path));
+				break;
+			}
+
+			// Only compressed files need to know how much data they take up in the pack
+			if ( INTEL_INT(compression[1]) & VP_FILE_FLAG_DEFLATE ) {
+				stored_size = INTEL_INT(compression[0]);
+			}
+		}
+
 		if ( find.size == 0 )	{
 			size_t search_path_len = strlen(search_path);
 			if ( !stricmp( find.filename, ".." ))	{
@@ -867,6 +1013,7 @@ void cf_search_root_pack(int root_index)
 							file->write_time = (time_t)find.write_time;
 							file->size = find.size;
 							file->pack_offset = find.offset;			// Mark as a packed file
+							file->stored_size = stored_size;
 
 							num_files++;
 							//mprintf(( "Found pack file '%s'\n", file->name_ext ));
@@ -925,27 +1072,408 @@ void cf_search_memory_root(int root_index) {
 	mprintf(( "%i files\n", num_files ));
 }
 
+// Increase this whenever the layout of the file list cache or the meaning of its contents changes
+#define CF_FILE_LIST_CACHE_VERSION	1
+
+#define CF_FILE_LIST_CACHE_NAME		"filelist.cache"
+
+// Stored instead of a modification time that is too close to the time of the scan, never matches a real time
+#define CF_CACHE_TIME_RECENT		((int64_t)-2)
+
+typedef struct cf_cached_file {
+	SCP_string	name_ext;
+	int			pathtype_index;
+	int64_t		write_time;
+	int			size;
+	int			pack_offset;
+	int			stored_size;
+	SCP_string	real_name;
+} cf_cached_file;
+
+// Everything needed to tell if the files of a root have changed since they were cached, and the files themselves
+typedef struct cf_cached_root {
+	int			roottype = -1;
+
+	// Path roots: the searched directories and their modification times, -1 if a directory did not exist
+	SCP_vector<std::pair<SCP_string, int64_t>> dirs;
+
+	// Pack roots: size and modification time of the pack and its header which contains the location of the index
+	int64_t		pack_size = -1;
+	int64_t		pack_time = -1;
+	ubyte		pack_header[sizeof(VP_FILE_HEADER)] = {};
+
+	SCP_vector<cf_cached_file> files;
+} cf_cached_root;
+
+static int64_t cf_get_modification_time(const char *path)
+{
+	struct stat buf;
+	if (stat(path, &buf) != 0) {
+		return -1;
+	}
+
+	return (int64_t)buf.st_mtime;
+}
+
+static bool cf_get_pack_signature(const cf_root *root, cf_cached_root *entry)
+{
+	struct stat buf;
+	if (stat(root->path, &buf) != 0) {
+		return false;
+	}
+
+	entry->pack_size = (int64_t)buf.st_size;
+	entry->pack_time = (int64_t)buf.st_mtime;
+
+	if (root->map_data != nullptr) {
+		if (root->map_size < sizeof(entry->pack_header)) {
+			return false;
+		}
+		memcpy(entry->pack_header, root->map_data, sizeof(entry->pack_header));
+		return true;
+	}
+
+	FILE *fp = fopen(root->path, "rb");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	bool success = fread(entry->pack_header, sizeof(entry->pack_header), 1, fp) == 1;
+	fclose(fp);
+
+	return success;
+}
+
+static bool cf_cached_root_valid(const cf_root *root, const cf_cached_root &cached)
+{
+	if (cached.roottype != root->roottype) {
+		return false;
+	}
+
+	if (root->roottype == CF_ROOTTYPE_PACK) {
+		cf_cached_root current;
+		return cf_get_pack_signature(root, &current) && current.pack_size == cached.pack_size &&
+			current.pack_time == cached.pack_time &&
+			!memcmp(current.pack_header, cached.pack_header, sizeof(current.pack_header));
+	}
+
+	// Adding, removing or renaming a file changes the modification time of its directory
+	for (auto &dir : cached.dirs) {
+		if (cf_get_modification_time(dir.first.c_str()) != dir.second) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void cf_read_cache_string(FILE *fp, SCP_string &str, bool &success)
+{
+	uint16_t len = 0;
+	success = success && fread(&len, sizeof(len), 1, fp) == 1;
+
+	str.resize(success ? len : 0);
+	if (success && len > 0) {
+		success = fread(&str[0], 1, len, fp) == len;
+	}
+}
+
+template<typename T>
+static void cf_read_cache_value(FILE *fp, T &value, bool &success)
+{
+	success = success && fread(&value, sizeof(value), 1, fp) == 1;
+}
+
+static void cf_write_cache_string(FILE *fp, const SCP_string &str, bool &success)
+{
+	auto len = (uint16_t)str.size();
+	success = success && fwrite(&len, sizeof(len), 1, fp) == 1 && fwrite(str.c_str(), 1, len, fp) == len;
+}
+
+template<typename T>
+static void cf_write_cache_value(FILE *fp, const T &value, bool &success)
+{
+	success = success && fwrite(&value, sizeof(value), 1, fp) == 1;
+}
+
+static void cf_load_file_list_cache(const SCP_string &path, SCP_unordered_map<SCP_string, cf_cached_root> &cache)
+{
+	FILE *fp = fopen(path.c_str(), "rb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	char magic[4];
+	int version = 0;
+	int num_path_types = 0;
+	uint32_t num_roots = 0;
+
+	bool success = fread(magic, sizeof(magic), 1, fp) == 1 && !memcmp(magic, "CFLC", 4);
+	cf_read_cache_value(fp, version, success);
+	cf_read_cache_value(fp, num_path_types, success);
+	cf_read_cache_value(fp, num_roots, success);
+
+	// The files refer to path types by their index
+	success = success && version == CF_FILE_LIST_CACHE_VERSION && num_path_types == CF_MAX_PATH_TYPES;
+
+	for (uint32_t i = 0; success && i < num_roots; ++i) {
+		SCP_string root_path;
+		cf_cached_root entry;
+		uint32_t count = 0;
+
+		cf_read_cache_string(fp, root_path, success);
+		cf_read_cache_value(fp, entry.roottype, success);
+		cf_read_cache_value(fp, entry.pack_size, success);
+		cf_read_cache_value(fp, entry.pack_time, success);
+		success = success && fread(entry.pack_header, sizeof(entry.pack_header), 1, fp) == 1;
+
+		cf_read_cache_value(fp, count, success);
+		for (uint32_t j = 0; success && j < count; ++j) {
+			std::pair<SCP_string, int64_t> dir;
+			cf_read_cache_string(fp, dir.first, success);
+			cf_read_cache_value(fp, dir.second, success);
+			entry.dirs.push_back(dir);
+		}
+
+		cf_read_cache_value(fp, count, success);
+		for (uint32_t j = 0; success && j < count; ++j) {
+			cf_cached_file file;
+			cf_read_cache_string(fp, file.name_ext, success);
+			cf_read_cache_value(fp, file.pathtype_index, success);
+			cf_read_cache_value(fp, file.write_time, success);
+			cf_read_cache_value(fp, file.size, success);
+			cf_read_cache_value(fp, file.pack_offset, success);
+			cf_read_cache_value(fp, file.stored_size, success);
+			cf_read_cache_string(fp, file.real_name, success);
+
+			success = success && file.name_ext.size() < CF_MAX_FILENAME_LENGTH && file.pathtype_index >= 0 &&
+				file.pathtype_index < CF_MAX_PATH_TYPES;
+			entry.files.push_back(file);
+		}
+
+		cache[root_path] = std::move(entry);
+	}
+
+	fclose(fp);
+
+	if (!success) {
+		mprintf(("Ignoring invalid file list cache '%s'\n", path.c_str()));
+		cache.clear();
+	}
+}
+
+static void cf_save_file_list_cache(const SCP_string &path, const SCP_unordered_map<SCP_string, cf_cached_root> &cache)
+{
+	// Write to a temporary file first so a crash never leaves a partial cache behind
+	auto tmp_path = path + ".tmp";
+
+	FILE *fp = fopen(tmp_path.c_str(), "wb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	int version = CF_FILE_LIST_CACHE_VERSION;
+	int num_path_types = CF_MAX_PATH_TYPES;
+	auto num_roots = (uint32_t)cache.size();
+
+	bool success = fwrite("CFLC", 4, 1, fp) == 1;
+	cf_write_cache_value(fp, version, success);
+	cf_write_cache_value(fp, num_path_types, success);
+	cf_write_cache_value(fp, num_roots, success);
+
+	for (auto &root : cache) {
+		auto &entry = root.second;
+
+		cf_write_cache_string(fp, root.first, success);
+		cf_write_cache_value(fp, entry.roottype, success);
+		cf_write_cache_value(fp, entry.pack_size, success);
+		cf_write_cache_value(fp, entry.pack_time, success);
+		success = success && fwrite(entry.pack_header, sizeof(entry.pack_header), 1, fp) == 1;
+
+		cf_write_cache_value(fp, (uint32_t)entry.dirs.size(), success);
+		for (auto &dir : entry.dirs) {
+			cf_write_cache_string(fp, dir.first, success);
+			cf_write_cache_value(fp, dir.second, success);
+		}
+
+		cf_write_cache_value(fp, (uint32_t)entry.files.size(), success);
+		for (auto &file : entry.files) {
+			cf_write_cache_string(fp, file.name_ext, success);
+			cf_write_cache_value(fp, file.pathtype_index, success);
+			cf_write_cache_value(fp, file.write_time, success);
+			cf_write_cache_value(fp, file.size, success);
+			cf_write_cache_value(fp, file.pack_offset, success);
+			cf_write_cache_value(fp, file.stored_size, success);
+			cf_write_cache_string(fp, file.real_name, success);
+		}
+	}
+
+	success = (fclose(fp) == 0) && success;
+
+	if (success) {
+		// rename() does not replace existing files on Windows
+		remove(path.c_str());
+		success = rename(tmp_path.c_str(), path.c_str()) == 0;
+	}
+
+	if (!success) {
+		remove(tmp_path.c_str());
+	}
+}
+
+static void cf_add_cached_files(int root_index, const cf_cached_root &cached)
+{
+	for (auto &cached_file : cached.files) {
+		cf_file *file = cf_create_file();
+
+		strcpy_s(file->name_ext, cached_file.name_ext.c_str());
+		file->root_index = root_index;
+		file->pathtype_index = cached_file.pathtype_index;
+		file->write_time = (time_t)cached_file.write_time;
+		file->size = cached_file.size;
+		file->pack_offset = cached_file.pack_offset;
+		file->stored_size = cached_file.stored_size;
+
+		if (!cached_file.real_name.empty()) {
+			file->real_name = vm_strdup(cached_file.real_name.c_str());
+		}
+	}
+}
+
+// Changing a loose file does not change the modification time of its directory so the size and time of a file taken
+// from the cache are checked again once the file is actually used
+static void cf_refresh_cached_file(cf_file *f, CFileLocation &res)
+{
+	if (!cf_get_root(f->root_index)->cached) {
+		return;
+	}
+
+	struct stat buf;
+	if (stat(f->real_name, &buf) == 0) {
+		f->size = (int)buf.st_size;
+		f->write_time = buf.st_mtime;
+		res.size = static_cast<size_t>(f->size);
+	}
+}
+
 void cf_build_file_list()
 {
 	int i;
 
 	Num_files = 0;
 
+	const int cache_location_flags = CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT;
+
+	SCP_string cache_path;
+	SCP_unordered_map<SCP_string, cf_cached_root> cached_roots;
+	SCP_unordered_map<SCP_string, cf_cached_root> new_cache;
+	bool cache_changed = false;
+
+	// Modification times only have a resolution of a second so a change made right after the scan could go unnoticed.
+	// Anything that changed this recently is scanned again on the next start.
+	auto recent_time = (int64_t)time(nullptr) - 1;
+	auto cached_time = [recent_time](int64_t mtime) { return mtime >= recent_time ? CF_CACHE_TIME_RECENT : mtime; };
+
+	if ( !Cmdline_no_filelist_cache ) {
+		cf_create_default_path_string(cache_path, CF_TYPE_CACHE, CF_FILE_LIST_CACHE_NAME, false, cache_location_flags);
+
+		// Without a real directory there is no place for the cache
+		if (cache_path.find(DIR_SEPARATOR_CHAR) == SCP_string::npos) {
+			cache_path.clear();
+		} else {
+			cf_load_file_list_cache(cache_path, cached_roots);
+		}
+	}
+
 	// For each root, find all files...
 	for (i=0; i<Num_roots; i++ )	{
 		cf_root	*root = cf_get_root(i);
+
+		if (root->roottype == CF_ROOTTYPE_MEMORY) {
+			cf_search_memory_root(i);
+			continue;
+		}
+
+		if ( !cache_path.empty() ) {
+			auto cached = cached_roots.find(root->path);
+
+			if ( (cached != cached_roots.end()) && cf_cached_root_valid(root, cached->second) ) {
+				cf_add_cached_files(i, cached->second);
+				root->cached = true;
+
+				new_cache[root->path] = std::move(cached->second);
+				continue;
+			}
+		}
+
+		int first_file = Num_files;
+		cf_cached_root entry;
+		entry.roottype = root->roottype;
+
 		if ( root->roottype == CF_ROOTTYPE_PATH )	{
-			cf_search_root_path(i);
+			SCP_vector<SCP_string> searched_dirs;
+			cf_search_root_path(i, &searched_dirs);
+
+			// The root itself is included so a root that does not exist yet is searched again once it does
+			entry.dirs.emplace_back(root->path, cached_time(cf_get_modification_time(root->path)));
+			for (auto &dir : searched_dirs) {
+				entry.dirs.emplace_back(dir, cached_time(cf_get_modification_time(dir.c_str())));
+			}
 		} else if ( root->roottype == CF_ROOTTYPE_PACK )	{
 			cf_search_root_pack(i);
-		} else if (root->roottype == CF_ROOTTYPE_MEMORY) {
-			cf_search_memory_root(i);
+
+			if ( !cf_get_pack_signature(root, &entry) ) {
+				continue;
+			}
+			entry.pack_time = cached_time(entry.pack_time);
 		}
+
+		if ( cache_path.empty() ) {
+			continue;
+		}
+
+		for (int j = first_file; j < Num_files; ++j) {
+			auto f = cf_get_file(j);
+
+			cf_cached_file file;
+			file.name_ext = f->name_ext;
+			file.pathtype_index = f->pathtype_index;
+			file.write_time = (int64_t)f->write_time;
+			file.size = f->size;
+			file.pack_offset = f->pack_offset;
+			file.stored_size = f->stored_size;
+			if (f->real_name != nullptr) {
+				file.real_name = f->real_name;
+			}
+
+			entry.files.push_back(file);
+		}
+
+		new_cache[root->path] = std::move(entry);
+		cache_changed = true;
 	}
 
+	// Roots that are no longer used are dropped from the cache as well
+	if ( !cache_path.empty() && (cache_changed || new_cache.size() != cached_roots.size()) ) {
+		cf_create_directory(CF_TYPE_CACHE, cache_location_flags);
+		cf_save_file_list_cache(cache_path, new_cache);
+	}
 }
 
 
+bool cf_file_list_cache_used(const char *filename, int pathtype)
+{
+	for (int i = 0; i < Num_files; ++i) {
+		auto f = cf_get_file(i);
+
+		if ( (f->pathtype_index == pathtype) && !stricmp(f->name_ext, filename) ) {
+			return cf_get_root(f->root_index)->cached;
+		}
+	}
+
+	return false;
+}
+
 void cf_build_secondary_filelist(const char *cdrom_dir)
 {
 	int i;
@@ -979,6 +1507,11 @@ void cf_free_secondary_filelist()
 {
 	int i;
 
+	// Release the mapped packs before their roots go away
+	for (i=0; i<Num_roots; i++ )	{
+		cf_unmap_pack(cf_get_root(i));
+	}
+
 	// Free the root blocks
 	for (i=0; i<CF_MAX_ROOT_BLOCKS; i++ )	{
 		if ( Root_blocks[i] )	{
@@ -1154,6 +1687,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 					res.size = static_cast<size_t>(f->size);
 					res.offset = (size_t)f->pack_offset;
 					res.data_ptr = f->data;
+					res.stored_size = static_cast<size_t>(f->stored_size);
 
 					if (f->data != nullptr) {
 						// This is an in-memory file so we just copy the pathtype name + file name
@@ -1163,11 +1697,13 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 					} else if (f->pack_offset < 1) {
 						// This is a real file, return the actual file path
 						res.full_name = f->real_name;
+						cf_refresh_cached_file(f, res);
 					} else {
 						// File is in a pack file
 						cf_root *r = cf_get_root(f->root_index);
 
 						res.full_name = r->path;
+						res.data_ptr = cf_get_pack_view(r, f);
 					}
 
 					return res;
@@ -1181,6 +1717,7 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 			res.size = static_cast<size_t>(f->size);
 			res.offset = (size_t)f->pack_offset;
 			res.data_ptr = f->data;
+			res.stored_size = static_cast<size_t>(f->stored_size);
 
 			if (f->data != nullptr) {
 				// This is an in-memory file so we just copy the pathtype name + file name
@@ -1190,11 +1727,13 @@ CFileLocation cf_find_file_location(const char* filespec, int pathtype, bool loc
 			} else if (f->pack_offset < 1) {
 				// This is a real file, return the actual file path
 				res.full_name = f->real_name;
+				cf_refresh_cached_file(f, res);
 			} else {
 				// File is in a pack file
 				cf_root *r = cf_get_root(f->root_index);
 
 				res.full_name = r->path;
+				res.data_ptr = cf_get_pack_view(r, f);
 			}
 
 			return res;
@@ -1419,6 +1958,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 						res.size = static_cast<size_t>(f->size);
 						res.offset = (size_t)f->pack_offset;
 						res.data_ptr = f->data;
+						res.stored_size = static_cast<size_t>(f->stored_size);
 
 						if (f->data != nullptr) {
 							// This is an in-memory file so we just copy the pathtype name + file name
@@ -1428,11 +1968,13 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 						} else if (f->pack_offset < 1) {
 							// This is a real file, return the actual file path
 							res.full_name = f->real_name;
+							cf_refresh_cached_file(f, res);
 						} else {
 							// File is in a pack file
 							cf_root *r = cf_get_root(f->root_index);
 
 							res.full_name = r->path;
+							res.data_ptr = cf_get_pack_view(r, f);
 						}
 
 						// found it, so cleanup and return
@@ -1450,6 +1992,7 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 				res.size = static_cast<size_t>(f->size);
 				res.offset = (size_t)f->pack_offset;
 				res.data_ptr = f->data;
+				res.stored_size = static_cast<size_t>(f->stored_size);
 
 				if (f->data != nullptr) {
 					// This is an in-memory file so we just copy the pathtype name + file name
@@ -1459,11 +2002,13 @@ CFileLocationExt cf_find_file_location_ext( const char *filename, const int ext_
 				} else if (f->pack_offset < 1) {
 					// This is a real file, return the actual file path
 					res.full_name = f->real_name;
+					cf_refresh_cached_file(f, res);
 				} else {
 					// File is in a pack file
 					cf_root *r = cf_get_root(f->root_index);
 
 					res.full_name = r->path;
+					res.data_ptr = cf_get_pack_view(r, f);
 				}
 
 				// found it, so cleanup and return
@@ -18,6 +18,9 @@
 void cf_build_secondary_filelist( const char *cdrom_path );
 void cf_free_secondary_filelist();
 
+// Returns true if the root of the first file with the given name was taken from the file list cache, used by the tests
+bool cf_file_list_cache_used(const char *filename, int pathtype);
+
 // Internal stuff
 typedef struct cf_pathtype {
 	int			index;					// To verify that the CF_TYPE define is correctly indexed into this array
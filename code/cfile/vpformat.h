@@ -0,0 +1,59 @@
+#ifndef _VPFORMAT_H
+#define _VPFORMAT_H
+
+#include <cctype>
+#include <cstdint>
+
+// Layout of compressed VP archives, shared by cfile, cfilearchiver and cfileextractor
+//
+// Version 3 archives have the same header and directory index as version 2 archives except that every index entry is
+// followed by the number of bytes the file takes up in the archive and the flags of the file. The size in the entry is
+// always the uncompressed size. The data of every file starts at a multiple of VP_DATA_ALIGNMENT so it stays aligned
+// when the archive is mapped into memory.
+//
+// Behind the index the archive stores a hash table over the full paths of all files ("data/tables/ships.tbl") which
+// allows finding a single file without walking the directory index. The table is followed by a vp_index_footer which
+// is always the last thing in the archive.
+
+#define VP_VERSION					2
+#define VP_VERSION_COMPRESSED		3
+
+#define VP_DATA_ALIGNMENT			16
+
+#define VP_FILE_FLAG_DEFLATE		(1<<0)		// File data is a zlib stream
+
+#define VP_FOOTER_ID				"VPHT"
+
+// The size of an index entry in a version 2 archive
+#define VP_INDEX_ENTRY_SIZE			(4 + 4 + 32 + 4)
+// The size of an index entry in a version 3 archive
+#define VP_INDEX_ENTRY_SIZE_COMPRESSED	(VP_INDEX_ENTRY_SIZE + 4 + 4)
+
+typedef struct vp_hash_bucket {
+	uint32_t hash;
+	int index;			// Index of the entry in the directory index, -1 if the bucket is empty
+} vp_hash_bucket;
+
+typedef struct vp_index_footer {
+	int hash_table_offset;
+	int hash_table_size;	// Number of buckets, always a power of two
+	char id[4];				// VP_FOOTER_ID
+} vp_index_footer;
+
+// Hashes the full path of a file in an archive. Case and the type of directory separator do not matter.
+inline uint32_t vp_path_hash(const char* path)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+
+	for (; *path != '\0'; ++path) {
+		auto c = *path == '\\' ? '/' : (char)tolower((unsigned char)*path);
+
+		hash ^= (uint8_t)c;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+#endif
@@ -25,10 +25,14 @@
 
 #include "globalincs/pstypes.h"
 #include "cfile/cfile.h"
+#include "cfile/vpformat.h"
+
+#include <zlib.h>
 
 
 static int data_error;
 static int no_dir;
+static int compress_files;
 
 // right out of pstypes.h but we don't want to use the INTEL_INT macro here
 // since it would require SDL which isn't used on WIN32 platforms
@@ -57,6 +61,11 @@ unsigned int Num_files =0;
 FILE *fp_out = NULL;
 FILE *fp_out_hdr = NULL;
 
+// Path of the directory that is currently being packed, relative to the archive, and the hashes of all packed files
+// for the index footer of compressed archives
+char current_path[1024];
+SCP_vector<vp_hash_bucket> file_hashes;
+
 typedef struct vp_header {
 	char id[4];
 	int version;
@@ -70,13 +79,12 @@ char archive_dat[1024];
 char archive_hdr[1024];
 
 #define BLOCK_SIZE (1024*1024)
-#define VERSION_NUMBER 2;
 
 char tmp_data[BLOCK_SIZE];		// 1 MB
 
 void write_header()
 {
-	int ver = VERSION_NUMBER;
+	int ver = compress_files ? VP_VERSION_COMPRESSED : VP_VERSION;
 
 	fseek(fp_out, 0, SEEK_SET);
 	fwrite("VPVP", 1, 4, fp_out);
@@ -85,10 +93,45 @@ void write_header()
 	fswrite_int((int*)&Num_files, fp_out);
 }
 
+// Appends the hash table over all file paths and the footer pointing at it
+void write_hash_table(FILE *d, int table_offset)
+{
+	unsigned int table_size = 16;
+	while ( table_size < file_hashes.size() * 2 ) {
+		table_size *= 2;
+	}
+
+	SCP_vector<vp_hash_bucket> table(table_size);
+	for (auto& bucket : table) {
+		bucket.hash = 0;
+		bucket.index = -1;
+	}
+
+	for (auto& entry : file_hashes) {
+		unsigned int bucket = entry.hash & (table_size - 1);
+		while ( table[bucket].index >= 0 ) {
+			bucket = (bucket + 1) & (table_size - 1);
+		}
+		table[bucket] = entry;
+	}
+
+	for (auto& bucket : table) {
+		int hash = (int)bucket.hash;
+		fswrite_int(&hash, d);
+		fswrite_int(&bucket.index, d);
+	}
+
+	int size = (int)table_size;
+	fswrite_int(&table_offset, d);
+	fswrite_int(&size, d);
+	fwrite(VP_FOOTER_ID, 1, 4, d);
+}
+
 int write_index(char *hf, char *df)
 {
 	FILE *h = NULL, *d = NULL;
 	unsigned int i;
+	size_t entry_size = compress_files ? VP_INDEX_ENTRY_SIZE_COMPRESSED : VP_INDEX_ENTRY_SIZE;
 
 	h = fopen(hf, "rb");
 	d = fopen(df, "a+b");
@@ -103,8 +146,12 @@ int write_index(char *hf, char *df)
 	}
 
 	for (i = 0; i < Num_files; i++) {
-		fread(tmp_data, 32+4+4+4, 1, h);
-		fwrite(tmp_data, 32+4+4+4, 1, d);
+		fread(tmp_data, entry_size, 1, h);
+		fwrite(tmp_data, entry_size, 1, d);
+	}
+
+	if (compress_files) {
+		write_hash_table(d, (int)(Total_size + Num_files * entry_size));
 	}
 
 	fclose(h);
@@ -115,6 +162,61 @@ int write_index(char *hf, char *df)
 	return 1;
 }
 
+// Writes a file to a compressed archive. Files that do not get smaller are stored as they are.
+void pack_file_compressed( FILE *fp, char *filename, int filesize, _fs_time_t time_write )
+{
+	char name[32];
+	char full_path[1024];
+
+	SCP_vector<Bytef> data(filesize);
+	if ( fread(data.data(), 1, filesize, fp) != (size_t)filesize ) {
+		printf( "Error reading '%s'\n", filename );
+		exit(1);
+	}
+
+	uLongf stored_size = compressBound(filesize);
+	SCP_vector<Bytef> stored(stored_size);
+	int flags = VP_FILE_FLAG_DEFLATE;
+
+	if ( (compress2(stored.data(), &stored_size, data.data(), filesize, Z_BEST_COMPRESSION) != Z_OK) || (stored_size >= (uLongf)filesize) ) {
+		stored.swap(data);
+		stored_size = filesize;
+		flags = 0;
+	}
+
+	// Keep the data of every file aligned
+	while ( Total_size % VP_DATA_ALIGNMENT ) {
+		fputc( 0, fp_out );
+		Total_size++;
+	}
+
+	memset( name, 0, sizeof(name) );
+	strcpy_s( name, filename );
+
+	int stored_bytes = (int)stored_size;
+
+	fswrite_int( (int*)&Total_size, fp_out_hdr );
+	fswrite_int( &filesize, fp_out_hdr );
+	fwrite( &name, 1, 32, fp_out_hdr );
+	fswrite_int( (int*)&time_write, fp_out_hdr );
+	fswrite_int( &stored_bytes, fp_out_hdr );
+	fswrite_int( &flags, fp_out_hdr );
+
+	sprintf( full_path, "%s/%s", current_path, filename );
+
+	vp_hash_bucket entry;
+	entry.hash = vp_path_hash(full_path);
+	entry.index = (int)Num_files;
+	file_hashes.push_back(entry);
+
+	fwrite( stored.data(), 1, stored_size, fp_out );
+
+	Total_size += stored_bytes;
+	Num_files++;
+
+	printf( " %d bytes, %d stored\n", filesize, stored_bytes );
+}
+
 void pack_file( char *filespec, char *filename, int filesize, _fs_time_t time_write )
 {
 	char path[1024];
@@ -139,17 +241,6 @@ void pack_file( char *filespec, char *filename, int filesize, _fs_time_t time_wr
 		return;
 	}
 
-	memset( path, 0, sizeof(path) );
-	strcpy_s( path, filename );
-
-	fswrite_int( (int*)&Total_size, fp_out_hdr );
-	fswrite_int( &filesize, fp_out_hdr );
-	fwrite( &path, 1, 32, fp_out_hdr );
-	fswrite_int( (int*)&time_write, fp_out_hdr );
-
-	Total_size += filesize;
-	Num_files++;
-
 	printf( "Packing %s%s%s...", filespec, DIR_SEPARATOR_STR, filename );
 
 	sprintf( path, "%s%s%s", filespec, DIR_SEPARATOR_STR, filename );
@@ -162,6 +253,23 @@ void pack_file( char *filespec, char *filename, int filesize, _fs_time_t time_wr
 		exit(1);
 	}
 
+	if ( compress_files ) {
+		pack_file_compressed( fp, filename, filesize, time_write );
+		fclose(fp);
+		return;
+	}
+
+	memset( path, 0, sizeof(path) );
+	strcpy_s( path, filename );
+
+	fswrite_int( (int*)&Total_size, fp_out_hdr );
+	fswrite_int( &filesize, fp_out_hdr );
+	fwrite( &path, 1, 32, fp_out_hdr );
+	fswrite_int( (int*)&time_write, fp_out_hdr );
+
+	Total_size += filesize;
+	Num_files++;
+
 	int nbytes, nbytes_read=0;
 
 	do	{
@@ -199,6 +307,26 @@ void add_directory( char * dirname)
 	fwrite(pathptr, 1, 32, fp_out_hdr);
 	fswrite_int( &i, fp_out_hdr); // timestamp = 0
 
+	if ( compress_files ) {
+		fswrite_int( &i, fp_out_hdr); // stored size = 0
+		fswrite_int( &i, fp_out_hdr); // flags = 0
+	}
+
+	// keep track of where the following files end up
+	if ( !strcmp(pathptr, "..") ) {
+		char *sep = strrchr(current_path, '/');
+		if ( sep ) {
+			*sep = '\0';
+		} else {
+			current_path[0] = '\0';
+		}
+	} else {
+		if ( current_path[0] ) {
+			strcat( current_path, "/" );
+		}
+		strcat( current_path, pathptr );
+	}
+
 	Num_files++;
 }
 
@@ -316,13 +444,14 @@ int verify_directory( char *filespec )
 void print_instructions()
 {
 	printf("Creates a vp archive out of a FreeSpace data tree.\n\n");
-	printf("Usage:     cfilearchiver archive_name src_dir\n");
+	printf("Usage:     cfilearchiver [-c] archive_name src_dir\n");
 #ifdef _WIN32
 	printf("Example:   cfilearchiver freespace c:\\freespace\\data\n");
 #else
 	printf("Example:   cfilearchiver freespace /tmp/freespace/data\n\n");
 #endif
 	printf("Creates an archive named freespace out of the freespace data tree\n");
+	printf("With -c the files are compressed, this needs a build that reads compressed archives\n");
 	printf("For information about the FS2 directory structure, please consult\n");
 	printf("http://www.hard-light.net/wiki/index.php/FS2_Data_Structure\n");
 	exit(0);
@@ -339,6 +468,12 @@ int main(int argc, char *argv[] )
 	char archive[1024];
 	char *p;
 
+	if ( (argc > 1) && !strcmp(argv[1], "-c") ) {
+		compress_files = 1;
+		argv++;
+		argc--;
+	}
+
 	if ( argc < 3 )	{
 		print_instructions();
 	}
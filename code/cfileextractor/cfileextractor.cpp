@@ -6,8 +6,11 @@
 
 
 #include "cfile/cfile.h"
+#include "cfile/vpformat.h"
 #include "globalincs/pstypes.h"
 
+#include <zlib.h>
+
 #include <vector>
 #include <iostream>
 #include <cstdlib>
@@ -56,6 +59,7 @@ char out_dir[MAX_PATH];
 #define BLOCK_SIZE (1024*1024)
 
 char tmp_data[BLOCK_SIZE];		// 1 MB
+char inflate_data[BLOCK_SIZE];	// 1 MB
 
 static int have_index = 0;
 static int have_header = 0;
@@ -66,6 +70,7 @@ static int have_header = 0;
 #define ERR_NO_INDEX		3
 #define ERR_NO_HEADER		4
 #define ERR_PATH_TOO_LONG	5
+#define ERR_NOT_FOUND		6
 
 typedef struct vp_header {
 	char id[4];  // 'VPVP'
@@ -82,6 +87,8 @@ typedef struct vp_fileinfo {
 	int file_size;	// size of file
 	char file_name[CF_MAX_FILENAME_LENGTH];		// filename
 	_fs_time_t write_time;	// date/time in _fs_time_t type (a 32-bit version of time_t)
+	int stored_size;	// size of the file data in the VP, only in compressed VPs
+	int flags;		// VP_FILE_FLAG_*, only in compressed VPs
 
 	// not in the VP
 	char file_path[CF_MAX_PATHNAME_LENGTH];	// file path, generated here and not actually in the VP on a per file basis
@@ -92,6 +99,8 @@ typedef struct vp_fileinfo {
 		file_name[0] = '\0';
 		file_path[0] = '\0';
 		write_time = 0;
+		stored_size = 0;
+		flags = 0;
 	}
 
    ~vp_fileinfo() {}
@@ -140,6 +149,9 @@ void print_error(int err)
 		case ERR_PATH_TOO_LONG:
 			printf("ERROR: Path to output directory is too long!  Exiting...\n");
 			break;
+		case ERR_NOT_FOUND:
+			printf("ERROR: The requested file is not in the VP!  Exiting...\n");
+			break;
 		default:
 			break;
 	}
@@ -171,6 +183,28 @@ void read_header()
 	have_header = 1;
 }
 
+void read_entry(vp_fileinfo *vpinfo)
+{
+	fread(&vpinfo->offset, 1, sizeof(int), fp_in);
+	fread(&vpinfo->file_size, 1, sizeof(int), fp_in);
+	fread(&vpinfo->file_name, 1, CF_MAX_FILENAME_LENGTH, fp_in);
+	fread(&vpinfo->write_time, 1, sizeof(_fs_time_t), fp_in);
+
+	vpinfo->offset = INT_SWAP(vpinfo->offset);
+	vpinfo->file_size = INT_SWAP(vpinfo->file_size);
+	vpinfo->write_time = INT_SWAP(vpinfo->write_time);
+
+	if (VP_Header.version == VP_VERSION_COMPRESSED) {
+		fread(&vpinfo->stored_size, 1, sizeof(int), fp_in);
+		fread(&vpinfo->flags, 1, sizeof(int), fp_in);
+
+		vpinfo->stored_size = INT_SWAP(vpinfo->stored_size);
+		vpinfo->flags = INT_SWAP(vpinfo->flags);
+	} else {
+		vpinfo->stored_size = vpinfo->file_size;
+	}
+}
+
 void read_index(int lc = 0)
 {
 	if (fp_in == NULL)
@@ -188,14 +222,7 @@ void read_index(int lc = 0)
 	for ( i = 0; i < VP_Header.num_files; i++) {
 		vp_fileinfo vpinfo;
 
-		fread(&vpinfo.offset, 1, sizeof(int), fp_in);
-		fread(&vpinfo.file_size, 1, sizeof(int), fp_in);
-		fread(&vpinfo.file_name, 1, CF_MAX_FILENAME_LENGTH, fp_in);
-		fread(&vpinfo.write_time, 1, sizeof(_fs_time_t), fp_in);
-
-		vpinfo.offset = INT_SWAP(vpinfo.offset);
-		vpinfo.file_size = INT_SWAP(vpinfo.file_size);
-		vpinfo.write_time = INT_SWAP(vpinfo.write_time);
+		read_entry(&vpinfo);
 
 		// check if it's a directory and if so then create a path to use for files
 		if (vpinfo.file_size == 0) {
@@ -232,6 +259,166 @@ void read_index(int lc = 0)
 	have_index = 1;
 }
 
+// compares two paths ignoring case and the kind of directory separator
+bool same_path(const char *a, const char *b)
+{
+	for ( ; *a && *b; a++, b++) {
+		char ca = (*a == '\\') ? '/' : (char)tolower(*a);
+		char cb = (*b == '\\') ? '/' : (char)tolower(*b);
+
+		if (ca != cb)
+			return false;
+	}
+
+	return *a == *b;
+}
+
+// Finds a single file by its full path in the VP (like "data/tables/ships.tbl"). Compressed VPs have a hash table
+// for this so the index doesn't have to be read, older VPs are searched one entry at a time.
+bool find_file(const char *file_path, vp_fileinfo *vpinfo, int lc)
+{
+	const char *name = file_path;
+	for (const char *c = file_path; *c; c++) {
+		if ( (*c == '/') || (*c == '\\') )
+			name = c + 1;
+	}
+
+	if (VP_Header.version == VP_VERSION_COMPRESSED) {
+		vp_index_footer footer;
+
+		fseek(fp_in, -(long)sizeof(vp_index_footer), SEEK_END);
+		fread(&footer.hash_table_offset, 1, sizeof(int), fp_in);
+		fread(&footer.hash_table_size, 1, sizeof(int), fp_in);
+		fread(&footer.id, 1, 4, fp_in);
+
+		footer.hash_table_offset = INT_SWAP(footer.hash_table_offset);
+		footer.hash_table_size = INT_SWAP(footer.hash_table_size);
+
+		if ( !memcmp(footer.id, VP_FOOTER_ID, 4) && (footer.hash_table_size > 0) ) {
+			uint32_t hash = vp_path_hash(file_path);
+			uint32_t mask = (uint32_t)footer.hash_table_size - 1;
+
+			for (uint32_t probe = 0; probe <= mask; probe++) {
+				vp_hash_bucket bucket;
+
+				fseek(fp_in, footer.hash_table_offset + (int)(((hash + probe) & mask) * 8), SEEK_SET);
+				fread(&bucket.hash, 1, sizeof(int), fp_in);
+				fread(&bucket.index, 1, sizeof(int), fp_in);
+
+				bucket.hash = INT_SWAP(bucket.hash);
+				bucket.index = INT_SWAP(bucket.index);
+
+				if (bucket.index < 0)
+					return false;
+
+				if (bucket.hash != hash)
+					continue;
+
+				fseek(fp_in, VP_Header.index_offset + bucket.index * VP_INDEX_ENTRY_SIZE_COMPRESSED, SEEK_SET);
+				read_entry(vpinfo);
+
+				vpinfo->file_name[CF_MAX_FILENAME_LENGTH-1] = '\0';
+
+				if ( stricmp(vpinfo->file_name, name) )
+					continue;
+
+				// directories always use lower case and the separator of this platform, like in read_index()
+				size_t path_len = MIN((size_t)(name - file_path), sizeof(vpinfo->file_path));
+				strncpy(vpinfo->file_path, file_path, path_len);
+				vpinfo->file_path[path_len ? path_len - 1 : 0] = '\0';
+
+				for (char *c = vpinfo->file_path; *c; c++) {
+					*c = ( (*c == '/') || (*c == '\\') ) ? DIR_SEPARATOR_CHAR : (char)tolower(*c);
+				}
+
+				if (lc == 1)
+					lowercase( vpinfo->file_name );
+
+				return true;
+			}
+
+			return false;
+		}
+	}
+
+	read_index( lc );
+
+	for (auto &info : VP_FileInfo) {
+		char full_path[CF_MAX_PATHNAME_LENGTH+CF_MAX_FILENAME_LENGTH+1];
+		sprintf(full_path, "%s%s%s", info.file_path, DIR_SEPARATOR_STR, info.file_name);
+
+		if ( same_path(full_path, file_path) ) {
+			*vpinfo = info;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Writes the data of a file in the VP to fp, compressed data is decompressed
+bool write_file_data(vp_fileinfo *vpinfo, FILE *fp)
+{
+	int nbytes, nbytes_remaining;
+
+	fseek(fp_in, vpinfo->offset, SEEK_SET);
+
+	nbytes_remaining = vpinfo->stored_size;
+
+	if ( !(vpinfo->flags & VP_FILE_FLAG_DEFLATE) ) {
+		while ( nbytes_remaining > 0 ) {
+			nbytes = fread( tmp_data, 1, MIN(BLOCK_SIZE, nbytes_remaining), fp_in );
+
+			if (nbytes <= 0)
+				return false;
+
+			fwrite( tmp_data, 1, nbytes, fp );
+			nbytes_remaining -= nbytes;
+		}
+
+		return true;
+	}
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+
+	if (inflateInit(&stream) != Z_OK)
+		return false;
+
+	int ret = Z_OK;
+
+	while ( (nbytes_remaining > 0) && (ret != Z_STREAM_END) ) {
+		nbytes = fread( tmp_data, 1, MIN(BLOCK_SIZE, nbytes_remaining), fp_in );
+
+		if (nbytes <= 0)
+			break;
+
+		nbytes_remaining -= nbytes;
+
+		stream.next_in = (Bytef*)tmp_data;
+		stream.avail_in = nbytes;
+
+		// decompress everything that was just read
+		do {
+			stream.next_out = (Bytef*)inflate_data;
+			stream.avail_out = BLOCK_SIZE;
+
+			ret = inflate(&stream, Z_NO_FLUSH);
+
+			if ( (ret == Z_NEED_DICT) || (ret == Z_DATA_ERROR) || (ret == Z_MEM_ERROR) ) {
+				inflateEnd(&stream);
+				return false;
+			}
+
+			fwrite( inflate_data, 1, BLOCK_SIZE - stream.avail_out, fp );
+		} while (stream.avail_out == 0);
+	}
+
+	inflateEnd(&stream);
+
+	return ret == Z_STREAM_END;
+}
+
 void extract_all_files(char *file)
 {
 	if (fp_in == NULL)
@@ -241,7 +428,7 @@ void extract_all_files(char *file)
 	else if (!have_index)
 		print_error(ERR_NO_INDEX);
 
-	int status, m_error, nbytes, nbytes_remaining;
+	int status, m_error;
 	char path[CF_MAX_PATHNAME_LENGTH+CF_MAX_FILENAME_LENGTH+1]; // path length + filename length + extra NULL
 	char path2[CF_MAX_PATHNAME_LENGTH+CF_MAX_FILENAME_LENGTH+1]; // path length + filename length + extra NULL
 	char *c;
@@ -299,9 +486,6 @@ void extract_all_files(char *file)
 
 		memset( path, 0, CF_MAX_PATHNAME_LENGTH+CF_MAX_FILENAME_LENGTH+1);
 
-		// start writing out the file
-		fseek(fp_in, VP_FileInfo[i].offset, SEEK_SET);
-
 		sprintf(path, "%s%s%s", VP_FileInfo[i].file_path, DIR_SEPARATOR_STR, VP_FileInfo[i].file_name);
 
 		// this is cheap, I know.
@@ -323,19 +507,12 @@ void extract_all_files(char *file)
 			continue;
 		}
 
-		nbytes_remaining = VP_FileInfo[i].file_size;
-
-		while ( nbytes_remaining > 0 ) {
-			nbytes = fread( tmp_data, 1, MIN(BLOCK_SIZE, nbytes_remaining), fp_in );
-
-			if (nbytes > 0) {
-				fwrite( tmp_data, 1, nbytes, fp_out );
-				nbytes_remaining -= nbytes;
-			}
+		if ( write_file_data(&VP_FileInfo[i], fp_out) ) {
+			printf("done!\n");
+		} else {
+			printf("corrupt data!\n");
 		}
 
-		printf("done!\n");
-
 		fclose(fp_out);
 		fp_out = NULL;
 	}
@@ -406,11 +583,12 @@ void help()
 {
 	printf("VP file extractor - version 0.6\n");
 	printf("\n");
-	printf("Usage:  cfileextractor [-x | -l] [-L] [-o <dir>] <vp_filename>\n");
+	printf("Usage:  cfileextractor [-x | -l | -f <path>] [-L] [-o <dir>] <vp_filename>\n");
 	printf("\n");
 	printf(" Commands (only one at the time):\n");
 	printf("  -x | --extract        Extract all files into current directory.\n");
 	printf("  -l | --list           List all files in VP archive.\n");
+	printf("  -f <path>             Extract the file with this path, like data/tables/ships.tbl.\n");
 	printf("  -h | --help           Show this help text.\n");
 	printf("\n");
 	printf(" Options:\n");
@@ -431,6 +609,7 @@ void help()
 int main(int argc, char *argv[])
 {
 	int extract = 0, lc = 0, list = 0;
+	char *single_file = NULL;
 
 	if (argc < 2) {
 		help();
@@ -453,7 +632,6 @@ int main(int argc, char *argv[])
 
 	memset(out_dir, 0, MAX_PATH);
 
-	// TODO: add filter based extraction
 	for (int i = 1; i < argc-1; i++) {
 		if (!strcmp(argv[i], "-x") || !strcmp(argv[i], "--extract")) {
 			if (list) {
@@ -469,6 +647,13 @@ int main(int argc, char *argv[])
 				exit(0);
 			}
 			list = 1;
+		} else if ( !strcmp(argv[i], "-f") && (i+1 < argc-1) ) {
+			if (extract || list) {
+				help();
+				exit(0);
+			}
+			single_file = argv[i+1];
+			i++;  // skip the path of the file
 		} else if ( !strcmp(argv[i], "-o") && (i+1 < argc) && (argv[i+1][0] != '-') ) {
 			strncpy(out_dir, argv[i+1], MAX_PATH-1);
 			i++;  // have to increment "i" past the output directory
@@ -478,6 +663,20 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	if (single_file) {
+		vp_fileinfo vpinfo;
+
+		if ( !find_file(single_file, &vpinfo, lc) )
+			print_error(ERR_NOT_FOUND);
+
+		VP_FileInfo.clear();
+		VP_FileInfo.push_back(vpinfo);
+		have_index = 1;
+
+		extract_all_files( argv[argc-1] );
+		return 0;
+	}
+
 	// read the file index, make all filenames lowercase if wanted
 	read_index( lc );
 
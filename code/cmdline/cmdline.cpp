@@ -193,6 +193,8 @@ Flag exe_params[] =
 	{ "-nosound",			"Disable all sound",						false,	0,					EASY_DEFAULT,		"Audio",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nosound", },
 	{ "-nomusic",			"Disable music",							false,	0,					EASY_DEFAULT,		"Audio",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-nomusic", },
 	{ "-no_enhanced_sound",	"Disable enhanced sound",					false,	0,					EASY_DEFAULT,		"Audio",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_enhanced_sound", },
+	{ "-no_async_sound",	"Load sounds on the main thread",			true,	0,					EASY_DEFAULT,		"Audio",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_async_sound", },
+	{ "-no_sound_cache",	"Disable the decoded sound cache",			true,	0,					EASY_DEFAULT,		"Audio",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_sound_cache", },
 
 	{ "-portable_mode",		"Store config in portable location",		false,	0,					EASY_DEFAULT,		"Launcher",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-portable_mode", },
 
@@ -244,6 +246,8 @@ Flag exe_params[] =
 	{ "-output_script_json",	"Output scripting doc to scripting.json",		true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-output_script_json", },
 	{ "-save_render_target",	"Save render targets to file",			true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-save_render_target", },
 	{ "-verify_vps",		"Spew VP CRCs to vp_crcs.txt",				true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-verify_vps", },
+	{ "-no_vp_mmap",		"Read VP files instead of mapping them",	true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_vp_mmap", },
+	{ "-no_filelist_cache",	"Don't cache the list of game files",	true,	0,				EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_filelist_cache", },
 	{ "-reparse_mainhall",	"Reparse mainhall.tbl when loading halls",	false,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-reparse_mainhall", },
 	{ "-profile_write_file", "Write profiling information to file",		true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_write_file", },
 	{ "-no_unfocused_pause","Don't pause if the window isn't focused",	true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_unfocused_pause", },
@@ -251,6 +255,7 @@ Flag exe_params[] =
 	{ "-noninteractive",	"Disables interactive dialogs",				true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-noninteractive", },
 	{ "-json_profiling",	"Generate JSON profiling output",			true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-json_profiling", },
 	{ "-profile_frame_time","Profile engine subsystems",				true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_frame_timings", },
+	{ "-profile_counters",	"Profile CPU counters of subsystems",	true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_counters", },
 	{ "-debug_window",		"Enable the debug window",					true,	0,					EASY_DEFAULT,		"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-debug_window", },
 };
 // clang-format on
@@ -391,8 +396,13 @@ int Cmdline_stretch_menu = 0;
 // Audio related
 cmdline_parm voice_recognition_arg("-voicer", NULL, AT_NONE);	// Cmdline_voice_recognition
 
+cmdline_parm noasyncsound_arg("-no_async_sound", NULL, AT_NONE);	// Cmdline_no_async_sound
+cmdline_parm nosoundcache_arg("-no_sound_cache", NULL, AT_NONE);	// Cmdline_no_sound_cache
+
 int Cmdline_voice_recognition = 0;
 int Cmdline_no_enhanced_sound = 0;
+bool Cmdline_no_async_sound = false;
+bool Cmdline_no_sound_cache = false;
 
 // MOD related
 cmdline_parm mod_arg("-mod", "List of folders to overwrite/add-to the default data", AT_STRING, true);	// Cmdline_mod  -- DTP modsupport
@@ -471,6 +481,8 @@ cmdline_parm fullscreen_window_arg("-fullscreen_window", "Fullscreen/borderless
 cmdline_parm res_arg("-res", "Resolution, formatted like 1600x900", AT_STRING);
 cmdline_parm center_res_arg("-center_res", "Resolution of center monitor, formatted like 1600x900", AT_STRING);
 cmdline_parm verify_vps_arg("-verify_vps", NULL, AT_NONE);	// Cmdline_verify_vps  -- spew VP crcs to vp_crcs.txt
+cmdline_parm no_vp_mmap_arg("-no_vp_mmap", NULL, AT_NONE);	// Cmdline_no_vp_mmap  -- read VP files through stdio instead of mapping them
+cmdline_parm no_filelist_cache_arg("-no_filelist_cache", NULL, AT_NONE);	// Cmdline_no_filelist_cache  -- don't use the file list cached from the last start
 cmdline_parm parse_cmdline_only(PARSE_COMMAND_LINE_STRING, "Ignore any cmdline_fso.cfg files", AT_NONE);
 cmdline_parm reparse_mainhall_arg("-reparse_mainhall", NULL, AT_NONE); //Cmdline_reparse_mainhall
 cmdline_parm frame_profile_write_file("-profile_write_file", NULL, AT_NONE); // Cmdline_profile_write_file
@@ -480,6 +492,7 @@ cmdline_parm noninteractive_arg("-noninteractive", NULL, AT_NONE); //Cmdline_non
 cmdline_parm json_profiling("-json_profiling", NULL, AT_NONE); //Cmdline_json_profiling
 cmdline_parm show_video_info("-show_video_info", NULL, AT_NONE); //Cmdline_show_video_info
 cmdline_parm frame_profile_arg("-profile_frame_time", NULL, AT_NONE); //Cmdline_frame_profile
+cmdline_parm profile_counters_arg("-profile_counters", NULL, AT_NONE); //Cmdline_profile_counters
 cmdline_parm debug_window_arg("-debug_window", NULL, AT_NONE);	// Cmdline_debug_window
 
 
@@ -501,6 +514,8 @@ int Cmdline_fullscreen_window = 0;
 char *Cmdline_res = 0;
 char *Cmdline_center_res = 0;
 int Cmdline_verify_vps = 0;
+bool Cmdline_no_vp_mmap = false;
+bool Cmdline_no_filelist_cache = false;
 int Cmdline_reparse_mainhall = 0;
 bool Cmdline_profile_write_file = false;
 bool Cmdline_no_unfocus_pause = false;
@@ -508,6 +523,7 @@ bool Cmdline_benchmark_mode = false;
 bool Cmdline_noninteractive = false;
 bool Cmdline_json_profiling = false;
 bool Cmdline_frame_profile = false;
+bool Cmdline_profile_counters = false;
 bool Cmdline_show_video_info = false;
 bool Cmdline_debug_window = false;
 
@@ -1583,6 +1599,14 @@ bool SetCmdlineParams()
 		Cmdline_no_enhanced_sound = 1;
 	}
 
+	if (noasyncsound_arg.found()) {
+		Cmdline_no_async_sound = true;
+	}
+
+	if (nosoundcache_arg.found()) {
+		Cmdline_no_sound_cache = true;
+	}
+
 	// should we start a network game
 	if ( startgame_arg.found() ) {
 		Cmdline_use_last_pilot = 1;
@@ -2008,6 +2032,12 @@ bool SetCmdlineParams()
 	if ( verify_vps_arg.found() )
 		Cmdline_verify_vps = 1;
 
+	if ( no_vp_mmap_arg.found() )
+		Cmdline_no_vp_mmap = true;
+
+	if ( no_filelist_cache_arg.found() )
+		Cmdline_no_filelist_cache = true;
+
 	if ( no3dsound_arg.found() )
 		Cmdline_no_3d_sound = 1;
 
@@ -2126,6 +2156,11 @@ bool SetCmdlineParams()
 		Cmdline_frame_profile = true;
 	}
 
+	if (profile_counters_arg.found())
+	{
+		Cmdline_profile_counters = true;
+	}
+
 	if (debug_window_arg.found()) {
 		Cmdline_debug_window = true;
 	}
@@ -93,6 +93,8 @@ extern int Cmdline_stretch_menu;
 // Audio related
 extern int Cmdline_voice_recognition;
 extern int Cmdline_no_enhanced_sound;
+extern bool Cmdline_no_async_sound;
+extern bool Cmdline_no_sound_cache;
 
 // MOD related
 extern char *Cmdline_mod;	 // DTP for mod support
@@ -138,6 +140,8 @@ extern int Cmdline_show_pos;
 extern int Cmdline_show_stats;
 extern int Cmdline_save_render_targets;
 extern int Cmdline_verify_vps;
+extern bool Cmdline_no_vp_mmap;
+extern bool Cmdline_no_filelist_cache;
 extern int Cmdline_reparse_mainhall;
 extern bool Cmdline_profile_write_file;
 extern bool Cmdline_no_unfocus_pause;
@@ -145,6 +149,7 @@ extern bool Cmdline_benchmark_mode;
 extern bool Cmdline_noninteractive;
 extern bool Cmdline_json_profiling;
 extern bool Cmdline_frame_profile;
+extern bool Cmdline_profile_counters;
 extern bool Cmdline_show_video_info;
 extern bool Cmdline_debug_window;
 
@@ -0,0 +1,151 @@
+#include "globalincs/pstypes.h"
+
+namespace {
+
+// Enough for the temporaries of a busy frame, the arena grows if a frame needs more
+const size_t FRAME_ARENA_INITIAL_SIZE = 1024 * 1024;
+
+struct frame_arena {
+	uint8_t *block = nullptr;
+	size_t size = 0;
+	size_t used = 0;
+	size_t peak = 0;		// The most of the block used since the last rewind, used may shrink again when memory is freed
+
+	// Allocations that did not fit into the block, they are freed when the arena is rewound
+	std::vector<void*> overflow;
+	size_t overflow_bytes = 0;
+
+	size_t live = 0;		// Allocations that have not been freed yet
+	uint32_t frame = 0;		// The value of Frame_number when the arena was last rewound
+
+	~frame_arena() {
+		release_overflow();
+		vm_free(block);
+	}
+
+	void release_overflow() {
+		for (auto ptr : overflow) {
+			vm_free(ptr);
+		}
+		overflow.clear();
+		overflow_bytes = 0;
+	}
+};
+
+thread_local frame_arena Frame_arena;
+
+// Incremented at the end of every frame, every arena rewinds once it sees a new value
+std::atomic<uint32_t> Frame_number(1);
+
+uint64_t Last_frame_allocations = 0;
+uint64_t Frame_start_allocations = 0;
+
+void frame_arena_rewind(frame_arena &arena)
+{
+	uint32_t frame = Frame_number.load(std::memory_order_relaxed);
+
+	// Something still holds on to memory of an earlier frame, try again later
+	if (arena.frame == frame || arena.live > 0) {
+		return;
+	}
+
+	// Make room for everything the last frame needed so the next one does not overflow again
+	if (arena.block == nullptr || arena.overflow_bytes > 0) {
+		size_t new_size = MAX(FRAME_ARENA_INITIAL_SIZE, arena.size);
+		while (new_size < arena.peak + arena.overflow_bytes) {
+			new_size *= 2;
+		}
+
+		if (new_size != arena.size) {
+			vm_free(arena.block);
+			arena.block = static_cast<uint8_t*>(vm_malloc(new_size));
+			arena.size = new_size;
+		}
+
+		arena.release_overflow();
+	}
+
+	arena.used = 0;
+	arena.peak = 0;
+	arena.frame = frame;
+}
+
+}
+
+namespace memory {
+
+std::atomic<uint64_t> Num_allocations(0);
+
+void *frame_alloc(size_t size, size_t alignment)
+{
+	auto &arena = Frame_arena;
+
+	frame_arena_rewind(arena);
+
+	size_t start = (arena.used + alignment - 1) & ~(alignment - 1);
+
+	if (arena.block != nullptr && start + size <= arena.size) {
+		arena.used = start + size;
+		arena.peak = MAX(arena.peak, arena.used);
+		++arena.live;
+
+		return arena.block + start;
+	}
+
+	// vm_malloc is aligned for every type so this is good enough until the arena is rewound
+	auto ptr = vm_malloc(size);
+	arena.overflow.push_back(ptr);
+	arena.overflow_bytes += size;
+	++arena.live;
+
+	return ptr;
+}
+
+void frame_free(void *ptr, size_t size)
+{
+	auto &arena = Frame_arena;
+
+	Assertion(arena.live > 0, "Frame arena memory was freed twice or on a different thread!");
+	--arena.live;
+
+	// Overflow allocations are released when the arena is rewound
+	auto bytes = static_cast<uint8_t*>(ptr);
+	if (arena.block == nullptr || bytes < arena.block || bytes >= arena.block + arena.size) {
+		return;
+	}
+
+	// Giving back the last allocation lets a growing vector reuse the space right away
+	if (bytes + size == arena.block + arena.used) {
+		arena.used -= size;
+	}
+}
+
+void frame_arena_reset()
+{
+	Frame_number.fetch_add(1, std::memory_order_relaxed);
+	frame_arena_rewind(Frame_arena);
+
+	uint64_t allocations = Num_allocations.load(std::memory_order_relaxed);
+	Last_frame_allocations = allocations - Frame_start_allocations;
+	Frame_start_allocations = allocations;
+}
+
+uint64_t frame_allocations()
+{
+	return Last_frame_allocations;
+}
+
+frame_arena_stats frame_arena_get_stats()
+{
+	auto &arena = Frame_arena;
+
+	frame_arena_stats stats;
+	stats.block_size = arena.size;
+	stats.used = arena.used;
+	stats.overflow_bytes = arena.overflow_bytes;
+	stats.live = arena.live;
+
+	return stats;
+}
+
+}
@@ -3,6 +3,7 @@
 
 namespace memory {
 const quiet_alloc_t quiet_alloc;
+thread_local allocation_counts Thread_allocations;
 void out_of_memory() {
 	mprintf(("Memory allocation failed!!!!!!!!!!!!!!!!!!!\n"));
 	Error(LOCATION, "Out of memory.  Try closing down other applications, increasing your\n"
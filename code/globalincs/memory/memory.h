@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdlib>
 
@@ -12,10 +13,65 @@ namespace memory
 	extern const quiet_alloc_t quiet_alloc;
 
 	void out_of_memory();
+
+	// Number of vm_malloc and vm_realloc calls since the program started
+	extern std::atomic<uint64_t> Num_allocations;
+
+	struct allocation_counts {
+		uint64_t count;		// Number of vm_malloc and vm_realloc calls
+		uint64_t bytes;		// Bytes requested by those calls
+	};
+
+	// The allocations of the calling thread since it started, the tracing code uses the difference over a scope
+	extern thread_local allocation_counts Thread_allocations;
+
+	inline void count_allocation(size_t size)
+	{
+		Num_allocations.fetch_add(1, std::memory_order_relaxed);
+
+		auto& counts = Thread_allocations;
+		++counts.count;
+		counts.bytes += size;
+	}
+
+	/**
+	 * @brief Releases everything allocated from the frame arena of the calling thread
+	 *
+	 * Called by the main thread at the end of every frame. The arenas of other threads are released the next time they
+	 * are used after this.
+	 */
+	void frame_arena_reset();
+
+	/**
+	 * @brief The number of vm_malloc and vm_realloc calls made during the last frame
+	 */
+	uint64_t frame_allocations();
+
+	struct frame_arena_stats {
+		size_t block_size;		// Size of the block allocations are carved from
+		size_t used;			// Bytes of the block handed out since the last rewind
+		size_t overflow_bytes;	// Bytes which did not fit into the block and came from vm_malloc instead
+		size_t live;			// Allocations which have not been freed yet
+	};
+
+	/**
+	 * @brief The state of the frame arena of the calling thread
+	 */
+	frame_arena_stats frame_arena_get_stats();
+
+	/**
+	 * @brief Calls frame_arena_reset() when it goes out of scope
+	 */
+	struct frame_arena_scope {
+		~frame_arena_scope() { frame_arena_reset(); }
+	};
 }
 
 inline void *vm_malloc(size_t size, const memory::quiet_alloc_t &)
-{ return std::malloc(size); }
+{
+	memory::count_allocation(size);
+	return std::malloc(size);
+}
 
 inline void *vm_malloc(size_t size)
 {
@@ -33,7 +89,10 @@ inline void vm_free(void *ptr)
 { std::free(ptr); }
 
 inline void *vm_realloc(void *ptr, size_t size, const memory::quiet_alloc_t &)
-{ return std::realloc(ptr, size); }
+{
+	memory::count_allocation(size);
+	return std::realloc(ptr, size);
+}
 
 inline void *vm_realloc(void *ptr, size_t size)
 {
@@ -35,6 +35,40 @@ using SCP_queue = std::queue< T, std::deque< T, std::allocator< T > > >;
 template< typename T >
 using SCP_deque = std::deque< T, std::allocator< T > >;
 
+namespace memory {
+// The frame arena behind SCP_frame_allocator, see globalincs/memory/frame_arena.cpp
+void *frame_alloc(size_t size, size_t alignment);
+void frame_free(void *ptr, size_t size);
+}
+
+/**
+ * @brief Allocates from a per-thread arena which is released all at once at the end of the frame
+ *
+ * Meant for temporary containers that are built and thrown away within a frame. Allocating is a pointer bump and the
+ * memory is reused every frame, so these containers do not hit the heap once the arena has grown large enough. A
+ * container using this must not outlive the frame and must be freed on the thread that created it.
+ */
+template< typename T >
+class SCP_frame_allocator {
+ public:
+	typedef T value_type;
+
+	SCP_frame_allocator() {}
+	template< typename U >
+	SCP_frame_allocator(const SCP_frame_allocator< U >&) {}
+
+	T* allocate(size_t n) { return static_cast< T* >(memory::frame_alloc(n * sizeof(T), alignof(T))); }
+	void deallocate(T* p, size_t n) { memory::frame_free(p, n * sizeof(T)); }
+};
+
+template< typename T, typename U >
+bool operator==(const SCP_frame_allocator< T >&, const SCP_frame_allocator< U >&) { return true; }
+template< typename T, typename U >
+bool operator!=(const SCP_frame_allocator< T >&, const SCP_frame_allocator< U >&) { return false; }
+
+template< typename T >
+using SCP_frame_vector = std::vector< T, SCP_frame_allocator< T > >;
+
 #if __cplusplus < 201402L
 template <class T, bool>
 struct enum_hasher_util {
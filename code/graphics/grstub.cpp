@@ -7,9 +7,11 @@
 #include "globalincs/systemvars.h"
 #include "graphics/2d.h"
 #include "graphics/grinternal.h"
+#include "graphics/grstub.h"
 #include "jpgutils/jpgutils.h"
 #include "model/model.h"
 #include "graphics/material.h"
+#include "parse/parselo.h"
 #include "pcxutils/pcxutils.h"
 #include "pngutils/pngutils.h"
 #include "tgautils/tgautils.h"
@@ -17,20 +19,197 @@
 #define BMPMAN_INTERNAL
 #include "bmpman/bm_internal.h"
 
+#include <array>
+#include <cstdarg>
+
+namespace {
+
+// The render state a material sets, used for counting state changes
+struct stub_material_state {
+	int shader_type = -1;
+	uint shader_flags = 0;
+	int blend_mode = -1;
+	int depth_mode = -1;
+	bool cull = false;
+	int fill_mode = -1;
+	bool stencil = false;
+	int depth_bias = 0;
+
+	bool operator!=(const stub_material_state& other) const
+	{
+		return shader_type != other.shader_type || shader_flags != other.shader_flags ||
+			blend_mode != other.blend_mode || depth_mode != other.depth_mode || cull != other.cull ||
+			fill_mode != other.fill_mode || stencil != other.stencil || depth_bias != other.depth_bias;
+	}
+};
+
+bool Stub_recording = false;
+bool Stub_record_commands = false;
+
+gr_stub_stats Stub_stats;
+SCP_vector<SCP_string> Stub_commands;
+
+stub_material_state Stub_material_state;
+std::array<int, TM_NUM_TYPES> Stub_bound_textures;
+
+// Handles are never reused so recorded command streams stay comparable
+int Stub_next_buffer_handle = 0;
+SCP_unordered_map<int, BufferType> Stub_buffer_types;
+
+int Stub_zbuffer_mode = 0;
+int Stub_cull = 0;
+int Stub_stencil_mode = 0;
+
+void stub_record(SCP_FORMAT_STRING const char* format, ...) SCP_FORMAT_STRING_ARGS(1, 2);
+
+void stub_record(SCP_FORMAT_STRING const char* format, ...)
+{
+	if (!Stub_record_commands) {
+		return;
+	}
+
+	va_list args;
+	va_start(args, format);
+
+	SCP_string command;
+	vsprintf(command, format, args);
+
+	va_end(args);
+
+	Stub_commands.push_back(std::move(command));
+}
+
+void stub_record_state_value(int& current, int value, const char* name)
+{
+	if (current != value) {
+		++Stub_stats.state_changes;
+		current = value;
+	}
+
+	stub_record("%s %d", name, value);
+}
+
+void stub_record_draw(const material* material_info, const char* name, int n_verts, int buffer_handle)
+{
+	++Stub_stats.draw_calls;
+	Stub_stats.vertices += n_verts;
+
+	if (material_info != nullptr) {
+		stub_material_state state;
+		state.shader_type = material_info->get_shader_type();
+		state.shader_flags = material_info->get_shader_flags();
+		state.blend_mode = material_info->get_blend_mode();
+		state.depth_mode = material_info->get_depth_mode();
+		state.cull = material_info->get_cull_mode();
+		state.fill_mode = material_info->get_fill_mode();
+		state.stencil = material_info->is_stencil_enabled();
+		state.depth_bias = material_info->get_depth_bias();
+
+		if (Stub_material_state != state) {
+			++Stub_stats.state_changes;
+			Stub_material_state = state;
+		}
+
+		for (int i = 0; i < TM_NUM_TYPES; ++i) {
+			auto texture = material_info->get_texture_map(i);
+
+			if (texture >= 0 && Stub_bound_textures[i] != texture) {
+				++Stub_stats.texture_binds;
+				Stub_bound_textures[i] = texture;
+			}
+		}
+
+		stub_record("%s shader=%d flags=%x blend=%d depth=%d cull=%d fill=%d base=%d verts=%d buffer=%d", name,
+			state.shader_type, state.shader_flags, state.blend_mode, state.depth_mode, state.cull ? 1 : 0,
+			state.fill_mode, Stub_bound_textures[TM_BASE_TYPE], n_verts, buffer_handle);
+	} else {
+		stub_record("%s verts=%d buffer=%d", name, n_verts, buffer_handle);
+	}
+}
+
+void stub_record_upload(int handle, size_t size)
+{
+	++Stub_stats.buffer_uploads;
+	Stub_stats.buffer_upload_bytes += size;
+
+	auto iter = Stub_buffer_types.find(handle);
+	if (iter != Stub_buffer_types.end() && iter->second == BufferType::Uniform) {
+		++Stub_stats.uniform_buffer_uploads;
+	}
+
+	stub_record("upload buffer=%d size=" SIZE_T_ARG, handle, size);
+}
+
+}
+
+void gr_stub_set_recording(bool enable, bool record_commands)
+{
+	Stub_recording = enable;
+	Stub_record_commands = enable && record_commands;
+}
+
+void gr_stub_reset_recording()
+{
+	Stub_stats = gr_stub_stats();
+	Stub_commands.clear();
+
+	Stub_material_state = stub_material_state();
+	Stub_bound_textures.fill(-1);
+}
+
+const gr_stub_stats& gr_stub_get_stats()
+{
+	return Stub_stats;
+}
+
+const SCP_vector<SCP_string>& gr_stub_get_commands()
+{
+	return Stub_commands;
+}
+
+bool gr_stub_write_commands(const char* filename)
+{
+	auto fp = fopen(filename, "w");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	bool success = true;
+	for (auto& command : Stub_commands) {
+		success = fprintf(fp, "%s\n", command.c_str()) >= 0 && success;
+	}
+
+	return fclose(fp) == 0 && success;
+}
+
 
 uint gr_stub_lock()
 {
 	return 1;
 }
 
-int gr_stub_create_buffer(BufferType, BufferUsageHint)
+int gr_stub_create_buffer(BufferType type, BufferUsageHint)
 {
-	return -1;
+	if (!Stub_recording) {
+		return -1;
+	}
+
+	++Stub_stats.buffers_created;
+	if (type == BufferType::Uniform) {
+		++Stub_stats.uniform_buffers_created;
+	}
+
+	auto handle = Stub_next_buffer_handle++;
+	Stub_buffer_types[handle] = type;
+
+	stub_record("create_buffer %d type=%d", handle, static_cast<int>(type));
+
+	return handle;
 }
 
-void gr_stub_delete_buffer(int  /*handle*/)
+void gr_stub_delete_buffer(int handle)
 {
-
+	Stub_buffer_types.erase(handle);
 }
 
 int gr_stub_preload(int  /*bitmap_num*/, int  /*is_aabitmap*/)
@@ -48,9 +227,15 @@ int gr_stub_zbuffer_get()
 	return 0;
 }
 
-int gr_stub_zbuffer_set(int  /*mode*/)
+int gr_stub_zbuffer_set(int mode)
 {
-	return 0;
+	auto prev = Stub_zbuffer_mode;
+
+	if (Stub_recording) {
+		stub_record_state_value(Stub_zbuffer_mode, mode, "zbuffer_set");
+	}
+
+	return prev;
 }
 
 void gr_set_fill_mode_stub(int  /*mode*/)
@@ -72,6 +257,10 @@ void gr_stub_clear()
 
 void gr_stub_flip()
 {
+	if (Stub_recording) {
+		++Stub_stats.frames;
+		stub_record("flip");
+	}
 }
 
 void gr_stub_fog_set(int  /*fog_mode*/, int  /*r*/, int  /*g*/, int  /*b*/, float  /*fog_near*/, float  /*fog_far*/)
@@ -118,17 +307,25 @@ void gr_stub_save_mouse_area(int  /*x*/, int  /*y*/, int  /*w*/, int  /*h*/)
 {
 }
 
-void gr_stub_update_buffer_data(int  /*handle*/, size_t  /*size*/, void*  /*data*/)
+void gr_stub_update_buffer_data(int handle, size_t size, void*  /*data*/)
 {
+	if (Stub_recording) {
+		stub_record_upload(handle, size);
+	}
 }
 
-void gr_stub_update_buffer_data_offset(int  /*handle*/, size_t  /*offset*/, size_t  /*size*/, void*  /*data*/)
+void gr_stub_update_buffer_data_offset(int handle, size_t  /*offset*/, size_t size, void*  /*data*/)
 {
+	if (Stub_recording) {
+		stub_record_upload(handle, size);
+	}
 }
 
-void gr_stub_update_transform_buffer(void*  /*data*/, size_t  /*size*/)
+void gr_stub_update_transform_buffer(void*  /*data*/, size_t size)
 {
-
+	if (Stub_recording) {
+		stub_record_upload(-1, size);
+	}
 }
 
 void gr_stub_set_clear_color(int  /*r*/, int  /*g*/, int  /*b*/)
@@ -139,9 +336,15 @@ void gr_stub_set_clip(int  /*x*/, int  /*y*/, int  /*w*/, int  /*h*/, int  /*res
 {
 }
 
-int gr_stub_set_cull(int  /*cull*/)
+int gr_stub_set_cull(int cull)
 {
-	return 0;
+	auto prev = Stub_cull;
+
+	if (Stub_recording) {
+		stub_record_state_value(Stub_cull, cull, "set_cull");
+	}
+
+	return prev;
 }
 
 int gr_stub_set_color_buffer(int  /*mode*/)
@@ -181,9 +384,15 @@ void gr_stub_zbuffer_clear(int  /*mode*/)
 {
 }
 
-int gr_stub_stencil_set(int  /*mode*/)
+int gr_stub_stencil_set(int mode)
 {
-	return 0;
+	auto prev = Stub_stencil_mode;
+
+	if (Stub_recording) {
+		stub_record_state_value(Stub_stencil_mode, mode, "stencil_set");
+	}
+
+	return prev;
 }
 
 void gr_stub_stencil_clear()
@@ -251,8 +460,11 @@ void gr_stub_set_line_width(float  /*width*/)
 {
 }
 
-void gr_stub_draw_sphere(material * /*material_def*/, float  /*rad*/)
+void gr_stub_draw_sphere(material *material_def, float  /*rad*/)
 {
+	if (Stub_recording) {
+		stub_record_draw(material_def, "sphere", 0, -1);
+	}
 }
 
 void gr_stub_clear_states()
@@ -311,50 +523,72 @@ void gr_stub_shadow_map_end()
 {
 }
 
-void gr_stub_render_shield_impact(shield_material * /*material_info*/, primitive_type  /*prim_type*/, vertex_layout * /*layout*/, int  /*buffer_handle*/, int  /*n_verts*/)
+void gr_stub_render_shield_impact(shield_material *material_info, primitive_type  /*prim_type*/, vertex_layout * /*layout*/, int buffer_handle, int n_verts)
 {
-
+	if (Stub_recording) {
+		stub_record_draw(material_info, "shield_impact", n_verts, buffer_handle);
+	}
 }
 
-void gr_stub_render_model(model_material*  /*material_info*/, indexed_vertex_source * /*vert_source*/, vertex_buffer*  /*bufferp*/, size_t  /*texi*/)
+void gr_stub_render_model(model_material* material_info, indexed_vertex_source *vert_source, vertex_buffer* bufferp, size_t texi)
 {
-
+	if (Stub_recording) {
+		stub_record_draw(material_info, "model", (int)bufferp->tex_buf[texi].n_verts, vert_source->Vbuffer_handle);
+	}
 }
 
-void gr_stub_render_primitives(material*  /*material_info*/, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int  /*n_verts*/, int  /*buffer_handle*/, size_t  /*buffer_offset*/)
+void gr_stub_render_primitives(material* material_info, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int n_verts, int buffer_handle, size_t  /*buffer_offset*/)
 {
-
+	if (Stub_recording) {
+		stub_record_draw(material_info, "primitives", n_verts, buffer_handle);
+	}
 }
 
-void gr_stub_render_primitives_particle(particle_material*  /*material_info*/, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int  /*n_verts*/, int  /*buffer_handle*/)
+void gr_stub_render_primitives_particle(particle_material* material_info, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int n_verts, int buffer_handle)
 {
-
+	if (Stub_recording) {
+		stub_record_draw(material_info, "particles", n_verts, buffer_handle);
+	}
 }
 
-void gr_stub_render_primitives_distortion(distortion_material*  /*material_info*/, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int  /*n_verts*/, int  /*buffer_handle*/)
+void gr_stub_render_primitives_distortion(distortion_material* material_info, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int n_verts, int buffer_handle)
 {
-
+	if (Stub_recording) {
+		stub_record_draw(material_info, "distortion", n_verts, buffer_handle);
+	}
 }
-void gr_stub_render_movie(movie_material*  /*material_info*/, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*n_verts*/, int  /*buffer*/, size_t /*buffer_offset*/)
+void gr_stub_render_movie(movie_material* material_info, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int n_verts, int buffer, size_t /*buffer_offset*/)
 {
+	if (Stub_recording) {
+		stub_record_draw(material_info, "movie", n_verts, buffer);
+	}
 }
 
-void gr_stub_render_nanovg(nanovg_material*  /*material_info*/,
+void gr_stub_render_nanovg(nanovg_material* material_info,
 							  primitive_type  /*prim_type*/,
 							  vertex_layout*  /*layout*/,
 							  int  /*offset*/,
-							  int  /*n_verts*/,
-							  int  /*buffer_handle*/) {
+							  int n_verts,
+							  int buffer_handle) {
+	if (Stub_recording) {
+		stub_record_draw(material_info, "nanovg", n_verts, buffer_handle);
+	}
 }
 
-void gr_stub_render_primitives_batched(batched_bitmap_material*  /*material_info*/, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int  /*n_verts*/, int  /*buffer_handle*/)
+void gr_stub_render_primitives_batched(batched_bitmap_material* material_info, primitive_type  /*prim_type*/, vertex_layout*  /*layout*/, int  /*offset*/, int n_verts, int buffer_handle)
 {
+	if (Stub_recording) {
+		stub_record_draw(material_info, "batched", n_verts, buffer_handle);
+	}
 }
 
-void gr_stub_render_rocket_primitives(interface_material* /*material_info*/, primitive_type /*prim_type*/,
-                                      vertex_layout* /*layout*/, int /*n_indices*/, int /*vertex_buffer*/,
+void gr_stub_render_rocket_primitives(interface_material* material_info, primitive_type /*prim_type*/,
+                                      vertex_layout* /*layout*/, int n_indices, int vertex_buffer,
                                       int /*index_buffer*/)
 {
+	if (Stub_recording) {
+		stub_record_draw(material_info, "rocket", n_indices, vertex_buffer);
+	}
 }
 
 bool gr_stub_is_capable(gr_capability  /*capability*/)
@@ -393,6 +627,11 @@ void gr_stub_delete_query_object(int  /*obj*/)
 
 bool gr_stub_init() 
 {
+	Stub_zbuffer_mode = 0;
+	Stub_cull = 0;
+	Stub_stencil_mode = 0;
+	Stub_bound_textures.fill(-1);
+
 	if (gr_screen.res != GR_640) {
 		gr_screen.res = GR_640;
 		gr_screen.max_w = 640;
@@ -537,7 +776,13 @@ bool gr_stub_init()
 	gr_screen.gf_use_viewport = [](os::Viewport*) {
 	};
 
-	gr_screen.gf_bind_uniform_buffer = [](uniform_block_type, size_t, size_t, int) {};
+	gr_screen.gf_bind_uniform_buffer = [](uniform_block_type block, size_t offset, size_t size, int buffer) {
+		if (Stub_recording) {
+			++Stub_stats.uniform_buffer_binds;
+			stub_record("bind_uniform_buffer block=%d buffer=%d offset=" SIZE_T_ARG " size=" SIZE_T_ARG,
+				static_cast<int>(block), buffer, offset, size);
+		}
+	};
 
 	return true;
 }
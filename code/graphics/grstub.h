@@ -1,3 +1,52 @@
+#pragma once
 
+#include "globalincs/pstypes.h"
 
 bool gr_stub_init();
+
+/**
+ * @brief Counters of the work the stub renderer has been asked to do
+ *
+ * Only updated while recording is enabled, see gr_stub_set_recording().
+ */
+struct gr_stub_stats {
+	uint64_t draw_calls = 0;
+	uint64_t vertices = 0;			//!< Number of vertices or indices submitted by all draw calls
+	uint64_t state_changes = 0;		//!< Changes of the shader, blend, depth, cull, fill or stencil state
+	uint64_t texture_binds = 0;		//!< Texture slots that changed between draw calls
+	uint64_t buffers_created = 0;
+	uint64_t buffer_uploads = 0;
+	uint64_t buffer_upload_bytes = 0;	//!< Includes uniform and transform buffer uploads
+	uint64_t uniform_buffers_created = 0;
+	uint64_t uniform_buffer_uploads = 0;
+	uint64_t uniform_buffer_binds = 0;
+	uint64_t frames = 0;
+};
+
+/**
+ * @brief Enables counting the calls made to the stub renderer
+ *
+ * While recording, the stub renderer also hands out valid buffer handles so code that skips rendering for invalid
+ * buffers takes the same path it would take with a real renderer. Recording should therefore be enabled before any
+ * buffers are created if the numbers are supposed to match a real renderer.
+ *
+ * @param enable @c true to count the calls
+ * @param record_commands @c true to also store a text line for every call which can be written out with
+ * gr_stub_write_commands() and compared against a previous run
+ */
+void gr_stub_set_recording(bool enable, bool record_commands = false);
+
+/**
+ * @brief Resets the counters and discards the recorded commands
+ */
+void gr_stub_reset_recording();
+
+const gr_stub_stats& gr_stub_get_stats();
+
+const SCP_vector<SCP_string>& gr_stub_get_commands();
+
+/**
+ * @brief Writes the recorded commands to a file, one command per line
+ * @return @c false if the file could not be written
+ */
+bool gr_stub_write_commands(const char* filename);
@@ -92,6 +92,7 @@ public:
 	material();
 
 	int get_shader_handle() const;
+	shader_type get_shader_type() const;
 	virtual uint get_shader_flags() const;
 
 	void set_texture_map(int tex_type, int texture_num);
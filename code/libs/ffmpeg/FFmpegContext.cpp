@@ -51,6 +51,50 @@ int64_t cfileSeek(void* ptr, int64_t offset, int whence) {
 	// cfseek returns the offset in the archive file (who thought that would be a good idea?)
 	return cftell(cfile);
 }
+
+int memoryRead(void* ptr, uint8_t* buf, int buf_size) {
+	auto mem = reinterpret_cast<libs::ffmpeg::FFmpegContext::MemoryFile*>(ptr);
+
+	auto numRead = std::min(mem->size - mem->pos, (size_t)buf_size);
+
+	if (numRead == 0) {
+		// End of file
+		return -1;
+	}
+
+	memcpy(buf, mem->data + mem->pos, numRead);
+	mem->pos += numRead;
+
+	return (int)numRead;
+}
+
+int64_t memorySeek(void* ptr, int64_t offset, int whence) {
+	auto mem = reinterpret_cast<libs::ffmpeg::FFmpegContext::MemoryFile*>(ptr);
+
+	int64_t newPos;
+	switch (whence & ~AVSEEK_FORCE) {
+		case SEEK_SET:
+			newPos = offset;
+			break;
+		case SEEK_CUR:
+			newPos = (int64_t)mem->pos + offset;
+			break;
+		case SEEK_END:
+			newPos = (int64_t)mem->size + offset;
+			break;
+		case AVSEEK_SIZE:
+			return (int64_t)mem->size;
+		default:
+			return -1;
+	}
+
+	if (newPos < 0 || newPos > (int64_t)mem->size) {
+		return -1;
+	}
+
+	mem->pos = (size_t)newPos;
+	return newPos;
+}
 }
 
 namespace libs {
@@ -60,6 +104,13 @@ FFmpegContext::FFmpegContext(CFILE* inFile) : m_ctx(nullptr), m_file(inFile) {
 	Assertion(inFile != nullptr, "Invalid file pointer passed!");
 }
 
+FFmpegContext::FFmpegContext(const uint8_t* data, size_t size) : m_ctx(nullptr), m_file(nullptr) {
+	Assertion(data != nullptr, "Invalid data pointer passed!");
+
+	m_memory.data = data;
+	m_memory.size = size;
+}
+
 FFmpegContext::~FFmpegContext() {
 	if (m_ctx) {
 		if (m_ctx->pb) {
@@ -85,9 +136,23 @@ std::unique_ptr<FFmpegContext> FFmpegContext::createContext(CFILE* mediaFile) {
 
 	std::unique_ptr<FFmpegContext> instance(new FFmpegContext(mediaFile));
 
-	instance->m_ctx = avformat_alloc_context();
+	instance->openInput(instance->m_file, cfileRead, cfileSeek);
 
-	if (!instance->m_ctx) {
+	return instance;
+}
+
+std::unique_ptr<FFmpegContext> FFmpegContext::createContext(const uint8_t* data, size_t size) {
+	std::unique_ptr<FFmpegContext> instance(new FFmpegContext(data, size));
+
+	instance->openInput(&instance->m_memory, memoryRead, memorySeek);
+
+	return instance;
+}
+
+void FFmpegContext::openInput(void* opaque, int (*read)(void*, uint8_t*, int), int64_t (*seek)(void*, int64_t, int)) {
+	m_ctx = avformat_alloc_context();
+
+	if (!m_ctx) {
 		throw FFmpegException("Failed to allocate context!");
 	}
 
@@ -97,16 +162,15 @@ std::unique_ptr<FFmpegContext> FFmpegContext::createContext(CFILE* mediaFile) {
 		throw FFmpegException("Failed to allocate IO buffer!");
 	}
 
-	auto ioContext =
-		avio_alloc_context(avioBuffer, AVIO_BUFFER_SIZE, 0, instance->m_file, cfileRead, nullptr, cfileSeek);
+	auto ioContext = avio_alloc_context(avioBuffer, AVIO_BUFFER_SIZE, 0, opaque, read, nullptr, seek);
 
 	if (!ioContext) {
 		throw FFmpegException("Failed to allocate IO context!");
 	}
 
-	instance->m_ctx->pb = ioContext;
+	m_ctx->pb = ioContext;
 
-	auto probe_ret = av_probe_input_buffer2(instance->m_ctx->pb, &instance->m_ctx->iformat, nullptr, nullptr, 0, 0);
+	auto probe_ret = av_probe_input_buffer2(m_ctx->pb, &m_ctx->iformat, nullptr, nullptr, 0, 0);
 	if (probe_ret < 0) {
 		char errorStr[1024];
 		av_strerror(probe_ret, errorStr, 1024);
@@ -114,9 +178,9 @@ std::unique_ptr<FFmpegContext> FFmpegContext::createContext(CFILE* mediaFile) {
 		throw FFmpegException(SCP_string("Could not open movie file! Error: ") + errorStr);
 	}
 
-	instance->m_ctx->flags |= AVFMT_FLAG_CUSTOM_IO;
+	m_ctx->flags |= AVFMT_FLAG_CUSTOM_IO;
 
-	auto ret = avformat_open_input(&instance->m_ctx, nullptr, instance->m_ctx->iformat, nullptr);
+	auto ret = avformat_open_input(&m_ctx, nullptr, m_ctx->iformat, nullptr);
 	if (ret < 0) {
 		char errorStr[1024];
 		av_strerror(ret, errorStr, 1024);
@@ -124,15 +188,13 @@ std::unique_ptr<FFmpegContext> FFmpegContext::createContext(CFILE* mediaFile) {
 		throw FFmpegException(SCP_string("Could not open movie file! Error: ") + errorStr);
 	}
 
-	ret = avformat_find_stream_info(instance->m_ctx, nullptr);
+	ret = avformat_find_stream_info(m_ctx, nullptr);
 	if (ret < 0) {
 		char errorStr[1024];
 		av_strerror(ret, errorStr, 1024);
 
 		throw FFmpegException(SCP_string("Failed to get stream information! Error: ") + errorStr);
 	}
-
-	return instance;
 }
 
 std::unique_ptr<FFmpegContext> FFmpegContext::createContext(const SCP_string& path, int dir_type) {
@@ -18,11 +18,25 @@ namespace ffmpeg {
  * createContex can be used for opening a specific file for FFmpeg decoding
  */
 class FFmpegContext {
+ public:
+	/**
+	 * @brief Read position in a media file that is held in memory
+	 */
+	struct MemoryFile {
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		size_t pos = 0;
+	};
+
  private:
 	AVFormatContext* m_ctx;
 	CFILE* m_file;
+	MemoryFile m_memory;
 
 	FFmpegContext(CFILE* file);
+	FFmpegContext(const uint8_t* data, size_t size);
+
+	void openInput(void* opaque, int (*read)(void*, uint8_t*, int), int64_t (*seek)(void*, int64_t, int));
  public:
 	~FFmpegContext();
 
@@ -34,6 +48,14 @@ class FFmpegContext {
 	static std::unique_ptr<FFmpegContext> createContext(CFILE* mediaFile);
 
 	static std::unique_ptr<FFmpegContext> createContext(const SCP_string& path, int dir_type);
+
+	/**
+	 * @brief Creates a context for a media file which is already in memory
+	 *
+	 * The data is not copied so it has to stay valid as long as the context exists. Since this does not touch the
+	 * file system it is safe to use from other threads.
+	 */
+	static std::unique_ptr<FFmpegContext> createContext(const uint8_t* data, size_t size);
 };
 
 }
@@ -109,45 +109,6 @@ extern vec3d Object_position;
  *
  * @param l Light to rotate
  */
-static void light_rotate(light * l)
-{
-	switch( l->type )	{
-	case Light_Type::Directional:
-		// Rotate the light direction into local coodinates
-		
-		vm_vec_rotate(&l->local_vec, &l->vec, &Light_matrix );
-		break;
-	
-	case Light_Type::Point:	{
-			vec3d tempv;
-			// Rotate the point into local coordinates
-	
-			vm_vec_sub(&tempv, &l->vec, &Light_base );
-			vm_vec_rotate(&l->local_vec, &tempv, &Light_matrix );
-		}
-		break;
-	
-	case Light_Type::Tube:{
-			vec3d tempv;
-
-			// Rotate the point into local coordinates
-			vm_vec_sub(&tempv, &l->vec, &Light_base );
-			vm_vec_rotate(&l->local_vec, &tempv, &Light_matrix );
-			
-			// Rotate the point into local coordinates
-			vm_vec_sub(&tempv, &l->vec2, &Light_base );
-			vm_vec_rotate(&l->local_vec2, &tempv, &Light_matrix );
-		}
-		break;
-
-	case Light_Type::Cone:
-			break;
-
-	default:
-		Int3();	// Invalid light type
-	}
-}
-
 void light_add_directional(const vec3d *dir, float intensity, float r, float g, float b, float spec_r, float spec_g, float spec_b, bool specular)
 {
 	if (Lighting_off) return;
@@ -305,12 +266,69 @@ void light_add_tube(const vec3d *p0, const vec3d *p1, float r1, float r2, float
 }
 
 
+/**
+ * Rotates all light directions and positions into the local coordinates given by Light_base and Light_matrix
+ *
+ * The vectors are gathered into two arrays first so they can be transformed with the batch functions.
+ */
 void light_rotate_all()
 {
+	static SCP_vector<vec3d> directions;
+	static SCP_vector<vec3d> positions;
+
 	if ( Lighting_off ) return;
-	
-	for (auto& l : Lights)
-		light_rotate(&l);
+
+	directions.clear();
+	positions.clear();
+
+	for (auto& l : Lights) {
+		switch( l.type )	{
+		case Light_Type::Directional:
+			directions.push_back(l.vec);
+			break;
+
+		case Light_Type::Point:
+			positions.push_back(l.vec);
+			break;
+
+		case Light_Type::Tube:
+			positions.push_back(l.vec);
+			positions.push_back(l.vec2);
+			break;
+
+		case Light_Type::Cone:
+			break;
+
+		default:
+			Int3();	// Invalid light type
+		}
+	}
+
+	vm_vec_rotate_batch(directions.data(), directions.data(), directions.size(), &Light_matrix);
+	vm_vec_sub_rotate_batch(positions.data(), positions.data(), positions.size(), &Light_base, &Light_matrix);
+
+	auto direction = directions.cbegin();
+	auto position = positions.cbegin();
+
+	for (auto& l : Lights) {
+		switch( l.type )	{
+		case Light_Type::Directional:
+			l.local_vec = *direction++;
+			break;
+
+		case Light_Type::Point:
+			l.local_vec = *position++;
+			break;
+
+		case Light_Type::Tube:
+			l.local_vec = *position++;
+			l.local_vec2 = *position++;
+			break;
+
+		default:
+			break;
+		}
+	}
 }
 
 /**
@@ -623,6 +641,16 @@ light_indexing_info scene_lights::bufferLights()
 	return light_info;
 }
 
+void scene_lights::clear()
+{
+	AllLights.clear();
+	StaticLightIndices.clear();
+	FilteredLights.clear();
+	BufferedLights.clear();
+
+	resetLightState();
+}
+
 void scene_lights::resetLightState()
 {
 	current_light_index = static_cast<size_t>(-1);
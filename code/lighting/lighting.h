@@ -82,6 +82,7 @@ public:
 	void setLightFilter(int objnum, const vec3d *pos, float rad);
 	bool setLights(const light_indexing_info *info);
 	void resetLightState();
+	void clear();		// Removes all lights but keeps the memory for the next scene
 	light_indexing_info bufferLights();
 };
 
@@ -292,6 +292,43 @@ vec3d *vm_vec_rotate(vec3d *dest, const vec3d *src, const matrix *m);
 // vm_vec_transpose() / vm_vec_rotate() technique.
 vec3d *vm_vec_unrotate(vec3d *dest, const vec3d *src, const matrix *m);
 
+// Batch versions of the functions above which process whole arrays of vectors at once.  They use SSE2 or AVX2 if
+// the cpu supports it and compute every element exactly like the single vector function would.
+// dest may be the same array as src but the two may not overlap in any other way.
+// These are implemented in vecmat_batch.cpp
+
+#define VM_BATCH_SCALAR		0
+#define VM_BATCH_SSE2		1
+#define VM_BATCH_AVX2		2
+
+// returns the instruction set (VM_BATCH_*) the batch functions currently use
+int vm_batch_get_instruction_set();
+
+// restricts the batch functions to the given instruction set (or the best one the cpu supports if that is lower)
+// returns the instruction set that is used from now on
+int vm_batch_set_instruction_set(int set);
+
+// dest[i] = vm_vec_rotate(src[i], m)
+void vm_vec_rotate_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m);
+
+// dest[i] = vm_vec_rotate(src[i] - origin, m)
+void vm_vec_sub_rotate_batch(vec3d *dest, const vec3d *src, size_t count, const vec3d *origin, const matrix *m);
+
+// dest[i] = vm_vec_unrotate(src[i], m)
+void vm_vec_unrotate_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m);
+
+// dest[i] = vm_vec_unrotate(src[i], m) + origin
+void vm_vec_unrotate_add_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m, const vec3d *origin);
+
+// normalizes every vector the same way vm_vec_normalize_safe does. if mags is not NULL the magnitudes are stored there
+void vm_vec_normalize_safe_batch(vec3d *v, size_t count, float *mags = NULL);
+
+// dest[i] = vm_vec_dist_squared(point, src[i])
+void vm_vec_dist_squared_batch(float *dest, const vec3d *point, const vec3d *src, size_t count);
+
+// vm_vec_scale_add2(dest[i], src[i], k)
+void vm_vec_scale_add2_batch(vec3d *dest, const vec3d *src, size_t count, float k);
+
 //transpose a matrix in place. returns ptr to matrix
 matrix *vm_transpose(matrix *m);
 
@@ -0,0 +1,566 @@
+#include "math/vecmat.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VM_BATCH_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef VM_BATCH_X86
+// GCC and clang only allow intrinsics of instruction sets that are enabled for the function they are used in. That
+// way the kernels are available even if the rest of the engine is compiled for an older cpu.
+#ifdef _MSC_VER
+#define VM_TARGET_SSE2
+#define VM_TARGET_AVX2
+#else
+#define VM_TARGET_SSE2 __attribute__((target("sse2")))
+#define VM_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+static_assert(sizeof(vec3d) == 3 * sizeof(float), "The batch functions require vec3d to be tightly packed!");
+
+namespace {
+
+int Batch_supported = -1;
+int Batch_instruction_set = -1;
+
+int detect_instruction_set()
+{
+#ifdef VM_BATCH_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	int max_leaf = info[0];
+
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+
+	// AVX registers may only be used if the operating system saves them on a context switch
+	if (max_leaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6) {
+		__cpuidex(info, 7, 0);
+		if (info[1] & (1 << 5)) {
+			return VM_BATCH_AVX2;
+		}
+	}
+	if (sse2) {
+		return VM_BATCH_SSE2;
+	}
+#else
+	// This also checks if the operating system supports the AVX registers
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return VM_BATCH_AVX2;
+	}
+	if (__builtin_cpu_supports("sse2")) {
+		return VM_BATCH_SSE2;
+	}
+#endif
+#endif
+
+	return VM_BATCH_SCALAR;
+}
+
+inline int instruction_set()
+{
+	if (Batch_instruction_set < 0) {
+		Batch_supported = detect_instruction_set();
+		Batch_instruction_set = Batch_supported;
+	}
+
+	return Batch_instruction_set;
+}
+
+// dest component i = (x * m[3i]) + (y * m[3i + 1]) + (z * m[3i + 2]) where x, y and z are optionally offset by -sub
+// and the result is optionally offset by add. That covers rotating and unrotating since only the order of the matrix
+// elements is different.
+struct transform_coefs {
+	float m[9];
+	vec3d sub;
+	vec3d add;
+};
+
+void rotate_coefs(transform_coefs& k, const matrix* m)
+{
+	for (int i = 0; i < 9; ++i) {
+		k.m[i] = m->a1d[i];
+	}
+}
+
+void unrotate_coefs(transform_coefs& k, const matrix* m)
+{
+	for (int row = 0; row < 3; ++row) {
+		for (int col = 0; col < 3; ++col) {
+			k.m[row * 3 + col] = m->a2d[col][row];
+		}
+	}
+}
+
+template<bool Sub, bool Add>
+void transform_scalar(vec3d* dest, const vec3d* src, size_t count, const transform_coefs& k)
+{
+	for (size_t i = 0; i < count; ++i) {
+		float x = src[i].xyz.x;
+		float y = src[i].xyz.y;
+		float z = src[i].xyz.z;
+
+		if (Sub) {
+			x -= k.sub.xyz.x;
+			y -= k.sub.xyz.y;
+			z -= k.sub.xyz.z;
+		}
+
+		float rx = (x * k.m[0]) + (y * k.m[1]) + (z * k.m[2]);
+		float ry = (x * k.m[3]) + (y * k.m[4]) + (z * k.m[5]);
+		float rz = (x * k.m[6]) + (y * k.m[7]) + (z * k.m[8]);
+
+		if (Add) {
+			rx += k.add.xyz.x;
+			ry += k.add.xyz.y;
+			rz += k.add.xyz.z;
+		}
+
+		dest[i].xyz.x = rx;
+		dest[i].xyz.y = ry;
+		dest[i].xyz.z = rz;
+	}
+}
+
+void normalize_scalar(vec3d* v, size_t count, float* mags)
+{
+	for (size_t i = 0; i < count; ++i) {
+		float m = vm_vec_normalize_safe(&v[i]);
+
+		if (mags != NULL) {
+			mags[i] = m;
+		}
+	}
+}
+
+void dist_squared_scalar(float* dest, const vec3d* point, const vec3d* src, size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dest[i] = vm_vec_dist_squared(point, &src[i]);
+	}
+}
+
+// Works on the single floats, the layout of the vectors does not matter for this
+void scale_add_scalar(float* dest, const float* src, size_t count, float k)
+{
+	for (size_t i = 0; i < count; ++i) {
+		dest[i] += src[i] * k;
+	}
+}
+
+#ifdef VM_BATCH_X86
+
+// The vectors stay in their x,y,z,x,y,z... layout in memory. Four of them fit into three registers which are shuffled
+// into one register per component and back. The AVX2 versions do the same thing in both 128 bit lanes.
+
+#define VM_SHUF(a, b, c, d) _MM_SHUFFLE(a, b, c, d)
+
+VM_TARGET_SSE2 inline void deinterleave_sse2(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z)
+{
+	x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, VM_SHUF(1, 1, 2, 2)), VM_SHUF(2, 0, 3, 0));
+	y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, VM_SHUF(0, 0, 1, 1)), _mm_shuffle_ps(b, c, VM_SHUF(2, 2, 3, 3)),
+		VM_SHUF(2, 0, 2, 0));
+	z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, VM_SHUF(1, 1, 2, 2)), c, VM_SHUF(3, 0, 2, 0));
+}
+
+VM_TARGET_SSE2 inline void interleave_sse2(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c)
+{
+	a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, VM_SHUF(0, 0, 0, 0)), _mm_shuffle_ps(z, x, VM_SHUF(1, 1, 0, 0)),
+		VM_SHUF(2, 0, 2, 0));
+	b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, VM_SHUF(1, 1, 1, 1)), _mm_shuffle_ps(x, y, VM_SHUF(2, 2, 2, 2)),
+		VM_SHUF(2, 0, 2, 0));
+	c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, VM_SHUF(3, 3, 2, 2)), _mm_shuffle_ps(y, z, VM_SHUF(3, 3, 3, 3)),
+		VM_SHUF(2, 0, 2, 0));
+}
+
+VM_TARGET_AVX2 inline void deinterleave_avx2(__m256 a, __m256 b, __m256 c, __m256& x, __m256& y, __m256& z)
+{
+	x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, VM_SHUF(1, 1, 2, 2)), VM_SHUF(2, 0, 3, 0));
+	y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, VM_SHUF(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, VM_SHUF(2, 2, 3, 3)),
+		VM_SHUF(2, 0, 2, 0));
+	z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, VM_SHUF(1, 1, 2, 2)), c, VM_SHUF(3, 0, 2, 0));
+}
+
+VM_TARGET_AVX2 inline void interleave_avx2(__m256 x, __m256 y, __m256 z, __m256& a, __m256& b, __m256& c)
+{
+	a = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, VM_SHUF(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, VM_SHUF(1, 1, 0, 0)),
+		VM_SHUF(2, 0, 2, 0));
+	b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, VM_SHUF(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, VM_SHUF(2, 2, 2, 2)),
+		VM_SHUF(2, 0, 2, 0));
+	c = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, VM_SHUF(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, VM_SHUF(3, 3, 3, 3)),
+		VM_SHUF(2, 0, 2, 0));
+}
+
+// Loads vectors 0-3 into the lower and vectors 4-7 into the upper lane
+VM_TARGET_AVX2 inline void load_avx2(const float* s, __m256& a, __m256& b, __m256& c)
+{
+	a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s)), _mm_loadu_ps(s + 12), 1);
+	b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 4)), _mm_loadu_ps(s + 16), 1);
+	c = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(s + 8)), _mm_loadu_ps(s + 20), 1);
+}
+
+VM_TARGET_AVX2 inline void store_avx2(float* d, __m256 a, __m256 b, __m256 c)
+{
+	_mm_storeu_ps(d, _mm256_castps256_ps128(a));
+	_mm_storeu_ps(d + 4, _mm256_castps256_ps128(b));
+	_mm_storeu_ps(d + 8, _mm256_castps256_ps128(c));
+	_mm_storeu_ps(d + 12, _mm256_extractf128_ps(a, 1));
+	_mm_storeu_ps(d + 16, _mm256_extractf128_ps(b, 1));
+	_mm_storeu_ps(d + 20, _mm256_extractf128_ps(c, 1));
+}
+
+// There is deliberately no FMA in here so every result is rounded exactly like the scalar code does it
+template<bool Sub, bool Add>
+VM_TARGET_SSE2 void transform_sse2(vec3d* dest, const vec3d* src, size_t count, const transform_coefs& k)
+{
+	const __m128 m0 = _mm_set1_ps(k.m[0]), m1 = _mm_set1_ps(k.m[1]), m2 = _mm_set1_ps(k.m[2]);
+	const __m128 m3 = _mm_set1_ps(k.m[3]), m4 = _mm_set1_ps(k.m[4]), m5 = _mm_set1_ps(k.m[5]);
+	const __m128 m6 = _mm_set1_ps(k.m[6]), m7 = _mm_set1_ps(k.m[7]), m8 = _mm_set1_ps(k.m[8]);
+	const __m128 sx = _mm_set1_ps(k.sub.xyz.x), sy = _mm_set1_ps(k.sub.xyz.y), sz = _mm_set1_ps(k.sub.xyz.z);
+	const __m128 ax = _mm_set1_ps(k.add.xyz.x), ay = _mm_set1_ps(k.add.xyz.y), az = _mm_set1_ps(k.add.xyz.z);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const float* s = src[i].a1d;
+		__m128 x, y, z;
+		deinterleave_sse2(_mm_loadu_ps(s), _mm_loadu_ps(s + 4), _mm_loadu_ps(s + 8), x, y, z);
+
+		if (Sub) {
+			x = _mm_sub_ps(x, sx);
+			y = _mm_sub_ps(y, sy);
+			z = _mm_sub_ps(z, sz);
+		}
+
+		__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m0), _mm_mul_ps(y, m1)), _mm_mul_ps(z, m2));
+		__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m3), _mm_mul_ps(y, m4)), _mm_mul_ps(z, m5));
+		__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m6), _mm_mul_ps(y, m7)), _mm_mul_ps(z, m8));
+
+		if (Add) {
+			rx = _mm_add_ps(rx, ax);
+			ry = _mm_add_ps(ry, ay);
+			rz = _mm_add_ps(rz, az);
+		}
+
+		__m128 a, b, c;
+		interleave_sse2(rx, ry, rz, a, b, c);
+
+		float* d = dest[i].a1d;
+		_mm_storeu_ps(d, a);
+		_mm_storeu_ps(d + 4, b);
+		_mm_storeu_ps(d + 8, c);
+	}
+
+	transform_scalar<Sub, Add>(dest + i, src + i, count - i, k);
+}
+
+template<bool Sub, bool Add>
+VM_TARGET_AVX2 void transform_avx2(vec3d* dest, const vec3d* src, size_t count, const transform_coefs& k)
+{
+	const __m256 m0 = _mm256_set1_ps(k.m[0]), m1 = _mm256_set1_ps(k.m[1]), m2 = _mm256_set1_ps(k.m[2]);
+	const __m256 m3 = _mm256_set1_ps(k.m[3]), m4 = _mm256_set1_ps(k.m[4]), m5 = _mm256_set1_ps(k.m[5]);
+	const __m256 m6 = _mm256_set1_ps(k.m[6]), m7 = _mm256_set1_ps(k.m[7]), m8 = _mm256_set1_ps(k.m[8]);
+	const __m256 sx = _mm256_set1_ps(k.sub.xyz.x), sy = _mm256_set1_ps(k.sub.xyz.y), sz = _mm256_set1_ps(k.sub.xyz.z);
+	const __m256 ax = _mm256_set1_ps(k.add.xyz.x), ay = _mm256_set1_ps(k.add.xyz.y), az = _mm256_set1_ps(k.add.xyz.z);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 a, b, c;
+		load_avx2(src[i].a1d, a, b, c);
+
+		__m256 x, y, z;
+		deinterleave_avx2(a, b, c, x, y, z);
+
+		if (Sub) {
+			x = _mm256_sub_ps(x, sx);
+			y = _mm256_sub_ps(y, sy);
+			z = _mm256_sub_ps(z, sz);
+		}
+
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m0), _mm256_mul_ps(y, m1)), _mm256_mul_ps(z, m2));
+		__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m3), _mm256_mul_ps(y, m4)), _mm256_mul_ps(z, m5));
+		__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m6), _mm256_mul_ps(y, m7)), _mm256_mul_ps(z, m8));
+
+		if (Add) {
+			rx = _mm256_add_ps(rx, ax);
+			ry = _mm256_add_ps(ry, ay);
+			rz = _mm256_add_ps(rz, az);
+		}
+
+		interleave_avx2(rx, ry, rz, a, b, c);
+		store_avx2(dest[i].a1d, a, b, c);
+	}
+
+	transform_sse2<Sub, Add>(dest + i, src + i, count - i, k);
+}
+
+VM_TARGET_SSE2 void normalize_sse2(vec3d* v, size_t count, float* mags)
+{
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		float* p = v[i].a1d;
+		__m128 x, y, z;
+		deinterleave_sse2(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x, y, z);
+
+		__m128 mag = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+
+		// Null vectors are rare enough that the whole group can take the slow path
+		if (_mm_movemask_ps(_mm_cmple_ps(mag, zero)) != 0) {
+			normalize_scalar(v + i, 4, mags != NULL ? mags + i : NULL);
+			continue;
+		}
+
+		mag = _mm_sqrt_ps(mag);
+		__m128 imag = _mm_div_ps(one, mag);
+
+		__m128 a, b, c;
+		interleave_sse2(_mm_mul_ps(x, imag), _mm_mul_ps(y, imag), _mm_mul_ps(z, imag), a, b, c);
+		_mm_storeu_ps(p, a);
+		_mm_storeu_ps(p + 4, b);
+		_mm_storeu_ps(p + 8, c);
+
+		if (mags != NULL) {
+			_mm_storeu_ps(mags + i, mag);
+		}
+	}
+
+	normalize_scalar(v + i, count - i, mags != NULL ? mags + i : NULL);
+}
+
+VM_TARGET_AVX2 void normalize_avx2(vec3d* v, size_t count, float* mags)
+{
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		float* p = v[i].a1d;
+		__m256 a, b, c;
+		load_avx2(p, a, b, c);
+
+		__m256 x, y, z;
+		deinterleave_avx2(a, b, c, x, y, z);
+
+		__m256 mag = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+
+		if (_mm256_movemask_ps(_mm256_cmp_ps(mag, zero, _CMP_LE_OQ)) != 0) {
+			normalize_scalar(v + i, 8, mags != NULL ? mags + i : NULL);
+			continue;
+		}
+
+		mag = _mm256_sqrt_ps(mag);
+		__m256 imag = _mm256_div_ps(one, mag);
+
+		interleave_avx2(_mm256_mul_ps(x, imag), _mm256_mul_ps(y, imag), _mm256_mul_ps(z, imag), a, b, c);
+		store_avx2(p, a, b, c);
+
+		if (mags != NULL) {
+			_mm256_storeu_ps(mags + i, mag);
+		}
+	}
+
+	normalize_sse2(v + i, count - i, mags != NULL ? mags + i : NULL);
+}
+
+VM_TARGET_SSE2 void dist_squared_sse2(float* dest, const vec3d* point, const vec3d* src, size_t count)
+{
+	const __m128 px = _mm_set1_ps(point->xyz.x), py = _mm_set1_ps(point->xyz.y), pz = _mm_set1_ps(point->xyz.z);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const float* s = src[i].a1d;
+		__m128 x, y, z;
+		deinterleave_sse2(_mm_loadu_ps(s), _mm_loadu_ps(s + 4), _mm_loadu_ps(s + 8), x, y, z);
+
+		__m128 dx = _mm_sub_ps(px, x);
+		__m128 dy = _mm_sub_ps(py, y);
+		__m128 dz = _mm_sub_ps(pz, z);
+
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+	}
+
+	dist_squared_scalar(dest + i, point, src + i, count - i);
+}
+
+VM_TARGET_AVX2 void dist_squared_avx2(float* dest, const vec3d* point, const vec3d* src, size_t count)
+{
+	const __m256 px = _mm256_set1_ps(point->xyz.x), py = _mm256_set1_ps(point->xyz.y), pz = _mm256_set1_ps(point->xyz.z);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 a, b, c;
+		load_avx2(src[i].a1d, a, b, c);
+
+		__m256 x, y, z;
+		deinterleave_avx2(a, b, c, x, y, z);
+
+		__m256 dx = _mm256_sub_ps(px, x);
+		__m256 dy = _mm256_sub_ps(py, y);
+		__m256 dz = _mm256_sub_ps(pz, z);
+
+		_mm256_storeu_ps(dest + i,
+			_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+	}
+
+	dist_squared_sse2(dest + i, point, src + i, count - i);
+}
+
+VM_TARGET_SSE2 void scale_add_sse2(float* dest, const float* src, size_t count, float k)
+{
+	const __m128 kk = _mm_set1_ps(k);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		_mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), _mm_mul_ps(_mm_loadu_ps(src + i), kk)));
+	}
+
+	scale_add_scalar(dest + i, src + i, count - i, k);
+}
+
+VM_TARGET_AVX2 void scale_add_avx2(float* dest, const float* src, size_t count, float k)
+{
+	const __m256 kk = _mm256_set1_ps(k);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		_mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), kk)));
+	}
+
+	scale_add_sse2(dest + i, src + i, count - i, k);
+}
+
+#undef VM_SHUF
+
+#endif // VM_BATCH_X86
+
+template<bool Sub, bool Add>
+void transform(vec3d* dest, const vec3d* src, size_t count, const transform_coefs& k)
+{
+	switch (instruction_set()) {
+#ifdef VM_BATCH_X86
+	case VM_BATCH_AVX2:
+		transform_avx2<Sub, Add>(dest, src, count, k);
+		break;
+	case VM_BATCH_SSE2:
+		transform_sse2<Sub, Add>(dest, src, count, k);
+		break;
+#endif
+	default:
+		transform_scalar<Sub, Add>(dest, src, count, k);
+		break;
+	}
+}
+
+}
+
+int vm_batch_get_instruction_set()
+{
+	return instruction_set();
+}
+
+int vm_batch_set_instruction_set(int set)
+{
+	instruction_set();
+
+	Batch_instruction_set = MIN(MAX(set, VM_BATCH_SCALAR), Batch_supported);
+
+	return Batch_instruction_set;
+}
+
+void vm_vec_rotate_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m)
+{
+	transform_coefs k{};
+	rotate_coefs(k, m);
+
+	transform<false, false>(dest, src, count, k);
+}
+
+void vm_vec_sub_rotate_batch(vec3d *dest, const vec3d *src, size_t count, const vec3d *origin, const matrix *m)
+{
+	transform_coefs k{};
+	rotate_coefs(k, m);
+	k.sub = *origin;
+
+	transform<true, false>(dest, src, count, k);
+}
+
+void vm_vec_unrotate_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m)
+{
+	transform_coefs k{};
+	unrotate_coefs(k, m);
+
+	transform<false, false>(dest, src, count, k);
+}
+
+void vm_vec_unrotate_add_batch(vec3d *dest, const vec3d *src, size_t count, const matrix *m, const vec3d *origin)
+{
+	transform_coefs k{};
+	unrotate_coefs(k, m);
+	k.add = *origin;
+
+	transform<false, true>(dest, src, count, k);
+}
+
+void vm_vec_normalize_safe_batch(vec3d *v, size_t count, float *mags)
+{
+	switch (instruction_set()) {
+#ifdef VM_BATCH_X86
+	case VM_BATCH_AVX2:
+		normalize_avx2(v, count, mags);
+		break;
+	case VM_BATCH_SSE2:
+		normalize_sse2(v, count, mags);
+		break;
+#endif
+	default:
+		normalize_scalar(v, count, mags);
+		break;
+	}
+}
+
+void vm_vec_dist_squared_batch(float *dest, const vec3d *point, const vec3d *src, size_t count)
+{
+	switch (instruction_set()) {
+#ifdef VM_BATCH_X86
+	case VM_BATCH_AVX2:
+		dist_squared_avx2(dest, point, src, count);
+		break;
+	case VM_BATCH_SSE2:
+		dist_squared_sse2(dest, point, src, count);
+		break;
+#endif
+	default:
+		dist_squared_scalar(dest, point, src, count);
+		break;
+	}
+}
+
+void vm_vec_scale_add2_batch(vec3d *dest, const vec3d *src, size_t count, float k)
+{
+	auto d = reinterpret_cast<float*>(dest);
+	auto s = reinterpret_cast<const float*>(src);
+
+	switch (instruction_set()) {
+#ifdef VM_BATCH_X86
+	case VM_BATCH_AVX2:
+		scale_add_avx2(d, s, count * 3, k);
+		break;
+	case VM_BATCH_SSE2:
+		scale_add_sse2(d, s, count * 3, k);
+		break;
+#endif
+	default:
+		scale_add_scalar(d, s, count * 3, k);
+		break;
+	}
+}
@@ -32,6 +32,7 @@
 #include "network/stand_gui.h"
 #include "parse/parselo.h"
 #include "parse/sexp.h"
+#include "parse/sexp/sexp_compiler.h"
 #include "playerman/player.h"
 #include "tracing/tracing.h"
 #include "ui/ui.h"
@@ -371,6 +372,8 @@ void mission_init_goals()
 		Mission_goals[i].satisfied = GOAL_INCOMPLETE;
 		Mission_goals[i].flags = 0;
 		Mission_goals[i].team = 0;
+		Mission_goals[i].dependency_mask = -1;
+		Mission_goals[i].dependency_serial = -1;
 	}
 
 	Num_mission_events = 0;
@@ -382,6 +385,10 @@ void mission_init_goals()
 		Mission_events[i].born_on_date = 0;
 		Mission_events[i].team = -1;
 		Mission_events[i].mission_log_flags = 0;
+		Mission_events[i].dependency_mask = -1;
+		Mission_events[i].dependency_serial = -1;
+		Mission_events[i].cached_directive_count = 0;
+		Mission_events[i].cached_useful_number = 0;
 	}
 
 	Mission_goal_timestamp = timestamp(GOAL_TIMESTAMP);
@@ -774,6 +781,7 @@ void mission_goal_status_change( int goal_num, int new_status)
 
 	type = Mission_goals[goal_num].type & GOAL_TYPE_MASK;
 	Mission_goals[goal_num].satisfied = new_status;
+	sexp_dependency_mark_changed(SEXP_DEP_EVENTS);
 	if ( new_status == GOAL_FAILED ) {
 		// don't display bonus goal failure
 		if ( type != BONUS_GOAL ) {
@@ -879,6 +887,32 @@ void mission_event_unset_directive_special(int event)
 	Mission_directive_special_timestamp = timestamp(-1);
 }
 
+// Returns true if the formula was false when last evaluated and nothing it reads has changed since, so that
+// evaluating it again would give the same result
+static bool mission_formula_is_clean(int dependency_mask, int dependency_serial)
+{
+	return (dependency_serial >= 0) && !sexp_dependency_changed_since(dependency_mask, dependency_serial);
+}
+
+// Evaluates a goal or event formula, recording which serial the result is valid for
+static int mission_eval_formula(int formula, int *dependency_mask, int *dependency_serial)
+{
+	int serial = sexp_dependency_serial();
+
+	Sexp_dependency_time_pending = false;
+	int result = sexp::eval_formula(formula);
+
+	if (*dependency_mask == -1) {
+		*dependency_mask = sexp_get_dependency_mask(formula);
+	}
+
+	// a formula which is just waiting for the clock to run out has to be looked at every time
+	*dependency_serial = Sexp_dependency_time_pending ? -1 : serial;
+	Sexp_dependency_time_pending = false;
+
+	return result;
+}
+
 // function which evaluates and processes the given event
 void mission_process_event( int event )
 {
@@ -886,6 +920,7 @@ void mission_process_event( int event )
 	int store_formula = Mission_events[event].formula;
 	int store_result = Mission_events[event].result;
 	int store_count = Mission_events[event].count;
+	int store_timestamp = Mission_events[event].timestamp;
 
 	int result, sindex;
 	bool bump_timestamp = false; 
@@ -929,7 +964,17 @@ void mission_process_event( int event )
 			Current_event_log_variable_buffer = &Mission_events[event].event_log_variable_buffer;
 			Current_event_log_argument_buffer = &Mission_events[event].event_log_argument_buffer;
 		}
-		result = eval_sexp(sindex);
+
+		// if the event was false and nothing it depends on has changed, it's still false.  Events which log
+		// their evaluation are always evaluated so the log stays complete.
+		if (!Log_event && !result && mission_formula_is_clean(Mission_events[event].dependency_mask, Mission_events[event].dependency_serial)) {
+			Directive_count = Mission_events[event].cached_directive_count;
+			Sexp_useful_number = Mission_events[event].cached_useful_number;
+		} else {
+			result = mission_eval_formula(sindex, &Mission_events[event].dependency_mask, &Mission_events[event].dependency_serial);
+			Mission_events[event].cached_directive_count = Directive_count;
+			Mission_events[event].cached_useful_number = Sexp_useful_number;
+		}
 
 		// if the directive count is a special value, deal with that first.  Mark the event as a special
 		// event, and unmark it when the directive is true again.
@@ -968,6 +1013,7 @@ void mission_process_event( int event )
 		// _argv[-1] - repeat_count of -1 would mean repeat indefinitely, so set to 0 instead.
 		Mission_events[event].repeat_count = 0;
 		Mission_events[event].formula = -1;
+		sexp_dependency_mark_changed(SEXP_DEP_EVENTS);
 		return;
 	}
 
@@ -1016,6 +1062,11 @@ void mission_process_event( int event )
 		}
 	}
 
+	// let any formulas which look at this event know about it
+	if ((store_formula != Mission_events[event].formula) || (store_result != Mission_events[event].result) || (store_timestamp != Mission_events[event].timestamp)) {
+		sexp_dependency_mark_changed(SEXP_DEP_EVENTS);
+	}
+
 	// see if anything has changed	
 	if(MULTIPLAYER_MASTER && ((store_flags != Mission_events[event].flags) || (store_formula != Mission_events[event].formula) || (store_result != Mission_events[event].result) || (store_count != Mission_events[event].count)) ){
 		send_event_update_packet(event);
@@ -1064,7 +1115,12 @@ void mission_eval_goals()
 		}
 
 		if (Mission_goals[i].satisfied == GOAL_INCOMPLETE) {
-			result = eval_sexp(Mission_goals[i].formula);
+			// an incomplete goal was false last time; skip it if nothing it reads has changed
+			if (mission_formula_is_clean(Mission_goals[i].dependency_mask, Mission_goals[i].dependency_serial)) {
+				continue;
+			}
+
+			result = mission_eval_formula(Mission_goals[i].formula, &Mission_goals[i].dependency_mask, &Mission_goals[i].dependency_serial);
 			if ( Sexp_nodes[Mission_goals[i].formula].value == SEXP_KNOWN_FALSE ) {
 				mission_goal_status_change( i, GOAL_FAILED );
 
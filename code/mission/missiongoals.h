@@ -61,6 +61,10 @@ typedef struct mission_goal {
 	int	score;							// score for this goal
 	int	flags;							// MGF_
 	int	team;								// which team is this objective for.
+
+	// incremental evaluation
+	int	dependency_mask;				// SEXP_DEP_* categories read by the formula, or -1 if not computed yet
+	int	dependency_serial;				// dependency serial when last evaluated, or -1 if it must be evaluated
 } mission_goal;
 
 extern mission_goal Mission_goals[MAX_GOALS];	// structure for the goals of this mission
@@ -124,6 +128,12 @@ typedef struct mission_event {
 	SCP_vector<SCP_string> backup_log_buffer;
 	int	previous_result;		// result of previous evaluation of event
 
+	// incremental evaluation
+	int	dependency_mask;		// SEXP_DEP_* categories read by the formula, or -1 if not computed yet
+	int	dependency_serial;		// dependency serial when last evaluated, or -1 if it must be evaluated
+	int	cached_directive_count;	// Directive_count and Sexp_useful_number as left by the last evaluation
+	int	cached_useful_number;
+
 } mission_event;
 
 extern int Num_mission_events;
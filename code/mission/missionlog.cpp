@@ -21,6 +21,7 @@
 #include "network/multimsgs.h"
 #include "network/multiutil.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
 #include "playerman/player.h"
 #include "ship/ship.h"
 
@@ -188,6 +189,9 @@ void mission_log_add_entry(LogType type, const char *pname, const char *sname, i
 
 	last_entry_save = last_entry;
 
+	// anything which reads the log may now evaluate differently
+	sexp_dependency_mark_changed(SEXP_DEP_MISSION_LOG);
+
 	// mark any entries as obsolete.  Part of the pruning is done based on the type (and name) passed
 	// for a new entry
 	mission_log_obsolete_entries(type, pname);
@@ -395,6 +399,8 @@ void mission_log_add_entry_multi( LogType type, const char *pname, const char *s
 	Assert ( Game_mode & GM_MULTIPLAYER );
 	Assert ( !(Net_player->flags & NETINFO_FLAG_AM_MASTER) );
 
+	sexp_dependency_mark_changed(SEXP_DEP_MISSION_LOG);
+
 	// mark any entries as obsolete.  Part of the pruning is done based on the type (and name) passed
 	// for a new entry
 	mission_log_obsolete_entries(type, pname);
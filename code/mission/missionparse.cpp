@@ -60,6 +60,8 @@
 #include "object/waypoint.h"
 #include "parse/generic_log.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
+#include "parse/sexp/sexp_compiler.h"
 #include "scripting/scripting.h"
 #include "playerman/player.h"
 #include "popup/popup.h"
@@ -1887,6 +1889,7 @@ int parse_create_object_sub(p_object *p_objp)
 
 	// Goober5000 - make the parse object aware of what it was created as
 	p_objp->created_object = &Objects[objnum];
+	sexp_dependency_mark_changed(SEXP_DEP_MISSION_LOG);
 
 	// Goober5000 - if this object is being created because he's docked to something,
 	// and he's in a wing, then mark the wing as having arrived
@@ -4049,6 +4052,7 @@ int parse_wing_create_ships( wing *wingp, int num_to_create, int force, int spec
 
 				// set the gone flag
                 wingp->flags.set(Ship::Wing_Flags::Gone);
+				sexp_dependency_mark_changed(SEXP_DEP_MISSION_LOG);
 
 				// mark the number of waves and number of ships destroyed equal to the last wave and the number
 				// of ships yet to arrive
@@ -5864,6 +5868,16 @@ bool post_process_mission()
 		}
 	}
 
+	// now that the formulas are known to be valid, flatten the goal and event formulas so they don't have to
+	// be walked as trees every time they are evaluated
+	if (!Fred_running) {
+		for (i = 0; i < Num_goals; i++)
+			sexp::compile_formula(Mission_goals[i].formula);
+
+		for (i = 0; i < Num_mission_events; i++)
+			sexp::compile_formula(Mission_events[i].formula);
+	}
+
 	// multiplayer missions are handled just before mission start
 	if (!(Game_mode & GM_MULTIPLAYER) ){	
 		ai_post_process_mission();
@@ -796,6 +796,10 @@ void model_instance_free_all();
 // Loads a model from disk and returns the model number it loaded into.
 int model_load(const char *filename, int n_subsystems, model_subsystem *subsystems, int ferror = 1, int duplicate = 0);
 
+// Reads only the bounding box of a model from its file without loading the model. Returns false if the file could not be
+// opened or has no valid header.
+bool model_read_bounding_box(const char *filename, vec3d *mins, vec3d *maxs);
+
 int model_create_instance(bool is_ship, int model_num);
 void model_delete_instance(int model_instance_num);
 
@@ -1364,35 +1364,52 @@ void model_collide_preprocess_subobj(vec3d *pos, matrix *orient, polymodel *pm,
 	smi->mc_base = *pos;
 	smi->mc_orient = *orient;
 
-	int i = pm->submodel[subobj_num].first_child;
+	// The positions of the children are transformed in batches
+	const int chunk_size = 16;
+	vec3d child_pos[chunk_size];
+	int children[chunk_size];
 
-	while ( i >= 0 ) {
-		angles angs = pmi->submodel[i].angs;
-		bsp_info * csm = &pm->submodel[i];
+	int child = pm->submodel[subobj_num].first_child;
 
-		matrix tm = IDENTITY_MATRIX;
+	while ( child >= 0 ) {
+		int num_children = 0;
 
-		vm_vec_unrotate(pos, &csm->offset, &smi->mc_orient );
-		vm_vec_add2(pos, &smi->mc_base);
+		while ( child >= 0 && num_children < chunk_size ) {
+			children[num_children] = child;
+			child_pos[num_children] = pm->submodel[child].offset;
+			num_children++;
 
-		if( vm_matrix_same(&tm, &csm->orientation)) {
-			// if submodel orientation matrix is identity matrix then don't bother with matrix ops
-			vm_angles_2_matrix(&tm, &angs);
-		} else {
-			matrix rotation_matrix = csm->orientation;
-			vm_rotate_matrix_by_angles(&rotation_matrix, &angs);
+			child = pm->submodel[child].next_sibling;
+		}
 
-			matrix inv_orientation;
-			vm_copy_transpose(&inv_orientation, &csm->orientation);
+		vm_vec_unrotate_add_batch(child_pos, child_pos, (size_t)num_children, &smi->mc_orient, &smi->mc_base);
 
-			vm_matrix_x_matrix(&tm, &rotation_matrix, &inv_orientation);
-		}
+		for (int j = 0; j < num_children; j++) {
+			int i = children[j];
+			angles angs = pmi->submodel[i].angs;
+			bsp_info * csm = &pm->submodel[i];
 
-		vm_matrix_x_matrix(orient, &smi->mc_orient, &tm);
+			matrix tm = IDENTITY_MATRIX;
 
-		model_collide_preprocess_subobj(pos, orient, pm, pmi, i);
+			*pos = child_pos[j];
 
-		i = csm->next_sibling;
+			if( vm_matrix_same(&tm, &csm->orientation)) {
+				// if submodel orientation matrix is identity matrix then don't bother with matrix ops
+				vm_angles_2_matrix(&tm, &angs);
+			} else {
+				matrix rotation_matrix = csm->orientation;
+				vm_rotate_matrix_by_angles(&rotation_matrix, &angs);
+
+				matrix inv_orientation;
+				vm_copy_transpose(&inv_orientation, &csm->orientation);
+
+				vm_matrix_x_matrix(&tm, &rotation_matrix, &inv_orientation);
+			}
+
+			vm_matrix_x_matrix(orient, &smi->mc_orient, &tm);
+
+			model_collide_preprocess_subobj(pos, orient, pm, pmi, i);
+		}
 	}
 }
 
@@ -832,9 +832,11 @@ int interp_box_offscreen( vec3d *min, vec3d *max )
 	ubyte or_codes = 0xff;
 	int i;
 
+	vertex pts[8];
+	g3_rotate_vertices( pts, v, 8 );
+
 	for (i=0; i<8; i++ )	{
-		vertex tmp;
-		ubyte codes=g3_rotate_vertex( &tmp, &v[i] );
+		ubyte codes = pts[i].codes;
 
 		or_codes |= codes;
 		and_codes &= codes;
@@ -1038,6 +1038,49 @@ void model_calc_bound_box( vec3d *box, vec3d *big_mn, vec3d *big_mx)
 }
 
 
+bool model_read_bounding_box(const char *filename, vec3d *mins, vec3d *maxs)
+{
+	CFILE *fp = cfopen(filename, "rb");
+
+	if (!fp) {
+		return false;
+	}
+
+	bool found = false;
+
+	if (cfread_int(fp) == POF_HEADER_ID) {
+		int version = cfread_int(fp);
+
+		if (version >= PM_COMPATIBLE_VERSION && (version / 100) <= PM_OBJFILE_MAJOR_VERSION) {
+			// The header is normally the first chunk but that is not guaranteed
+			while (!cfeof(fp)) {
+				int id = cfread_int(fp);
+				int len = cfread_int(fp);
+
+				if (id == ID_OHDR) {
+					// Radius, flags and number of submodels
+					cfseek(fp, 3 * sizeof(int), CF_SEEK_CUR);
+
+					cfread_vector(mins, fp);
+					cfread_vector(maxs, fp);
+					maybe_swap_mins_maxs(mins, maxs);
+
+					found = true;
+					break;
+				}
+
+				if (len <= 0 || cfseek(fp, len, CF_SEEK_CUR) != 0) {
+					break;
+				}
+			}
+		}
+	}
+
+	cfclose(fp);
+
+	return found;
+}
+
 void parse_triggers(int &n_trig, queued_animation **triggers, char *props);
 
 
@@ -31,6 +31,7 @@
 #include "ship/ship.h"
 #include "ship/shipfx.h"
 #include "tracing/tracing.h"
+#include "utils/boost/hash_combine.h"
 #include "weapon/weapon.h"
 
 extern int Model_texturing;
@@ -420,8 +421,17 @@ void model_draw_list::reset()
 	Render_elements.clear();
 	Render_keys.clear();
 
+	Shader_flag_ids.clear();
+	Texture_set_ids.clear();
+
 	Transformations.clear();
 
+	Arcs.clear();
+	Insignias.clear();
+	Outlines.clear();
+
+	Scene_light_handler.clear();
+
 	Current_scale.xyz.x = 1.0f;
 	Current_scale.xyz.y = 1.0f;
 	Current_scale.xyz.z = 1.0f;
@@ -434,10 +444,71 @@ void model_draw_list::reset()
 	Render_initialized = false;
 }
 
+size_t texture_set_hash::operator()(const texture_set& textures) const
+{
+	size_t seed = 0;
+	for (auto texture : textures) {
+		boost::hash_combine(seed, texture);
+	}
+	return seed;
+}
+
+namespace {
+// Bit layout of the draw sort keys, from the most to the least significant bits. The fields are ordered by how
+// expensive it is to change that state.
+const int SORT_KEY_SHADER_BITS = 8;
+const int SORT_KEY_VERTEX_BUFFER_BITS = 12;
+const int SORT_KEY_INDEX_BUFFER_BITS = 12;
+const int SORT_KEY_TEXTURE_SET_BITS = 16;
+const int SORT_KEY_LIGHTS_BITS = 16;
+
+static_assert(SORT_KEY_SHADER_BITS + SORT_KEY_VERTEX_BUFFER_BITS + SORT_KEY_INDEX_BUFFER_BITS +
+				  SORT_KEY_TEXTURE_SET_BITS + SORT_KEY_LIGHTS_BITS == 64,
+			  "Sort key fields must fill 64 bits!");
+
+// Values that do not fit into their field are truncated. That only makes the grouping less effective since the draw
+// order is only used for avoiding state changes.
+void append_sort_key_field(uint64_t& key, uint64_t value, int bits)
+{
+	key = (key << bits) | (value & ((UINT64_C(1) << bits) - 1));
+}
+}
+
+uint64_t model_draw_list::get_sort_key(const queued_buffer_draw& draw)
+{
+	auto shader_id = Shader_flag_ids.emplace(draw.sdr_flags, (uint64_t)Shader_flag_ids.size()).first->second;
+
+	texture_set textures;
+	for (int i = 0; i < TM_NUM_TYPES; ++i) {
+		textures[i] = draw.render_material.get_texture_map(i);
+	}
+	auto texture_set_id = Texture_set_ids.emplace(textures, (uint64_t)Texture_set_ids.size()).first->second;
+
+	uint64_t key = 0;
+	append_sort_key_field(key, shader_id, SORT_KEY_SHADER_BITS);
+	append_sort_key_field(key, (uint64_t)(draw.vert_src->Vbuffer_handle + 1), SORT_KEY_VERTEX_BUFFER_BITS);
+	append_sort_key_field(key, (uint64_t)(draw.vert_src->Ibuffer_handle + 1), SORT_KEY_INDEX_BUFFER_BITS);
+	append_sort_key_field(key, texture_set_id, SORT_KEY_TEXTURE_SET_BITS);
+	append_sort_key_field(key, (uint64_t)draw.lights.index_start, SORT_KEY_LIGHTS_BITS);
+
+	return key;
+}
+
 void model_draw_list::sort_draws()
 {
-	std::sort(Render_keys.begin(), Render_keys.end(),
-			  [this](const int a, const int b) { return model_draw_list::sort_draw_pair(this, a, b); });
+	TRACE_SCOPE(tracing::SortModelDraws);
+
+	Sort_entries.resize(Render_keys.size());
+	for (size_t i = 0; i < Render_keys.size(); ++i) {
+		Sort_entries[i].key = Render_elements[Render_keys[i]].sort_key;
+		Sort_entries[i].index = Render_keys[i];
+	}
+
+	util::radix_sort(Sort_entries, Sort_scratch);
+
+	for (size_t i = 0; i < Sort_entries.size(); ++i) {
+		Render_keys[i] = Sort_entries[i].index;
+	}
 }
 
 void model_draw_list::start_model_batch(int n_models)
@@ -531,6 +602,7 @@ void model_draw_list::add_buffer_draw(model_material *render_material, indexed_v
 	draw_data.texi = texi;
 	draw_data.flags = tmap_flags;
 	draw_data.lights = Current_lights_set;
+	draw_data.sort_key = get_sort_key(draw_data);
 
 	Render_elements.push_back(draw_data);
 	Render_keys.push_back((int) (Render_elements.size() - 1));
@@ -740,57 +812,6 @@ void model_draw_list::render_outline(outline_draw &outline_info)
 	g3_done_instance(true);
 }
 
-bool model_draw_list::sort_draw_pair(model_draw_list* target, const int a, const int b)
-{
-	queued_buffer_draw *draw_call_a = &target->Render_elements[a];
-	queued_buffer_draw *draw_call_b = &target->Render_elements[b];
-
-	if ( draw_call_a->sdr_flags != draw_call_b->sdr_flags ) {
-		return draw_call_a->sdr_flags < draw_call_b->sdr_flags;
-	}
-
-	if ( draw_call_a->vert_src->Vbuffer_handle != draw_call_b->vert_src->Vbuffer_handle ) {
-		return draw_call_a->vert_src->Vbuffer_handle < draw_call_b->vert_src->Vbuffer_handle;
-	}
-
-	if ( draw_call_a->vert_src->Ibuffer_handle != draw_call_b->vert_src->Ibuffer_handle ) {
-		return draw_call_a->vert_src->Ibuffer_handle < draw_call_b->vert_src->Ibuffer_handle;
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_BASE_TYPE) != draw_call_b->render_material.get_texture_map(TM_BASE_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_BASE_TYPE) < draw_call_b->render_material.get_texture_map(TM_BASE_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_SPECULAR_TYPE) != draw_call_b->render_material.get_texture_map(TM_SPECULAR_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_SPECULAR_TYPE) < draw_call_b->render_material.get_texture_map(TM_SPECULAR_TYPE);
-	}
-	
-	if ( draw_call_a->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) != draw_call_b->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE) < draw_call_b->render_material.get_texture_map(TM_SPEC_GLOSS_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_GLOW_TYPE) != draw_call_b->render_material.get_texture_map(TM_GLOW_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_GLOW_TYPE) < draw_call_b->render_material.get_texture_map(TM_GLOW_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_NORMAL_TYPE) != draw_call_b->render_material.get_texture_map(TM_NORMAL_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_NORMAL_TYPE) < draw_call_b->render_material.get_texture_map(TM_NORMAL_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_HEIGHT_TYPE) != draw_call_b->render_material.get_texture_map(TM_HEIGHT_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_HEIGHT_TYPE) < draw_call_b->render_material.get_texture_map(TM_HEIGHT_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_AMBIENT_TYPE) != draw_call_b->render_material.get_texture_map(TM_AMBIENT_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_AMBIENT_TYPE) < draw_call_b->render_material.get_texture_map(TM_AMBIENT_TYPE);
-	}
-
-	if ( draw_call_a->render_material.get_texture_map(TM_MISC_TYPE) != draw_call_b->render_material.get_texture_map(TM_MISC_TYPE) ) {
-		return draw_call_a->render_material.get_texture_map(TM_MISC_TYPE) < draw_call_b->render_material.get_texture_map(TM_MISC_TYPE);
-	}
-
-	return draw_call_a->lights.index_start < draw_call_b->lights.index_start;
-}
 void model_draw_list::build_uniform_buffer() {
 	GR_DEBUG_SCOPE("Build model uniform buffer");
 
@@ -16,6 +16,9 @@
 #include "model/model.h"
 #include "mission/missionparse.h"
 #include "graphics/util/UniformBuffer.h"
+#include "utils/RadixSort.h"
+
+#include <array>
 
 extern SCP_vector<light> Lights;
 extern int Num_lights;
@@ -178,6 +181,14 @@ struct insignia_draw_data
 	vec3d clip_position;
 };
 
+// The texture maps of a draw, used for grouping draws with the same textures
+typedef std::array<int, TM_NUM_TYPES> texture_set;
+
+struct texture_set_hash
+{
+	size_t operator()(const texture_set& textures) const;
+};
+
 struct queued_buffer_draw
 {
 	size_t transform_buffer_offset = 0;
@@ -196,6 +207,9 @@ struct queued_buffer_draw
 
 	light_indexing_info lights;
 
+	// Packed render state used for sorting the draws, see model_draw_list::get_sort_key()
+	uint64_t sort_key = 0;
+
 	queued_buffer_draw()
 	{
 	}
@@ -249,6 +263,13 @@ class model_draw_list
 	SCP_vector<queued_buffer_draw> Render_elements;
 	SCP_vector<int> Render_keys;
 
+	// Shader flags and texture sets are mapped to small ids so that they fit into the sort keys
+	SCP_unordered_map<int, uint64_t> Shader_flag_ids;
+	SCP_unordered_map<texture_set, uint64_t, texture_set_hash> Texture_set_ids;
+
+	SCP_vector<util::RadixSortEntry> Sort_entries;
+	SCP_vector<util::RadixSortEntry> Sort_scratch;
+
 	SCP_vector<arc_effect> Arcs;
 	SCP_vector<insignia_draw_data> Insignias;
 	SCP_vector<outline_draw> Outlines;
@@ -257,7 +278,7 @@ class model_draw_list
 	
 	bool Render_initialized = false; //!< A flag for checking if init_render has been called before a render_all call
 	
-	static bool sort_draw_pair(model_draw_list* target, const int a, const int b);
+	uint64_t get_sort_key(const queued_buffer_draw& draw);
 	void sort_draws();
 
 	void build_uniform_buffer();
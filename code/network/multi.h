@@ -423,6 +423,8 @@ typedef struct net_player_server_info {
 	// rate limiting information
 	int				rate_stamp;							// rate limiting timestamp
 	int				rate_bytes;							// bytes sent this "second"
+	uint				oo_packets_sent;					// object update packets sent since the rate info was reset
+	uint				oo_bytes_sent;						// object update bytes sent since the rate info was reset
 
 	// firing info (1<<0) for primary fire, (1<<1) for secondary fired, (1<<2) for countermeasure fired, (1<<3) for afterburner on
 	// basically, we set these bits if necessary between control info sends from the client. once sent, these values are
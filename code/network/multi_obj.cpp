@@ -1301,6 +1301,8 @@ void multi_oo_process_all(net_player *pl)
 									
 			multi_io_send(pl, data, packet_size);
 			pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+			pl->s_info.oo_packets_sent++;
+			pl->s_info.oo_bytes_sent += packet_size + UDP_HEADER_SIZE;
 
 			packet_size = 0;
 			BUILD_HEADER(OBJECT_UPDATE);			
@@ -1328,6 +1330,8 @@ void multi_oo_process_all(net_player *pl)
 								
 		multi_io_send(pl, data, packet_size);
 		pl->s_info.rate_bytes += packet_size + UDP_HEADER_SIZE;
+		pl->s_info.oo_packets_sent++;
+		pl->s_info.oo_bytes_sent += packet_size + UDP_HEADER_SIZE;
 	}
 }
 
@@ -1697,6 +1701,8 @@ void multi_oo_rate_init(net_player *pl)
 	// reinitialize his datarate timestamp
 	pl->s_info.rate_stamp = -1;
 	pl->s_info.rate_bytes = 0;
+	pl->s_info.oo_packets_sent = 0;
+	pl->s_info.oo_bytes_sent = 0;
 }
 
 // if the given net-player has exceeded his datarate limit
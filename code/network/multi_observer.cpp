@@ -80,6 +80,8 @@ int multi_obs_create_player(int player_num,char *name,net_addr *addr,player *pl)
 	// nil his data rate timestamp stuff
 	Net_players[player_num].s_info.rate_stamp = -1;
 	Net_players[player_num].s_info.rate_bytes = 0;
+	Net_players[player_num].s_info.oo_packets_sent = 0;
+	Net_players[player_num].s_info.oo_bytes_sent = 0;
 
 	// nil packet buffer stuff
 	Net_players[player_num].s_info.unreliable_buffer_size = 0;
@@ -210,4 +210,33 @@ void multi_rate_display(int np_index, int x, int y)
 	}
 }
 
+// get the alltime bytes and the average bytes/second of all types for the given player, returns 0 if there is no data
+int multi_rate_get_totals(int np_index, int *total_bytes, float *avg_second)
+{
+	int idx;
+	mr_info *m;
+
+	*total_bytes = 0;
+	*avg_second = 0.0f;
+
+	// sanity checks
+	if((np_index < 0) || (np_index >= MAX_RATE_PLAYERS)){
+		return 0;
+	}
+
+	for(idx=0; idx<MAX_RATE_TYPES; idx++){
+		m = &Multi_rate[np_index][idx];
+
+		// if we have a 0 length string, we're done
+		if(strlen(m->type) <= 0){
+			break;
+		}
+
+		*total_bytes += m->total_bytes;
+		*avg_second += m->avg_second;
+	}
+
+	return (idx > 0) ? 1 : 0;
+}
+
 #endif
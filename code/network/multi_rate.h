@@ -42,6 +42,9 @@ void multi_rate_process();
 // display
 void multi_rate_display(int np_index, int x, int y);
 
+// get the alltime bytes and the average bytes/second of all types for the given player, returns 0 if there is no data
+int multi_rate_get_totals(int np_index, int *total_bytes, float *avg_second);
+
 #else
 
 // stubs using #defines (c.f. NO_SOUND)
@@ -49,6 +52,7 @@ void multi_rate_display(int np_index, int x, int y);
 #define multi_rate_add(np_index, type, size) 	do { } while (0)
 #define multi_rate_process()
 #define multi_rate_display(np_index, x, y)
+#define multi_rate_get_totals(np_index, total_bytes, avg_second)	(0)
 
 #endif
 
@@ -17,6 +17,8 @@
 #include "io/timer.h"
 #include "cfile/cfile.h"
 
+#include <zlib.h>
+
 #ifndef NDEBUG
 #include "playerman/player.h"
 #include "network/multiutil.h"
@@ -40,6 +42,7 @@
 #define MULTI_XFER_CODE_HEADER				2				// file xfer header information follows, requires a HEADER_RESPONSE
 #define MULTI_XFER_CODE_DATA					3				// data block follows, requires an ack
 #define MULTI_XFER_CODE_FINAL					4				// indication from sender that xfer is complete, requires an ack
+#define MULTI_XFER_CODE_HEADER_RESPONSE		5				// response to an extended header, only sent to senders that support it
 
 // entry flags
 #define MULTI_XFER_FLAG_USED					(1<<0)		// this entry is in use	
@@ -53,6 +56,9 @@
 #define MULTI_XFER_FLAG_FAIL					(1<<8)		// xfer failed
 #define MULTI_XFER_FLAG_TIMEOUT				(1<<9)		// xfer has timed-out
 #define MULTI_XFER_FLAG_QUEUE_CURRENT		(1<<10)		// for a set of XFER_FLAG_QUEUE'd files, this is the current one sending
+#define MULTI_XFER_FLAG_COMPRESSED			(1<<11)		// data blocks are parts of a single zlib stream
+#define MULTI_XFER_FLAG_RESUMABLE			(1<<12)		// (recv side) keep the partial file if the xfer fails so it can be resumed
+#define MULTI_XFER_FLAG_STREAM_END			(1<<13)		// (send side) the compressed stream has been completely sent
 
 // packet size for file xfer
 #define MULTI_XFER_MAX_DATA_SIZE				490			// this will keep us within the MULTI_XFER_MAX_SIZE_LIMIT
@@ -60,6 +66,26 @@
 // timeout for a given xfer operation
 #define MULTI_XFER_TIMEOUT						10000		
 
+// number of data blocks the sender may have sent without getting an ack for them. Receivers ack every block so this
+// works with older receivers as well
+#define MULTI_XFER_WINDOW						16
+
+// newer senders put this and a capability byte behind the terminator of the filename in the header. Older receivers
+// stop at the terminator and never see it, newer ones answer with MULTI_XFER_CODE_HEADER_RESPONSE instead of an ack
+#define MULTI_XFER_HEADER_EXT_ID				"XFR2"
+#define MULTI_XFER_HEADER_EXT_SIZE			5
+
+// capabilities of an extended header
+#define MULTI_XFER_CAP_COMPRESS				(1<<0)		// the data can be sent as a zlib stream
+#define MULTI_XFER_CAP_RESUME					(1<<1)		// the receiver may ask for the data starting at an offset
+#define MULTI_XFER_CAPS							(MULTI_XFER_CAP_COMPRESS | MULTI_XFER_CAP_RESUME)
+
+// size of the buffer used for feeding file data into zlib
+#define MULTI_XFER_STREAM_BUFFER_SIZE		4096
+
+// number of partially received files kept around for resuming, the oldest one gets deleted when another one is kept
+#define MULTI_XFER_MAX_PARTIALS				4
+
 //XSTR:OFF
 
 // temp filename header for xferring files
@@ -81,9 +107,23 @@ typedef struct xfer_entry {
 	int xfer_stamp;												// timestamp for the current operation		
 	int force_dir;													// force the file to go to this directory on receive (will override Multi_xfer_force_dir)	
 	ushort sig;														// identifying sig - sender specifies this
+	int blocks_in_flight;										// (send side) data blocks which haven't been acked yet
+	z_stream *stream;												// compression state if MULTI_XFER_FLAG_COMPRESSED is set
+	ubyte *stream_buffer;										// (send side) file data waiting to be compressed
+	int start_time;												// timer_get_milliseconds() when the data started flowing
+	int wire_bytes;												// data bytes actually sent or received
 } xfer_entry;
 xfer_entry Multi_xfer_entry[MAX_XFER_ENTRIES];			// the file xfer entries themselves
 
+// partially received files which can be resumed if the same file (by checksum) gets sent again
+typedef struct xfer_partial {
+	SCP_string filename;
+	SCP_string ex_filename;
+	ushort file_chksum;
+	int force_dir;
+} xfer_partial;
+SCP_vector<xfer_partial> Multi_xfer_partials;
+
 // callback function pointer for when we start receiving a file
 void (*Multi_xfer_recv_notify)(int handle);
 
@@ -122,8 +162,11 @@ void multi_xfer_process_final(xfer_entry *xe);
 // process a data packet
 void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size);
 	
-// process a header
-void multi_xfer_process_header(ubyte *data, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum);		
+// process a header, caps is -1 if the sender doesn't know about extended headers
+void multi_xfer_process_header(ubyte *data, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum, int caps);		
+
+// process the response to an extended header
+void multi_xfer_process_header_response(xfer_entry *xe, ubyte caps, int resume_offset);
 
 // send the next block of outgoing data or a "final" packet if we're done
 void multi_xfer_send_next(xfer_entry *xe);
@@ -134,6 +177,9 @@ void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig);
 // send a nak to the sender
 void multi_xfer_send_nak(PSNET_SOCKET_RELIABLE socket, ushort sig);
 
+// send the response to an extended header
+void multi_xfer_send_header_response(PSNET_SOCKET_RELIABLE socket, ushort sig, ubyte caps, int resume_offset);
+
 // send a "final" packet
 void multi_xfer_send_final(xfer_entry *xe);
 
@@ -146,6 +192,21 @@ void multi_xfer_conv_prefix(char *filename, char *ex_filename);
 // get a new xfer sig
 ushort multi_xfer_get_sig();
 
+// free the compression state of the entry
+void multi_xfer_end_stream(xfer_entry *xe);
+
+// (send side) all the file data has been handed to the reliable layer
+inline bool multi_xfer_data_sent(xfer_entry *xe)
+{
+	return (xe->flags & MULTI_XFER_FLAG_COMPRESSED) ? ((xe->flags & MULTI_XFER_FLAG_STREAM_END) != 0) : (xe->file_ptr >= xe->file_size);
+}
+
+// delete the temp file of an unsuccessful receive, or keep it around if the xfer can be resumed
+void multi_xfer_discard_recv_file(xfer_entry *xe);
+
+// delete all partially received files which have been kept around for resuming
+void multi_xfer_delete_partials();
+
 // ------------------------------------------------------------------------------------------
 // MULTI XFER FUNCTIONS
 //
@@ -195,6 +256,15 @@ void multi_xfer_reset()
 
 	// blast all the memory clean
 	memset(Multi_xfer_entry,0,sizeof(xfer_entry) * MAX_XFER_ENTRIES);
+
+	// nothing which got interrupted before this is going to be sent again
+	multi_xfer_delete_partials();
+}
+
+// close the xfer system, call at shutdown
+void multi_xfer_close()
+{
+	multi_xfer_reset();
 }
 
 // send a file to the specified player, return a handle
@@ -317,15 +387,18 @@ void multi_xfer_abort(int handle)
 	// get e handle to the entry
 	xe = &Multi_xfer_entry[handle];
 
+	multi_xfer_end_stream(xe);
+
+	// an explicitly aborted xfer is not going to be resumed
+	xe->flags &= ~(MULTI_XFER_FLAG_RESUMABLE);
+
 	// close any open file and delete it 
 	if(xe->file != NULL){
 		cfclose(xe->file);
 		xe->file = NULL;
 
 		// delete it if there isn't some problem with the filename
-		if((xe->flags & MULTI_XFER_FLAG_RECV) && (xe->filename[0] != '\0')){
-			cf_delete(xe->ex_filename, xe->force_dir);
-		}
+		multi_xfer_discard_recv_file(xe);
 	}
 
 	// zero the socket
@@ -348,14 +421,16 @@ void multi_xfer_release_handle(int handle)
 	// get e handle to the entry
 	xe = &Multi_xfer_entry[handle];
 
+	multi_xfer_end_stream(xe);
+
 	// close any open file and delete it 
 	if(xe->file != NULL){
 		cfclose(xe->file);
 		xe->file = NULL;
 
 		// delete it if the file was not successfully received
-		if(!(xe->flags & MULTI_XFER_FLAG_SUCCESS) && (xe->flags & MULTI_XFER_FLAG_RECV) && (xe->filename[0] != '\0')){
-			cf_delete(xe->ex_filename,xe->force_dir);
+		if(!(xe->flags & MULTI_XFER_FLAG_SUCCESS)){
+			multi_xfer_discard_recv_file(xe);
 		}
 	}
 
@@ -604,6 +679,8 @@ void multi_xfer_fail_entry(xfer_entry *xe)
 	xe->flags &= ~(MULTI_XFER_FLAG_WAIT_ACK | MULTI_XFER_FLAG_WAIT_DATA | MULTI_XFER_FLAG_UNKNOWN);
 	xe->flags |= MULTI_XFER_FLAG_FAIL;
 
+	multi_xfer_end_stream(xe);
+
 	// close the file pointer
 	if(xe->file != NULL){
 		cfclose(xe->file);
@@ -611,9 +688,7 @@ void multi_xfer_fail_entry(xfer_entry *xe)
 	}
 
 	// delete the file
-	if((xe->flags & MULTI_XFER_FLAG_RECV) && (xe->filename[0] != '\0')){
-		cf_delete(xe->ex_filename,xe->force_dir);
-	}
+	multi_xfer_discard_recv_file(xe);
 		
 	// null the timestamp
 	xe->xfer_stamp = -1;
@@ -661,6 +736,9 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 	ubyte xfer_data[600];
 	ushort sig;
 	int sender_side = 1;
+	int header_caps = -1;
+	ubyte response_caps = 0;
+	int resume_offset = 0;
 
 	// read in all packet data
 	GET_DATA(val);	
@@ -676,12 +754,27 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 
 	// RECV side
 	case MULTI_XFER_CODE_HEADER:		
-		GET_STRING(filename);
+		{
+			int string_start = offset;
+			GET_STRING(filename);
+
+			// look for the extension behind the terminator
+			auto name_len = strlen(filename);
+			if(((size_t)(offset - string_start) >= sizeof(int) + name_len + 1 + MULTI_XFER_HEADER_EXT_SIZE) && !memcmp(filename + name_len + 1, MULTI_XFER_HEADER_EXT_ID, 4)){
+				header_caps = (ubyte)filename[name_len + 1 + 4];
+			}
+		}
 		GET_INT(file_size);					
 		GET_USHORT(file_checksum);
 		sender_side = 0;
 		break;
 
+	// SEND side
+	case MULTI_XFER_CODE_HEADER_RESPONSE:
+		GET_DATA(response_caps);
+		GET_INT(resume_offset);
+		break;
+
 	// SEND side
 	case MULTI_XFER_CODE_ACK:
 	case MULTI_XFER_CODE_NAK:
@@ -759,7 +852,13 @@ int multi_xfer_process_packet(unsigned char *data, PSNET_SOCKET_RELIABLE who)
 	// process a header
 	case MULTI_XFER_CODE_HEADER :
 		// send on my reliable socket
-		multi_xfer_process_header(xfer_data, who, sig, filename, file_size, file_checksum);
+		multi_xfer_process_header(xfer_data, who, sig, filename, file_size, file_checksum, header_caps);
+		break;
+
+	// process the response to an extended header
+	case MULTI_XFER_CODE_HEADER_RESPONSE :
+		Assert(xe != NULL);
+		multi_xfer_process_header_response(xe, response_caps, resume_offset);
 		break;
 	}		
 	return offset;
@@ -776,9 +875,11 @@ void multi_xfer_process_ack(xfer_entry *xe)
 			xe->flags |= MULTI_XFER_FLAG_SUCCESS;
 
 #ifdef MULTI_XFER_VERBOSE
-			nprintf(("Network", "MULTI XFER : Successfully sent file %s\n", xe->filename));
+			nprintf(("Network", "MULTI XFER : Successfully sent file %s (%d bytes as %d bytes in %d ms)\n", xe->filename, xe->file_size, xe->wire_bytes, timer_get_milliseconds() - xe->start_time));
 #endif
 
+			multi_xfer_end_stream(xe);
+
 			// if we should be auto-destroying this entry, do so
 			if(xe->flags & MULTI_XFER_FLAG_AUTODESTROY){
 				multi_xfer_release_handle((int)std::distance(Multi_xfer_entry, xe));
@@ -786,6 +887,12 @@ void multi_xfer_process_ack(xfer_entry *xe)
 		} 
 		// otherwise if we're waiting for an ack, we should send the next chunk of data or a "final" packet if we're done
 		else if(xe->flags & MULTI_XFER_FLAG_WAIT_ACK){
+			if(xe->blocks_in_flight > 0){
+				xe->blocks_in_flight--;
+			} else {
+				// this acks the header
+				xe->start_time = timer_get_milliseconds();
+			}
 			multi_xfer_send_next(xe);
 		}
 	}
@@ -805,6 +912,8 @@ void multi_xfer_process_final(xfer_entry *xe)
 
 	// make sure we skip a line
 	nprintf(("Network","\n"));
+
+	multi_xfer_end_stream(xe);
 	
 	// close the file
 	if(xe->file != NULL){
@@ -816,8 +925,9 @@ void multi_xfer_process_final(xfer_entry *xe)
 	// check to make sure the file checksum is the same
 	chksum = 0;
 	if(!cf_chksum_short(xe->ex_filename, &chksum, -1, xe->force_dir) || (chksum != xe->file_chksum)){
-		// mark as failed
+		// mark as failed, there is no point in resuming this one
 		xe->flags |= MULTI_XFER_FLAG_FAIL;
+		xe->flags &= ~(MULTI_XFER_FLAG_RESUMABLE);
 
 #ifdef MULTI_XFER_VERBOSE
 		nprintf(("Network","MULTI XFER : file %s failed checksum %d %d!\n",xe->ex_filename, (int)xe->file_chksum, (int)chksum));
@@ -837,7 +947,7 @@ void multi_xfer_process_final(xfer_entry *xe)
 			// mark the xfer as being successful
 			xe->flags |= MULTI_XFER_FLAG_SUCCESS;	
 
-			nprintf(("Network","MULTI XFER : SUCCESSFULLY TRANSFERRED FILE %s (%d bytes)\n", xe->filename, xe->file_size));		
+			nprintf(("Network","MULTI XFER : SUCCESSFULLY TRANSFERRED FILE %s (%d bytes as %d bytes in %d ms)\n", xe->filename, xe->file_size, xe->wire_bytes, timer_get_milliseconds() - xe->start_time));		
 
 			// send an ack to the sender
 			multi_xfer_send_ack(xe->file_socket, xe->sig);
@@ -866,8 +976,33 @@ void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size)
 	// print out a crude progress indicator
 	nprintf(("Network","."));		
 
+	xe->wire_bytes += data_size;
+
+	// compressed data gets written as it comes out of zlib
+	if(xe->flags & MULTI_XFER_FLAG_COMPRESSED){
+		ubyte out[MULTI_XFER_STREAM_BUFFER_SIZE];
+		int ret = Z_OK;
+
+		xe->stream->next_in = data;
+		xe->stream->avail_in = (uInt)data_size;
+		do {
+			xe->stream->next_out = out;
+			xe->stream->avail_out = sizeof(out);
+			ret = inflate(xe->stream, Z_NO_FLUSH);
+
+			auto out_size = (int)(sizeof(out) - xe->stream->avail_out);
+			if(((ret != Z_OK) && (ret != Z_STREAM_END) && (ret != Z_BUF_ERROR)) || (xe->file == NULL) || ((out_size > 0) && !cfwrite(out, out_size, 1, xe->file))){
+				nprintf(("Network","MULTI XFER : failed to decompress data for %s\n", xe->filename));
+				multi_xfer_send_nak(xe->file_socket, xe->sig);
+				multi_xfer_fail_entry(xe);
+				return;
+			}
+
+			xe->file_ptr += out_size;
+		} while((ret == Z_OK) && (xe->stream->avail_out == 0));
+	}
 	// attempt to write the rest of the data string to the file
-	if((xe->file == NULL) || !cfwrite(data, data_size, 1, xe->file)){
+	else if((xe->file == NULL) || !cfwrite(data, data_size, 1, xe->file)){
 		// inform the sender we had a problem
 		multi_xfer_send_nak(xe->file_socket, xe->sig);
 
@@ -876,11 +1011,11 @@ void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size)
 
 		xe->file_ptr += data_size;		
 		return;
+	} else {
+		// increment the file pointer
+		xe->file_ptr += data_size;
 	}
 
-	// increment the file pointer
-	xe->file_ptr += data_size;
-
 	// send an ack to the sender
 	multi_xfer_send_ack(xe->file_socket, xe->sig);
 
@@ -889,10 +1024,11 @@ void multi_xfer_process_data(xfer_entry *xe, ubyte *data, int data_size)
 }
 	
 // process a header, return bytes processed
-void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum)
+void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, ushort sig, char *filename, int file_size, ushort file_checksum, int caps)
 {		
 	xfer_entry *xe;		
 	int handle;	
+	int resume_offset = 0;
 
 	// if the xfer system is locked, send a nak
 	if(Multi_xfer_locked){		
@@ -955,9 +1091,38 @@ void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, usho
 	cf_delete( xe->filename, CF_TYPE_MULTI_CACHE );
 	cf_delete( xe->filename, CF_TYPE_MISSIONS );
 
+	// if an earlier xfer of exactly this file got interrupted, pick up where it stopped
+	if(caps >= 0){
+		caps &= MULTI_XFER_CAPS;
+
+		for(auto it = Multi_xfer_partials.begin(); it != Multi_xfer_partials.end(); ++it){
+			if(!stricmp(it->filename.c_str(), xe->filename)){
+				if((caps & MULTI_XFER_CAP_RESUME) && (it->file_chksum == xe->file_chksum) && (it->force_dir == xe->force_dir)){
+					CFILE *partial = cfopen(xe->ex_filename, "rb", CFILE_NORMAL, xe->force_dir);
+					if(partial != NULL){
+						resume_offset = cfilelength(partial);
+						cfclose(partial);
+					}
+				}
+
+				// the temp file gets reused or overwritten either way
+				Multi_xfer_partials.erase(it);
+				break;
+			}
+		}
+
+		if((resume_offset <= 0) || (resume_offset >= xe->file_size)){
+			resume_offset = 0;
+		}
+
+#ifdef MULTI_XFER_VERBOSE
+		nprintf(("Network","MULTI XFER : extended header for %s, caps %d, resuming at %d\n", xe->filename, caps, resume_offset));
+#endif
+	}
+
 	// attempt to open the file (using the prefixed filename)
 	xe->file = NULL;
-	xe->file = cfopen(xe->ex_filename, "wb", CFILE_NORMAL, xe->force_dir);
+	xe->file = cfopen(xe->ex_filename, (resume_offset > 0) ? "ab" : "wb", CFILE_NORMAL, xe->force_dir);
 	if(xe->file == NULL){		
 		multi_xfer_send_nak(who, sig);		
 
@@ -965,57 +1130,129 @@ void multi_xfer_process_header(ubyte * /*data*/, PSNET_SOCKET_RELIABLE who, usho
 		memset(xe, 0, sizeof(xfer_entry));
 		return;
 	}
+	xe->file_ptr = resume_offset;
+
+	if((caps >= 0) && (caps & MULTI_XFER_CAP_COMPRESS)){
+		xe->stream = (z_stream*)vm_malloc(sizeof(z_stream));
+		memset(xe->stream, 0, sizeof(z_stream));
+		if(inflateInit(xe->stream) != Z_OK){
+			vm_free(xe->stream);
+			xe->stream = NULL;
+			caps &= ~(MULTI_XFER_CAP_COMPRESS);
+		} else {
+			xe->flags |= MULTI_XFER_FLAG_COMPRESSED;
+		}
+	}
+	if((caps >= 0) && (caps & MULTI_XFER_CAP_RESUME)){
+		xe->flags |= MULTI_XFER_FLAG_RESUMABLE;
+	}
 	
 	// set the waiting for data flag
 	xe->flags |= MULTI_XFER_FLAG_WAIT_DATA;		
+	xe->start_time = timer_get_milliseconds();
 
-	// send an ack to the server		
-	multi_xfer_send_ack(who, sig);	
+	// send an ack to the server, or tell a newer server how we want the data
+	if(caps >= 0){
+		multi_xfer_send_header_response(who, sig, (ubyte)caps, resume_offset);
+	} else {
+		multi_xfer_send_ack(who, sig);	
+	}
 
 #ifdef MULTI_XFER_VERBOSE
 	nprintf(("Network","MULTI XFER : AFTER HEADER %s\n",xe->filename));
 #endif	
 }
 
-// send the next block of outgoing data or a "final" packet if we're done
-void multi_xfer_send_next(xfer_entry *xe)
+// process the response to an extended header
+void multi_xfer_process_header_response(xfer_entry *xe, ubyte caps, int resume_offset)
 {
-	ubyte data[MAX_PACKET_SIZE],code;
-	ushort data_size;
-	int packet_size = 0;	
+	// only valid as an answer to the header
+	if(!(xe->flags & MULTI_XFER_FLAG_SEND) || !(xe->flags & MULTI_XFER_FLAG_WAIT_ACK) || (xe->blocks_in_flight > 0) || (xe->file_ptr > 0)){
+		return;
+	}
 
-	// print out a crude progress indicator
-	nprintf(("Network", "+"));		
+	if((caps & MULTI_XFER_CAP_RESUME) && (resume_offset > 0) && (resume_offset < xe->file_size)){
+		if(cfseek(xe->file, resume_offset, CF_SEEK_SET) == 0){
+			xe->file_ptr = resume_offset;
+		}
+	}
 
-	// if we've sent all the data, then we should send a "final" packet
-	if(xe->file_ptr >= xe->file_size){
-		// mark the entry as unknown 
-		xe->flags |= MULTI_XFER_FLAG_UNKNOWN;
+	if(caps & MULTI_XFER_CAP_COMPRESS){
+		xe->stream = (z_stream*)vm_malloc(sizeof(z_stream));
+		xe->stream_buffer = (ubyte*)vm_malloc(MULTI_XFER_STREAM_BUFFER_SIZE);
+		memset(xe->stream, 0, sizeof(z_stream));
 
-		// set the timestmp
-		xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
+		// the receiver already expects a compressed stream, so there is no falling back from here
+		if(deflateInit(xe->stream, Z_DEFAULT_COMPRESSION) != Z_OK){
+			vm_free(xe->stream);
+			xe->stream = NULL;
 
-		// send the packet
-		multi_xfer_send_final(xe);		
+			multi_xfer_send_nak(xe->file_socket, xe->sig);
+			multi_xfer_fail_entry(xe);
+			return;
+		}
+		xe->flags |= MULTI_XFER_FLAG_COMPRESSED;
+	}
 
-		return;
+#ifdef MULTI_XFER_VERBOSE
+	nprintf(("Network","MULTI XFER : sending %s with caps %d starting at %d\n", xe->filename, (int)caps, xe->file_ptr));
+#endif
+
+	xe->start_time = timer_get_milliseconds();
+	multi_xfer_send_next(xe);
+}
+
+// fill the block of a data packet with compressed data, return the size of the block or -1 on error
+int multi_xfer_compress_block(xfer_entry *xe, ubyte *block, int block_size)
+{
+	z_stream *stream = xe->stream;
+
+	stream->next_out = block;
+	stream->avail_out = (uInt)block_size;
+
+	while(stream->avail_out > 0){
+		// feed more of the file into the stream once it has eaten everything
+		if((stream->avail_in == 0) && (xe->file_ptr < xe->file_size)){
+			int read_size = MIN(MULTI_XFER_STREAM_BUFFER_SIZE, xe->file_size - xe->file_ptr);
+			if(cfread(xe->stream_buffer, 1, read_size, xe->file) != read_size){
+				return -1;
+			}
+			xe->file_ptr += read_size;
+
+			stream->next_in = xe->stream_buffer;
+			stream->avail_in = (uInt)read_size;
+		}
+
+		int flush = ((stream->avail_in == 0) && (xe->file_ptr >= xe->file_size)) ? Z_FINISH : Z_NO_FLUSH;
+		int ret = deflate(stream, flush);
+		if(ret == Z_STREAM_END){
+			xe->flags |= MULTI_XFER_FLAG_STREAM_END;
+			break;
+		}
+		if(ret != Z_OK){
+			return -1;
+		}
 	}
 
-	// build the header 
-	BUILD_HEADER(XFER_PACKET);	
+	return block_size - (int)stream->avail_out;
+}
+
+// send a single block of outgoing data
+void multi_xfer_send_block(xfer_entry *xe)
+{
+	ubyte data[MAX_PACKET_SIZE],code;
+	ushort data_size;
+	int packet_size = 0;
+
+	// print out a crude progress indicator
+	nprintf(("Network", "+"));
+
+	// build the header
+	BUILD_HEADER(XFER_PACKET);
 
 	// length of the added string
 	auto flen = strlen(xe->filename) + 4;
 
-	// determine how much data we are going to send with this packet and add it in
-	if((size_t)(xe->file_size - xe->file_ptr) >= (MULTI_XFER_MAX_DATA_SIZE - flen)){
-		data_size = (ushort)(MULTI_XFER_MAX_DATA_SIZE - flen);
-	} else {
-		data_size = (unsigned short)(xe->file_size - xe->file_ptr);
-	}
-	// increment the file pointer
-	xe->file_ptr += data_size;	
-
 	// add the opcode
 	code = MULTI_XFER_CODE_DATA;
 	ADD_DATA(code);
@@ -1023,29 +1260,81 @@ void multi_xfer_send_next(xfer_entry *xe)
 	// add the sig
 	ADD_USHORT(xe->sig);
 
-	// add in the size of the rest of the packet	
-	ADD_USHORT(data_size);
-	
-	// copy in the data
-	if(cfread(data+packet_size,1,(int)data_size,xe->file) == 0){
-		// send a nack to the receiver
-		multi_xfer_send_nak(xe->file_socket, xe->sig);
+	if(xe->flags & MULTI_XFER_FLAG_COMPRESSED){
+		// compressed data fills the whole block until the stream ends
+		int block_size = multi_xfer_compress_block(xe, data + packet_size + sizeof(ushort), (int)(MULTI_XFER_MAX_DATA_SIZE - flen));
+		if(block_size < 0){
+			multi_xfer_send_nak(xe->file_socket, xe->sig);
+			multi_xfer_fail_entry(xe);
+			return;
+		}
+		data_size = (ushort)block_size;
 
-		// fail this send
-		multi_xfer_fail_entry(xe);		
-		return;
+		// add in the size of the rest of the packet
+		ADD_USHORT(data_size);
+	} else {
+		// determine how much data we are going to send with this packet and add it in
+		if((size_t)(xe->file_size - xe->file_ptr) >= (MULTI_XFER_MAX_DATA_SIZE - flen)){
+			data_size = (ushort)(MULTI_XFER_MAX_DATA_SIZE - flen);
+		} else {
+			data_size = (unsigned short)(xe->file_size - xe->file_ptr);
+		}
+		// increment the file pointer
+		xe->file_ptr += data_size;
+
+		// add in the size of the rest of the packet
+		ADD_USHORT(data_size);
+
+		// copy in the data
+		if(cfread(data+packet_size,1,(int)data_size,xe->file) == 0){
+			// send a nack to the receiver
+			multi_xfer_send_nak(xe->file_socket, xe->sig);
+
+			// fail this send
+			multi_xfer_fail_entry(xe);
+			return;
+		}
 	}
 
 	// increment the packet size
 	packet_size += (int)data_size;
 
+	xe->blocks_in_flight++;
+	xe->wire_bytes += (int)data_size;
+
 	// set the timestmp
 	xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
 
-	// otherwise send the data	
+	// otherwise send the data
 	psnet_rel_send(xe->file_socket, data, packet_size);
 }
 
+// send the next blocks of outgoing data or a "final" packet if we're done
+void multi_xfer_send_next(xfer_entry *xe)
+{
+	// keep up to MULTI_XFER_WINDOW blocks on their way instead of waiting for an ack after each one
+	while(!multi_xfer_data_sent(xe) && (xe->blocks_in_flight < MULTI_XFER_WINDOW)){
+		multi_xfer_send_block(xe);
+
+		// sending may have failed the entry
+		if(!(xe->flags & MULTI_XFER_FLAG_SEND)){
+			return;
+		}
+	}
+
+	// if we've sent all the data and all of it arrived, then we should send a "final" packet
+	if(multi_xfer_data_sent(xe) && (xe->blocks_in_flight == 0)){
+		// mark the entry as unknown
+		xe->flags |= MULTI_XFER_FLAG_UNKNOWN;
+
+		// set the timestmp
+		xe->xfer_stamp = timestamp(MULTI_XFER_TIMEOUT);
+
+		// send the packet
+		multi_xfer_send_final(xe);
+	}
+}
+
 // send an ack to the sender
 void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig)
 {
@@ -1066,6 +1355,30 @@ void multi_xfer_send_ack(PSNET_SOCKET_RELIABLE socket, ushort sig)
 	psnet_rel_send(socket, data, packet_size);
 }
 
+// send the response to an extended header
+void multi_xfer_send_header_response(PSNET_SOCKET_RELIABLE socket, ushort sig, ubyte caps, int resume_offset)
+{
+	ubyte data[MAX_PACKET_SIZE],code;	
+	int packet_size = 0;
+
+	// build the header and add the code
+	BUILD_HEADER(XFER_PACKET);	
+
+	// add the opcode
+	code = MULTI_XFER_CODE_HEADER_RESPONSE;
+	ADD_DATA(code);
+
+	// add the sig
+	ADD_USHORT(sig);
+
+	// add the capabilities we agreed to and where the data should start
+	ADD_DATA(caps);
+	ADD_INT(resume_offset);
+
+	// send the data	
+	psnet_rel_send(socket, data, packet_size);
+}
+
 // send a nak to the sender
 void multi_xfer_send_nak(PSNET_SOCKET_RELIABLE socket, ushort sig)
 {
@@ -1120,8 +1433,19 @@ void multi_xfer_send_header(xfer_entry *xe)
 	// add the sig
 	ADD_USHORT(xe->sig);
 
-	// add the filename
-	ADD_STRING(xe->filename);
+	// add the filename, followed by the header extension which older receivers don't see since it is behind the terminator
+	{
+		ubyte caps = MULTI_XFER_CAPS;
+		int name_len = (int)strlen(xe->filename) + 1;
+		int len = name_len + MULTI_XFER_HEADER_EXT_SIZE;
+		int len_tmp = INTEL_INT(len);
+		ADD_DATA(len_tmp);
+		memcpy(data+packet_size, xe->filename, name_len);
+		packet_size += name_len;
+		memcpy(data+packet_size, MULTI_XFER_HEADER_EXT_ID, 4);
+		packet_size += 4;
+		ADD_DATA(caps);
+	}
 		
 	// add the id #
 	ADD_INT(xe->file_size);
@@ -1165,3 +1489,65 @@ ushort multi_xfer_get_sig()
 
 	return ret;
 }
+
+// free the compression state of the entry
+void multi_xfer_end_stream(xfer_entry *xe)
+{
+	if(xe->stream != NULL){
+		if(xe->flags & MULTI_XFER_FLAG_SEND){
+			deflateEnd(xe->stream);
+		} else {
+			inflateEnd(xe->stream);
+		}
+		vm_free(xe->stream);
+		xe->stream = NULL;
+	}
+
+	if(xe->stream_buffer != NULL){
+		vm_free(xe->stream_buffer);
+		xe->stream_buffer = NULL;
+	}
+}
+
+// delete the temp file of an unsuccessful receive, or keep it around if the xfer can be resumed
+void multi_xfer_discard_recv_file(xfer_entry *xe)
+{
+	if(!(xe->flags & MULTI_XFER_FLAG_RECV) || (xe->filename[0] == '\0')){
+		return;
+	}
+
+	// only keep the file if the connection went away, a sender which rejected the xfer is not going to resume it
+	bool interrupted = (xe->flags & MULTI_XFER_FLAG_TIMEOUT) || (psnet_rel_get_status(xe->file_socket) != RNF_CONNECTED);
+
+	if((xe->flags & MULTI_XFER_FLAG_RESUMABLE) && !(xe->flags & MULTI_XFER_FLAG_SUCCESS) && (xe->file_ptr > 0) && interrupted){
+		// make room by getting rid of the oldest file
+		if(Multi_xfer_partials.size() >= MULTI_XFER_MAX_PARTIALS){
+			auto& oldest = Multi_xfer_partials.front();
+			cf_delete(oldest.ex_filename.c_str(), oldest.force_dir);
+			Multi_xfer_partials.erase(Multi_xfer_partials.begin());
+		}
+
+		xfer_partial partial;
+		partial.filename = xe->filename;
+		partial.ex_filename = xe->ex_filename;
+		partial.file_chksum = xe->file_chksum;
+		partial.force_dir = xe->force_dir;
+		Multi_xfer_partials.push_back(partial);
+
+#ifdef MULTI_XFER_VERBOSE
+		nprintf(("Network","MULTI XFER : keeping %d bytes of %s to resume later\n", xe->file_ptr, xe->filename));
+#endif
+		return;
+	}
+
+	cf_delete(xe->ex_filename, xe->force_dir);
+}
+
+// delete all partially received files which have been kept around for resuming
+void multi_xfer_delete_partials()
+{
+	for(auto& partial : Multi_xfer_partials){
+		cf_delete(partial.ex_filename.c_str(), partial.force_dir);
+	}
+	Multi_xfer_partials.clear();
+}
@@ -53,6 +53,9 @@ void multi_xfer_do();
 // reset the xfer system, including shutting down/killing all active xfers
 void multi_xfer_reset();
 
+// close the xfer system, call at shutdown
+void multi_xfer_close();
+
 // send a file to the specified player, return a handle
 int multi_xfer_send_file(PSNET_SOCKET_RELIABLE who, char *filename, int cfile_flags, int flags = 0);
 
@@ -803,6 +803,8 @@ int multi_create_player( int net_player_num, player *pl, const char* name, net_a
 	// nil his data rate timestamp stuff
 	Net_players[net_player_num].s_info.rate_stamp = -1;
 	Net_players[net_player_num].s_info.rate_bytes = 0;
+	Net_players[net_player_num].s_info.oo_packets_sent = 0;
+	Net_players[net_player_num].s_info.oo_bytes_sent = 0;
 
 	// nil packet buffer stuff
 	Net_players[net_player_num].s_info.unreliable_buffer_size = 0;
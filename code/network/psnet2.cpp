@@ -132,8 +132,10 @@ typedef struct network_packet_buffer_list {
 //*******************************
 #define MAXNETBUFFERS			150		// Maximum network buffers (For between network and upper level functions, which is 
 													// required in case of out of order packets
-#define NETRETRYTIME				0.75f		// Time after sending before we resend
+#define NETRETRYTIME				0.75f		// Time after sending before we resend until we have a round trip time estimate
 #define MIN_NET_RETRYTIME		0.2f
+#define MAX_NET_RETRYTIME		(NETRETRYTIME*4)
+#define NET_RETRY_GRANULARITY	0.02f		// Roughly how often psnet_rel_work() gets called
 #define NETTIMEOUT				30			// Time after receiving the last packet before we drop that user
 #define NETHEARTBEATTIME		3			// How often to send a heartbeat
 #define MAXRELIABLESOCKETS		40			// Max reliable sockets to open at once...
@@ -141,6 +143,13 @@ typedef struct network_packet_buffer_list {
 
 #define RELIABLE_CONNECT_TIME		7		// how long we'll wait for a response when doing a reliable connect
 
+// Congestion window limits, in packets
+#define MIN_CONGESTION_WINDOW		4
+#define INITIAL_CONGESTION_WINDOW	32
+
+#define FAST_RETRANSMIT_MISSES		3		// How many acks have to report later packets before we resend a missing one
+#define SACK_BITS						32		// Number of packets an ack reports on, starting with the first one the peer is missing
+
 int Nettimeout = NETTIMEOUT;
 
 // Reliable packet stuff
@@ -163,6 +172,14 @@ typedef struct {
 } reliable_header;
 
 #define RELIABLE_PACKET_HEADER_ONLY_SIZE (sizeof(reliable_header)-NETBUFFERSIZE)
+
+// The data of an RNT_ACK packet for a data packet. Older versions only send and read the sequence number. The fields
+// are written one by one at these offsets so the format does not depend on the padding of a struct.
+#define RELIABLE_ACK_SEQ_OFFSET			0		// unsigned int, sequence number of the packet being ACK'd
+#define RELIABLE_ACK_BASE_OFFSET			4		// ushort, every packet before this one has been received
+#define RELIABLE_ACK_RECEIVED_OFFSET	6		// unsigned int, bit n is set if packet base+n has been received
+#define RELIABLE_ACK_SEQ_SIZE				4		// size of an ACK from older versions
+#define RELIABLE_ACK_SIZE					10
 #define MAX_PING_HISTORY	10
 
 typedef struct {
@@ -179,6 +196,8 @@ typedef struct {
 	unsigned short ssequence[MAXNETBUFFERS];				// This is the sequence number of the given packet
 	float timesent[MAXNETBUFFERS];
 	int send_len[MAXNETBUFFERS];
+	ubyte times_sent[MAXNETBUFFERS];							// 0 if the packet is waiting for the congestion window to open
+	ubyte sack_misses[MAXNETBUFFERS];						// Number of acks that reported later packets but not this one
 	reliable_net_rcvbuffer  *rbuffers[MAXNETBUFFERS];
 	int recv_len[MAXNETBUFFERS];
 	unsigned short rsequence[MAXNETBUFFERS];				// This is the sequence number of the given packet
@@ -194,6 +213,14 @@ typedef struct {
 	ubyte ping_pos;
 	unsigned int num_ping_samples;
 	float mean_ping;	
+	float srtt;															// Smoothed round trip time, 0 until the first ACK arrives
+	float rttvar;														// Round trip time variation
+	float rto;															// Time after sending before we resend
+	float cwnd;															// Congestion window, in packets
+	float ssthresh;													// Slow start threshold, in packets
+	unsigned short recover;										// Losses of packets before this one don't shrink the window again
+	unsigned int retransmits;
+	unsigned int fast_retransmits;
 } reliable_socket;
 
 reliable_socket Reliable_sockets[MAXRELIABLESOCKETS];
@@ -949,16 +976,247 @@ int psnet_is_valid_ip_string( char *ip_string, int  /*allow_port*/ )
 // PSNET 2 RELIABLE SOCKET FUNCTIONS
 //
 
-void psnet_rel_send_ack(SOCKADDR *raddr, unsigned int sig, ubyte link_type, float time_sent)
+/**
+ * Sets up the round trip time estimate and the congestion window of a new connection
+ */
+void psnet_rel_init_flow(reliable_socket *rsocket)
+{
+	rsocket->srtt = 0.0f;
+	rsocket->rttvar = 0.0f;
+	rsocket->rto = NETRETRYTIME;
+	rsocket->cwnd = (float)INITIAL_CONGESTION_WINDOW;
+	rsocket->ssthresh = (float)MAXNETBUFFERS;
+	rsocket->recover = rsocket->theirsequence;
+}
+
+/**
+ * Updates the retry time of a connection with a new round trip time sample (RFC 6298)
+ */
+void psnet_rel_update_rtt(reliable_socket *rsocket, float rtt)
+{
+	if (rtt < 0.0f) {
+		return;
+	}
+
+	if (rsocket->srtt <= 0.0f) {
+		rsocket->srtt = rtt;
+		rsocket->rttvar = rtt / 2.0f;
+	} else {
+		rsocket->rttvar = 0.75f * rsocket->rttvar + 0.25f * fl_abs(rsocket->srtt - rtt);
+		rsocket->srtt = 0.875f * rsocket->srtt + 0.125f * rtt;
+	}
+
+	rsocket->rto = rsocket->srtt + MAX(NET_RETRY_GRANULARITY, 4.0f * rsocket->rttvar);
+	CLAMP(rsocket->rto, MIN_NET_RETRYTIME, MAX_NET_RETRYTIME);
+}
+
+/**
+ * Shrinks the congestion window after a packet got lost
+ *
+ * Several packets lost from the same window only count once.
+ */
+void psnet_rel_on_loss(reliable_socket *rsocket, unsigned short seq, bool timeout)
+{
+	if ((short)(seq - rsocket->recover) < 0) {
+		return;
+	}
+
+	rsocket->ssthresh = MAX(rsocket->cwnd / 2.0f, (float)MIN_CONGESTION_WINDOW);
+	rsocket->cwnd = timeout ? (float)MIN_CONGESTION_WINDOW : rsocket->ssthresh;
+	rsocket->recover = rsocket->theirsequence;
+}
+
+/**
+ * Number of packets that have been sent but not ACK'd yet
+ */
+int psnet_rel_in_flight(reliable_socket *rsocket)
 {
-	int ret, sig_tmp;
+	int count = 0;
+	for (int i = 0; i < MAXNETBUFFERS; i++) {
+		if (rsocket->sbuffers[i] && rsocket->times_sent[i]) {
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * (Re)send the packet in the given send buffer
+ */
+int psnet_rel_send_buffer(reliable_socket *rsocket, int i)
+{
+	reliable_header send_header;
+	send_header.send_time = psnet_get_time();
+	send_header.send_time = INTEL_FLOAT( &send_header.send_time );
+	send_header.seq = INTEL_SHORT( rsocket->ssequence[i] );
+	memcpy(send_header.data,rsocket->sbuffers[i]->buffer,rsocket->send_len[i]);
+	send_header.data_len = INTEL_SHORT( (ushort)rsocket->send_len[i] );
+	send_header.type = RNT_DATA;
+
+	int rcode = SENDTO(Unreliable_socket, (char *)&send_header, RELIABLE_PACKET_HEADER_ONLY_SIZE + rsocket->send_len[i], 0, &rsocket->addr, sizeof(SOCKADDR), PSNET_TYPE_RELIABLE);
+
+	if((rcode == SOCKET_ERROR) && (WSAEWOULDBLOCK == WSAGetLastError())){
+		//The packet didn't get sent, leave it to the next frame
+		return rcode;
+	}
+
+	rsocket->last_packet_sent = psnet_get_time();
+	rsocket->timesent[i] = rsocket->last_packet_sent;
+	rsocket->sack_misses[i] = 0;
+	if (rsocket->times_sent[i] < 255) {
+		rsocket->times_sent[i]++;
+	}
+	return rcode;
+}
+
+/**
+ * Sends packets that are waiting for the congestion window to open, oldest first
+ */
+void psnet_rel_send_queued(reliable_socket *rsocket)
+{
+	int in_flight = psnet_rel_in_flight(rsocket);
+
+	while (in_flight < (int)rsocket->cwnd) {
+		int oldest = -1;
+		for (int i = 0; i < MAXNETBUFFERS; i++) {
+			if (rsocket->sbuffers[i] && !rsocket->times_sent[i]) {
+				if ((oldest < 0) || ((short)(rsocket->ssequence[i] - rsocket->ssequence[oldest]) < 0)) {
+					oldest = i;
+				}
+			}
+		}
+
+		if (oldest < 0) {
+			return;
+		}
+
+		if (psnet_rel_send_buffer(rsocket, oldest) == SOCKET_ERROR) {
+			return;
+		}
+		in_flight++;
+	}
+}
+
+/**
+ * Frees a send buffer after its packet has been ACK'd and grows the congestion window
+ */
+void psnet_rel_ack_buffer(reliable_socket *rsocket, int i)
+{
+	vm_free(rsocket->sbuffers[i]);
+	rsocket->sbuffers[i] = NULL;
+	rsocket->ssequence[i] = 0;
+	rsocket->times_sent[i] = 0;
+	rsocket->sack_misses[i] = 0;
+
+	if (rsocket->cwnd < rsocket->ssthresh) {
+		rsocket->cwnd += 1.0f;
+	} else {
+		rsocket->cwnd += 1.0f / rsocket->cwnd;
+	}
+	rsocket->cwnd = MIN(rsocket->cwnd, (float)MAXNETBUFFERS);
+}
+
+/**
+ * Handles the data of an RNT_ACK packet for a data packet
+ *
+ * Newer versions report every packet they have received in a window behind the first missing one. Packets that the
+ * peer is still missing after several later ones arrived get resent right away instead of waiting for the retry time.
+ */
+void psnet_rel_process_ack(reliable_socket *rsocket, const reliable_header *ack)
+{
+	unsigned int acksig = 0;
+	ushort base = 0;
+	unsigned int received = 0;
+
+	if (ack->data_len >= RELIABLE_ACK_SEQ_SIZE) {
+		memcpy(&acksig, ack->data + RELIABLE_ACK_SEQ_OFFSET, sizeof(acksig));
+		acksig = INTEL_INT(acksig);
+	}
+
+	bool has_sack = ack->data_len >= RELIABLE_ACK_SIZE;
+	if (has_sack) {
+		memcpy(&base, ack->data + RELIABLE_ACK_BASE_OFFSET, sizeof(base));
+		base = INTEL_SHORT(base);
+		memcpy(&received, ack->data + RELIABLE_ACK_RECEIVED_OFFSET, sizeof(received));
+		received = INTEL_INT(received);
+	}
+
+	// the highest packet the peer reported, everything sent before it that is still missing has a hole
+	int highest = -1;
+	if (has_sack) {
+		for (int bit = SACK_BITS - 1; bit >= 0; bit--) {
+			if (received & (1u << bit)) {
+				highest = bit;
+				break;
+			}
+		}
+	}
+
+	for (int i = 0; i < MAXNETBUFFERS; i++) {
+		if (!rsocket->sbuffers[i]) {
+			continue;
+		}
+
+		if (rsocket->ssequence[i] == acksig) {
+			psnet_rel_ack_buffer(rsocket, i);
+			continue;
+		}
+
+		if (!has_sack) {
+			continue;
+		}
+
+		int delta = (short)(rsocket->ssequence[i] - base);
+		if ((delta < 0) || ((delta < SACK_BITS) && (received & (1u << delta)))) {
+			psnet_rel_ack_buffer(rsocket, i);
+		} else if ((delta < highest) && rsocket->times_sent[i]) {
+			rsocket->sack_misses[i]++;
+
+			if (rsocket->sack_misses[i] == FAST_RETRANSMIT_MISSES) {
+				psnet_rel_on_loss(rsocket, rsocket->ssequence[i], false);
+				if (psnet_rel_send_buffer(rsocket, i) != SOCKET_ERROR) {
+					rsocket->fast_retransmits++;
+				}
+			}
+		}
+	}
+
+	psnet_rel_send_queued(rsocket);
+}
+
+/**
+ * Send an ACK for a packet
+ *
+ * If the packet came from a connected socket the ACK also reports every other packet we have received so the sender
+ * can resend lost packets early.
+ */
+void psnet_rel_send_ack(SOCKADDR *raddr, unsigned int sig, ubyte link_type, float time_sent, reliable_socket *rsocket = nullptr)
+{
+	int ret;
 	reliable_header ack_header;
 	ack_header.type = RNT_ACK;	
-	ack_header.data_len = sizeof(unsigned int);
+	ack_header.data_len = RELIABLE_ACK_SEQ_SIZE;
 	ack_header.send_time = time_sent;
 	ack_header.send_time = INTEL_FLOAT(&ack_header.send_time);
-	sig_tmp = INTEL_INT(sig);
-	memcpy(&ack_header.data,&sig_tmp,sizeof(unsigned int));
+	unsigned int seq = INTEL_INT(sig);
+	memcpy(ack_header.data + RELIABLE_ACK_SEQ_OFFSET, &seq, sizeof(seq));
+	if (rsocket != nullptr) {
+		unsigned int received = 0;
+		for (int i = 0; i < MAXNETBUFFERS; i++) {
+			if (rsocket->rbuffers[i]) {
+				auto delta = (ushort)(rsocket->rsequence[i] - rsocket->oursequence);
+				if (delta < SACK_BITS) {
+					received |= 1u << delta;
+				}
+			}
+		}
+
+		ack_header.data_len = RELIABLE_ACK_SIZE;
+		ushort base = INTEL_SHORT(rsocket->oursequence);
+		memcpy(ack_header.data + RELIABLE_ACK_BASE_OFFSET, &base, sizeof(base));
+		received = INTEL_INT(received);
+		memcpy(ack_header.data + RELIABLE_ACK_RECEIVED_OFFSET, &received, sizeof(received));
+	}
 	switch (link_type) {
 	case NET_TCP:
 		if(!Tcp_active){
@@ -995,7 +1253,8 @@ void psnet_rel_close_socket( PSNET_SOCKET_RELIABLE *sockp )
 		return;
 	}	
 
-	ml_printf("Closing socket %d",*sockp);
+	ml_printf("Closing socket %d (%u retransmits, %u fast retransmits, rtt %.3f)", *sockp, Reliable_sockets[*sockp].retransmits,
+		Reliable_sockets[*sockp].fast_retransmits, Reliable_sockets[*sockp].srtt);
 	
 	// go through every buffer and "free it up(tm)"
 	int i;
@@ -1070,51 +1329,36 @@ int psnet_rel_send(PSNET_SOCKET_RELIABLE socketid, ubyte *data, int length, int
 		return -1;
 	}
 	
-	// Add the new packet to the sending list and send it.
+	if(rsocket->connection_type != NET_TCP){
+		ml_string("Unknown protocol type in nw_SendReliable()!");
+		Int3();
+		return 0;
+	}
+	if(!Tcp_active){
+		return 0;
+	}
+
+	// Add the new packet to the sending list and send it if the congestion window allows it.
 	for(i=0;i<MAXNETBUFFERS;i++){
 		if(NULL==rsocket->sbuffers[i]){			
-			reliable_header send_header;
-			int send_this_packet=1;			
-			
 			rsocket->send_len[i] = length;
 			rsocket->sbuffers[i] = (reliable_net_sendbuffer *)vm_malloc(sizeof(reliable_net_sendbuffer));
 		
 			memcpy(rsocket->sbuffers[i]->buffer,data,length);	
 
-			send_header.seq = INTEL_SHORT( rsocket->theirsequence );
 			rsocket->ssequence[i] = rsocket->theirsequence;
-			
-			memcpy(send_header.data,data,length);
-			send_header.data_len = INTEL_SHORT( (ushort)length );
-			send_header.type = RNT_DATA;
-			send_header.send_time = psnet_get_time();
-			send_header.send_time = INTEL_FLOAT( &send_header.send_time ) ;
-					
-			if (send_this_packet){
-				switch ( rsocket->connection_type ){
-					case NET_TCP:
-						if(!Tcp_active){
-							return 0;
-						}
-						multi_rate_add(np_index, "tcp(h)", RELIABLE_PACKET_HEADER_ONLY_SIZE+rsocket->send_len[i]);
-						bytesout = SENDTO(Unreliable_socket, (char *)&send_header,RELIABLE_PACKET_HEADER_ONLY_SIZE+rsocket->send_len[i],0,&rsocket->addr,sizeof(SOCKADDR), PSNET_TYPE_RELIABLE);
-						break;
-					default:
-						ml_string("Unknown protocol type in nw_SendReliable()!");
-						Int3();
-						break;
-				}		
-			}
+			rsocket->times_sent[i] = 0;
+			rsocket->sack_misses[i] = 0;
+			rsocket->theirsequence++;
 
-			if((bytesout==SOCKET_ERROR)&&(WSAEWOULDBLOCK==WSAGetLastError())){
-				//This will cause it to try to send again next frame. (or sooner)
-				rsocket->timesent[i] = psnet_get_time()-(NETRETRYTIME*4);
-			} else {
-				rsocket->timesent[i] = psnet_get_time();
+			if(psnet_rel_in_flight(rsocket) >= (int)rsocket->cwnd){
+				// psnet_rel_work() sends it once enough of the earlier packets have been ACK'd
+				return 0;
 			}
-			
-						
-			rsocket->theirsequence++;
+
+			multi_rate_add(np_index, "tcp(h)", RELIABLE_PACKET_HEADER_ONLY_SIZE+rsocket->send_len[i]);
+			bytesout = psnet_rel_send_buffer(rsocket, i);
+
 			return bytesout;
 		}
 	}
@@ -1271,6 +1515,7 @@ void psnet_rel_work()
 						memcpy(&Reliable_sockets[i].addr ,&rcv_addr, sizeof(SOCKADDR));
 						Reliable_sockets[i].ping_pos = 0;
 						Reliable_sockets[i].num_ping_samples = 0;
+						psnet_rel_init_flow(&Reliable_sockets[i]);
 						Reliable_sockets[i].status = RNF_LIMBO;
 						Reliable_sockets[i].last_packet_received = psnet_get_time();
 						rsocket = &Reliable_sockets[i];
@@ -1355,19 +1600,8 @@ void psnet_rel_work()
 				}
 
 				// if this is an ack for a send buffer on the socket, kill the send buffer. its done
-				for(i=0; i<MAXNETBUFFERS; i++){
-					unsigned int *acksig = (unsigned int *)&rcv_buff.data;
-					if(rsocket){
-						if(rsocket->sbuffers[i]){
-							if(rsocket->ssequence[i] == INTEL_INT(*acksig)){								
-								Assert(rsocket->sbuffers[i] != NULL);
-								vm_free(rsocket->sbuffers[i]);
-								rsocket->sbuffers[i] = NULL;	
-								rsocket->ssequence[i] = 0;
-							}
-						}
-					}
-				}
+				psnet_rel_update_rtt(rsocket, rsocket->last_packet_received - rcv_buff.send_time);
+				psnet_rel_process_ack(rsocket, &rcv_buff);
 				//remove that packet from the send buffer
 				rsocket->last_packet_received = psnet_get_time();
 				continue;
@@ -1424,7 +1658,7 @@ void psnet_rel_work()
 						}
 					}
 				}
-				psnet_rel_send_ack(&rsocket->addr, rcv_buff.seq, link_type, rcv_buff.send_time);		
+				psnet_rel_send_ack(&rsocket->addr, rcv_buff.seq, link_type, rcv_buff.send_time, rsocket);
 			}
 			
 		}
@@ -1450,40 +1684,30 @@ void psnet_rel_work()
 		}
 		
 		if(rsocket->status == RNF_CONNECTED){
-			float retry_packet_time;
-			if((rsocket->mean_ping==0) || (rsocket->mean_ping > (NETRETRYTIME*4))){
-				retry_packet_time = NETRETRYTIME;
-			} else {
-				if(rsocket->mean_ping<MIN_NET_RETRYTIME) {
-					retry_packet_time = (float)MIN_NET_RETRYTIME;					
-				} else {
-					retry_packet_time = ((float)(float)rsocket->mean_ping * (float)1.25);					
-				}
-			}
+			bool timed_out = false;
+
 			//Iterate through send buffers.  
 			for(i=0;i<MAXNETBUFFERS;i++){
 				// send again
-				if((rsocket->sbuffers[i]) && (fl_abs((psnet_get_time() - rsocket->timesent[i])) >= retry_packet_time)) {
-					reliable_header send_header;					
-					send_header.send_time = psnet_get_time();
-					send_header.send_time = INTEL_FLOAT( &send_header.send_time );
-					send_header.seq = INTEL_SHORT( rsocket->ssequence[i] );
-					memcpy(send_header.data,rsocket->sbuffers[i]->buffer,rsocket->send_len[i]);
-					send_header.data_len = INTEL_SHORT( (ushort)rsocket->send_len[i] );
-					send_header.type = RNT_DATA;
-					rcode = SENDTO(Unreliable_socket, (char *)&send_header, RELIABLE_PACKET_HEADER_ONLY_SIZE + rsocket->send_len[i], 0, &rsocket->addr, sizeof(SOCKADDR), PSNET_TYPE_RELIABLE);
-
-					if((rcode == SOCKET_ERROR) && (WSAEWOULDBLOCK == WSAGetLastError())){
-						//The packet didn't get sent, flag it to try again next frame
-						rsocket->timesent[i] = psnet_get_time()-(NETRETRYTIME*4);
-					} else {
-						rsocket->last_packet_sent = psnet_get_time();
-						rsocket->timesent[i] = psnet_get_time();
+				if((rsocket->sbuffers[i]) && rsocket->times_sent[i] && (fl_abs((psnet_get_time() - rsocket->timesent[i])) >= rsocket->rto)) {
+					if(!timed_out){
+						psnet_rel_on_loss(rsocket, rsocket->ssequence[i], true);
+						timed_out = true;
+					}
+
+					if(psnet_rel_send_buffer(rsocket, i) != SOCKET_ERROR){
+						rsocket->retransmits++;
 					}
-					
-				}//getcwd
+				}
+			}
+
+			// back off until a new round trip time sample arrives in case the peer is overloaded
+			if(timed_out){
+				rsocket->rto = MIN(rsocket->rto * 2.0f, MAX_NET_RETRYTIME);
 			}
 
+			psnet_rel_send_queued(rsocket);
+
 			if((rsocket->status == RNF_CONNECTED) && (fl_abs((psnet_get_time() - rsocket->last_packet_sent)) > NETHEARTBEATTIME)) {
 				reliable_header send_header;				
 				send_header.send_time = psnet_get_time();
@@ -1669,6 +1893,7 @@ void psnet_rel_connect_to_server(PSNET_SOCKET *socket, net_addr *server_addr)
 								memcpy(&Reliable_sockets[i].m_net_addr,&d3_rcv_addr,sizeof(net_addr));
 								Reliable_sockets[i].last_packet_received = psnet_get_time();
 								memcpy(&Reliable_sockets[i].addr,&rcv_addr,sizeof(SOCKADDR));
+								psnet_rel_init_flow(&Reliable_sockets[i]);
 								Reliable_sockets[i].status = RNF_LIMBO;
 								*socket = i;
 								ml_string("Successfully connected to server in nw_ConnectToServer().");
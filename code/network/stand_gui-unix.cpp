@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <iterator>
 #include <cstddef>
+#include <memory>
 
 // Copy-Paste from http://www.cplusplus.com/faq/sequences/strings/split/#c-tokenizer
 struct split_struct {
@@ -172,11 +173,15 @@ std::string base64_decode(std::string const& encoded_string) {
 
 #include "globalincs/pstypes.h"
 #include "gamesequence/gamesequence.h"
+#include "io/timer.h"
 #include "playerman/player.h"
 #include "mission/missiongoals.h"
+#include "object/object.h"
 #include "ship/ship.h"
+#include "weapon/weapon.h"
 #include "osapi/osapi.h"
 #include "osapi/osregistry.h"
+#include "tracing/tracing.h"
 
 #include "network/multi.h"
 #include "network/multiutil.h"
@@ -185,6 +190,7 @@ std::string base64_decode(std::string const& encoded_string) {
 #include "network/multi_kick.h"
 #include "network/multi_endgame.h"
 #include "network/multi_fstracker.h"
+#include "network/multi_rate.h"
 
 #include "mongoose.h"
 #include "jansson.h"
@@ -369,11 +375,201 @@ std::list<mission_goal> webuiMissionGoals;
 LogResource webapi_chatLog;
 LogResource webapi_debugLog;
 
+// =============================================================================
+// Metrics
+//
+// The game thread gathers the metrics in std_do_gui_frame() and publishes them as an immutable snapshot. The web server
+// threads only ever load the latest snapshot so a scrape neither waits on nor holds up the game thread.
+
+const double metricsFrameTimeBuckets[] = { 0.005, 0.010, 0.0166, 0.025, 0.0333, 0.050, 0.100, 0.250, 1.0 };
+
+// how often a new snapshot is published (ms)
+const int METRICS_PUBLISH_INTERVAL = 250;
+
+struct MetricsPlayer {
+    short id;
+    SCP_string callsign;
+    int ping;
+
+    uint objectUpdatePackets;
+    uint objectUpdateBytes;
+
+    bool hasRate;
+    int rateBytes;
+    float rateBytesPerSecond;
+};
+
+struct MetricsSnapshot {
+    std::uint64_t frameTimeBuckets[ARRAY_SIZE(metricsFrameTimeBuckets)];
+    std::uint64_t frameCount;
+    double frameTimeSum;
+
+    float fps;
+    int gameState;
+    int numObjects;
+    int numShips;
+    int numWeapons;
+
+    SCP_vector<MetricsPlayer> players;
+    SCP_vector<tracing::scope_statistics> scopes;
+};
+
+// only touched by the game thread
+MetricsSnapshot metricsCurrent;
+std::uint64_t metricsLastFrameTime = 0;
+int metricsPublishStamp = -1;
+
+// only accessed through std::atomic_load/std::atomic_store
+std::shared_ptr<const MetricsSnapshot> metricsPublished;
+
+static void metricsUpdate() {
+    std::uint64_t now = timer_get_microseconds();
+
+    if (metricsLastFrameTime != 0) {
+        double frameTime = (double) (now - metricsLastFrameTime) / 1000000.0;
+
+        for (size_t i = 0; i < ARRAY_SIZE(metricsFrameTimeBuckets); i++) {
+            if (frameTime <= metricsFrameTimeBuckets[i]) {
+                metricsCurrent.frameTimeBuckets[i]++;
+            }
+        }
+        metricsCurrent.frameCount++;
+        metricsCurrent.frameTimeSum += frameTime;
+    }
+    metricsLastFrameTime = now;
+
+    if ((metricsPublishStamp != -1) && !timestamp_elapsed(metricsPublishStamp)) {
+        return;
+    }
+    metricsPublishStamp = timestamp(METRICS_PUBLISH_INTERVAL);
+
+    metricsCurrent.fps = webui_fps;
+    metricsCurrent.gameState = Netgame.game_state;
+    metricsCurrent.numObjects = Num_objects;
+    metricsCurrent.numShips = ship_get_num_ships();
+    metricsCurrent.numWeapons = Num_weapons;
+
+    metricsCurrent.players.clear();
+    for (int idx = 0; idx < MAX_PLAYERS; idx++) {
+        if (!MULTI_CONNECTED(Net_players[idx]) || (Net_player == &Net_players[idx])) {
+            continue;
+        }
+        net_player* p = &Net_players[idx];
+
+        MetricsPlayer player;
+        player.id = p->player_id;
+        player.callsign = (p->m_player != NULL) ? p->m_player->callsign : "";
+        player.ping = p->s_info.ping.ping_avg;
+        player.objectUpdatePackets = p->s_info.oo_packets_sent;
+        player.objectUpdateBytes = p->s_info.oo_bytes_sent;
+        player.hasRate = multi_rate_get_totals(idx, &player.rateBytes, &player.rateBytesPerSecond) != 0;
+
+        metricsCurrent.players.push_back(player);
+    }
+
+    metricsCurrent.scopes = tracing::get_scope_statistics();
+
+    std::atomic_store(&metricsPublished, std::shared_ptr<const MetricsSnapshot>(new MetricsSnapshot(metricsCurrent)));
+}
+
+static std::string metricsEscapeLabel(const SCP_string& value) {
+    std::string escaped;
+
+    for (SCP_string::const_iterator iter = value.begin(); iter != value.end(); ++iter) {
+        if (*iter == '\\' || *iter == '"') {
+            escaped += '\\';
+            escaped += *iter;
+        } else if (*iter == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += *iter;
+        }
+    }
+
+    return escaped;
+}
+
+static void metricsHeader(std::stringstream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n";
+    out << "# TYPE " << name << " " << type << "\n";
+}
+
+// Formats a snapshot in the Prometheus text exposition format
+static std::string metricsRender(const MetricsSnapshot& m) {
+    std::stringstream out;
+    out.precision(12);
+
+    metricsHeader(out, "fs2_frame_time_seconds", "histogram", "Wall clock time between two server frames.");
+    for (size_t i = 0; i < ARRAY_SIZE(metricsFrameTimeBuckets); i++) {
+        out << "fs2_frame_time_seconds_bucket{le=\"" << metricsFrameTimeBuckets[i] << "\"} " << m.frameTimeBuckets[i] << "\n";
+    }
+    out << "fs2_frame_time_seconds_bucket{le=\"+Inf\"} " << m.frameCount << "\n";
+    out << "fs2_frame_time_seconds_sum " << m.frameTimeSum << "\n";
+    out << "fs2_frame_time_seconds_count " << m.frameCount << "\n";
+
+    metricsHeader(out, "fs2_fps", "gauge", "Frame rate of the server.");
+    out << "fs2_fps " << m.fps << "\n";
+
+    metricsHeader(out, "fs2_game_state", "gauge", "Current netgame state.");
+    out << "fs2_game_state " << m.gameState << "\n";
+
+    metricsHeader(out, "fs2_objects", "gauge", "Number of objects in the mission.");
+    out << "fs2_objects " << m.numObjects << "\n";
+
+    metricsHeader(out, "fs2_ships", "gauge", "Number of ships in the mission.");
+    out << "fs2_ships " << m.numShips << "\n";
+
+    metricsHeader(out, "fs2_weapons", "gauge", "Number of weapons in the mission.");
+    out << "fs2_weapons " << m.numWeapons << "\n";
+
+    metricsHeader(out, "fs2_player_ping_milliseconds", "gauge", "Average ping of a player.");
+    for (SCP_vector<MetricsPlayer>::const_iterator p = m.players.begin(); p != m.players.end(); ++p) {
+        out << "fs2_player_ping_milliseconds{id=\"" << p->id << "\",callsign=\"" << metricsEscapeLabel(p->callsign) << "\"} " << p->ping << "\n";
+    }
+
+    metricsHeader(out, "fs2_player_object_update_packets_total", "counter", "Object update packets sent to a player.");
+    for (SCP_vector<MetricsPlayer>::const_iterator p = m.players.begin(); p != m.players.end(); ++p) {
+        out << "fs2_player_object_update_packets_total{id=\"" << p->id << "\",callsign=\"" << metricsEscapeLabel(p->callsign) << "\"} " << p->objectUpdatePackets << "\n";
+    }
+
+    metricsHeader(out, "fs2_player_object_update_bytes_total", "counter", "Object update bytes sent to a player.");
+    for (SCP_vector<MetricsPlayer>::const_iterator p = m.players.begin(); p != m.players.end(); ++p) {
+        out << "fs2_player_object_update_bytes_total{id=\"" << p->id << "\",callsign=\"" << metricsEscapeLabel(p->callsign) << "\"} " << p->objectUpdateBytes << "\n";
+    }
+
+    // the detailed rate information is only gathered by builds with MULTI_RATE
+    metricsHeader(out, "fs2_player_rate_bytes_total", "counter", "Bytes of all tracked data types sent to a player.");
+    for (SCP_vector<MetricsPlayer>::const_iterator p = m.players.begin(); p != m.players.end(); ++p) {
+        if (p->hasRate) {
+            out << "fs2_player_rate_bytes_total{id=\"" << p->id << "\",callsign=\"" << metricsEscapeLabel(p->callsign) << "\"} " << p->rateBytes << "\n";
+        }
+    }
+
+    metricsHeader(out, "fs2_player_rate_bytes_per_second", "gauge", "Average bytes per second of all tracked data types sent to a player.");
+    for (SCP_vector<MetricsPlayer>::const_iterator p = m.players.begin(); p != m.players.end(); ++p) {
+        if (p->hasRate) {
+            out << "fs2_player_rate_bytes_per_second{id=\"" << p->id << "\",callsign=\"" << metricsEscapeLabel(p->callsign) << "\"} " << p->rateBytesPerSecond << "\n";
+        }
+    }
+
+    metricsHeader(out, "fs2_trace_scope_seconds_total", "counter", "Time spent in a traced scope on the main thread.");
+    for (SCP_vector<tracing::scope_statistics>::const_iterator s = m.scopes.begin(); s != m.scopes.end(); ++s) {
+        out << "fs2_trace_scope_seconds_total{scope=\"" << metricsEscapeLabel(s->category->getName()) << "\"} " << ((double) s->total_duration / 1000000000.0) << "\n";
+    }
+
+    metricsHeader(out, "fs2_trace_scope_calls_total", "counter", "Number of times a traced scope was entered on the main thread.");
+    for (SCP_vector<tracing::scope_statistics>::const_iterator s = m.scopes.begin(); s != m.scopes.end(); ++s) {
+        out << "fs2_trace_scope_calls_total{scope=\"" << metricsEscapeLabel(s->category->getName()) << "\"} " << s->count << "\n";
+    }
+
+    return out.str();
+}
+
 enum HttpStatuscode {
     HTTP_200_OK, HTTP_401_UNAUTHORIZED, HTTP_404_NOT_FOUND, HTTP_500_INTERNAL_SERVER_ERROR
 };
 
-static void sendResponse(mg_connection *conn, std::string const& data, HttpStatuscode status) {
+static void sendResponse(mg_connection *conn, std::string const& data, HttpStatuscode status, const char *contentType = "application/json") {
     std::stringstream headerStream;
 
     headerStream << "HTTP/1.0 ";
@@ -395,7 +591,7 @@ static void sendResponse(mg_connection *conn, std::string const& data, HttpStatu
 
     if (data.length() > 0) {
         headerStream << "Content-Length: " << data.length() << "\r\n";
-        headerStream << "Content-Type: application/json\r\n\r\n";
+        headerStream << "Content-Type: " << contentType << "\r\n\r\n";
     }
 
     std::string resultString;
@@ -700,6 +896,37 @@ struct Resource resources[] = {
     { "api/1/chat", "POST", &chatPost },
     { "api/1/debug", "GET", &debugGet } };
 
+static bool isAuthorized(mg_connection *conn) {
+    std::string userNameAndPassword;
+
+    userNameAndPassword += Multi_options_g.webapiUsername.c_str();
+    userNameAndPassword += ":";
+    userNameAndPassword += Multi_options_g.webapiPassword.c_str();
+
+    std::string basicAuthValue = "Basic ";
+
+    basicAuthValue += base64_encode(reinterpret_cast<const unsigned char*>(userNameAndPassword.c_str()), userNameAndPassword.length());
+
+    const char* authValue = mg_get_header(conn, "Authorization");
+    return authValue != NULL && strcmp(authValue, basicAuthValue.c_str()) == 0;
+}
+
+// Unlike the other resources this doesn't take webapi_dataMutex, it only reads the last published snapshot
+static void metricsRequest(mg_connection *conn) {
+    if (!isAuthorized(conn)) {
+        sendResponse(conn, std::string(), HTTP_401_UNAUTHORIZED);
+        return;
+    }
+
+    std::shared_ptr<const MetricsSnapshot> snapshot = std::atomic_load(&metricsPublished);
+
+    if (snapshot) {
+        sendResponse(conn, metricsRender(*snapshot), HTTP_200_OK, "text/plain; version=0.0.4");
+    } else {
+        sendResponse(conn, metricsRender(MetricsSnapshot()), HTTP_200_OK, "text/plain; version=0.0.4");
+    }
+}
+
 static bool webserverApiRequest(mg_connection *conn, const mg_request_info *ri) {
     SCP_string resourcePath(ri->uri);
 
@@ -711,6 +938,11 @@ static bool webserverApiRequest(mg_connection *conn, const mg_request_info *ri)
 
     SCP_string method(ri->request_method);
 
+    if (pathParts.size() == 1 && pathParts[0] == "metrics" && method == "GET") {
+        metricsRequest(conn);
+        return true;
+    }
+
     for (size_t i = 0; i < ARRAY_SIZE(resources); i++) {
         Resource* r = &resources[i];
         SCP_vector<SCP_string> resourcePathParts;
@@ -732,18 +964,7 @@ static bool webserverApiRequest(mg_connection *conn, const mg_request_info *ri)
 
             if (pathMatch && r->method == method) {
 
-                std::string userNameAndPassword;
-
-                userNameAndPassword += Multi_options_g.webapiUsername.c_str();
-                userNameAndPassword += ":";
-                userNameAndPassword += Multi_options_g.webapiPassword.c_str();
-
-                std::string basicAuthValue = "Basic ";
-
-                basicAuthValue += base64_encode(reinterpret_cast<const unsigned char*>(userNameAndPassword.c_str()), userNameAndPassword.length());
-
-                const char* authValue = mg_get_header(conn, "Authorization");
-                if (authValue == NULL || strcmp(authValue, basicAuthValue.c_str()) != 0) {
+                if (!isAuthorized(conn)) {
                     sendResponse(conn, std::string(), HTTP_401_UNAUTHORIZED);
                     return true;
                 }
@@ -821,6 +1042,9 @@ void webapi_shutdown() {
 
 void std_init_standalone() {
     atexit(webapi_shutdown);
+
+    // cheap enough to always have around for the metrics resource
+    tracing::enable_scope_statistics();
 }
 
 void std_configLoaded(multi_global_options *options) {
@@ -886,6 +1110,8 @@ void std_set_standalone_fps(float fps) {
 }
 
 void std_do_gui_frame() {
+    metricsUpdate();
+
     SDL_mutexP(webapi_dataMutex);
 
     webapi_netgameInfo = Netgame;
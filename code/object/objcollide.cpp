@@ -977,7 +977,7 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
     TRACE_SCOPE(tracing::FindOverlapColliders);
 
     bool first_not_added = true;
-    SCP_vector<int> overlappers;
+    SCP_frame_vector<int> overlappers;
 
     for (int in_index : list){
         bool overlapped = false;
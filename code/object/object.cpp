@@ -70,6 +70,7 @@ int Num_objects=-1;
 int Highest_object_index=-1;
 int Highest_ever_object_index=0;
 int Object_next_signature = 1;	//0 is bogus, start at 1
+int Object_list_version = 0;
 int Object_inited = 0;
 int Show_waypoints = 0;
 
@@ -330,6 +331,87 @@ static void on_script_state_destroy(lua_State*) {
 	}
 }
 
+// Dense arrays of the object numbers of all ships, weapons and debris pieces. Objects of other types are not tracked.
+static SCP_vector<int> Obj_type_lists[3];
+// Where each object is stored in its type list or -1 if it is in none of them
+static int Obj_type_list_pos[MAX_OBJECTS];
+// The list each object is stored in since FRED changes the type of objects behind our back
+static int Obj_type_list_which[MAX_OBJECTS];
+
+static int obj_type_list_index(int type)
+{
+	switch (type) {
+	case OBJ_SHIP:
+		return 0;
+	case OBJ_WEAPON:
+		return 1;
+	case OBJ_DEBRIS:
+		return 2;
+	default:
+		return -1;
+	}
+}
+
+static void obj_type_list_init()
+{
+	// Reserve everything up front so the lists never move while someone walks them
+	Obj_type_lists[0].reserve(MAX_SHIPS);
+	Obj_type_lists[1].reserve(MAX_WEAPONS);
+	Obj_type_lists[2].reserve(MAX_DEBRIS_PIECES);
+
+	for (auto& list : Obj_type_lists) {
+		list.clear();
+	}
+
+	for (int i = 0; i < MAX_OBJECTS; ++i) {
+		Obj_type_list_pos[i] = -1;
+		Obj_type_list_which[i] = -1;
+	}
+}
+
+static void obj_type_list_add(int objnum)
+{
+	int which = obj_type_list_index(Objects[objnum].type);
+	if (which < 0) {
+		return;
+	}
+
+	Assert(Obj_type_list_pos[objnum] < 0);
+
+	auto& list = Obj_type_lists[which];
+	Obj_type_list_pos[objnum] = (int)list.size();
+	Obj_type_list_which[objnum] = which;
+	list.push_back(objnum);
+}
+
+static void obj_type_list_remove(int objnum)
+{
+	int pos = Obj_type_list_pos[objnum];
+	if (pos < 0) {
+		return;
+	}
+
+	auto& list = Obj_type_lists[Obj_type_list_which[objnum]];
+	Assert(list[pos] == objnum);
+
+	// Move the last entry into the hole so the list stays dense
+	int last = list.back();
+	list[pos] = last;
+	Obj_type_list_pos[last] = pos;
+	list.pop_back();
+
+	Obj_type_list_pos[objnum] = -1;
+	Obj_type_list_which[objnum] = -1;
+}
+
+const SCP_vector<int>& obj_type_list(int type)
+{
+	int which = obj_type_list_index(type);
+	Assertion(which >= 0, "Only ships, weapons and debris have a type list, type %d was requested!", type);
+
+	return Obj_type_lists[which];
+}
+
 /**
  * Sets up the free list & init player & whatever else
  */
@@ -356,8 +438,11 @@ void obj_init()
 
 	Object_next_signature = 1;	//0 is invalid, others start at 1
 	Num_objects = 0;
+	Object_list_version++;
 	Highest_object_index = 0;
 
+	obj_type_list_init();
+
 	obj_reset_colliders();
 
 	Script_system.OnStateDestroy.add(on_script_state_destroy);
@@ -417,6 +502,7 @@ int obj_allocate(void)
 
 	// increment counter
 	Num_objects++;
+	Object_list_version++;
 
 	if (Num_objects > num_objects_hwm) {
 		num_objects_hwm = Num_objects;
@@ -462,6 +548,9 @@ void obj_free(int objnum)
 
 	// decrement counter
 	Num_objects--;
+	Object_list_version++;
+
+	obj_type_list_remove(objnum);
 
 	Objects[objnum].type = OBJ_NONE;
 
@@ -528,6 +617,8 @@ int obj_create(ubyte type,int parent_obj,int instance, matrix * orient,
 	obj->n_quadrants = DEFAULT_SHIELD_SECTIONS; // Might be changed by the ship creation code
 	obj->shield_quadrant.resize(obj->n_quadrants);
 
+	obj_type_list_add(objnum);
+
 	return objnum;
 }
 
@@ -583,6 +674,9 @@ void obj_delete(int objnum)
 				}
 				moveup = GET_NEXT(moveup);
 			}
+			obj_type_list_remove(objnum);
+			// the ghost is no ship anymore, so anything cached about the ships has to be rebuilt
+			Object_list_version++;
 
 			physics_init(&objp->phys_info);
 			obj_snd_delete_type(OBJ_INDEX(objp));
@@ -683,6 +777,7 @@ void obj_merge_created_list(void)
 	object *objp = GET_FIRST(&obj_create_list);
 	while( objp !=END_OF_LIST(&obj_create_list) )	{
 		list_remove( obj_create_list, objp );
+		Object_list_version++;
 
 		// Add it to the object pairs array
 		obj_add_collider(OBJ_INDEX(objp));
@@ -1408,6 +1503,78 @@ DCF_BOOL( collisions, Collisions_enabled )
 
 MONITOR( NumObjects )
 
+// Weapons flying in a straight line are moved in batches, see obj_move_all()
+static SCP_vector<object*> Physics_batch_objects;
+static SCP_vector<vec3d> Physics_batch_positions;
+static SCP_vector<vec3d> Physics_batch_velocities;
+
+// Big enough to keep the vector units busy, small enough that the objects are still cached when they are post-moved
+static const size_t OBJ_PHYSICS_BATCH_SIZE = 256;
+
+/**
+ * Returns true if obj_move_call_physics() would do nothing for this object but move it along its velocity
+ */
+static bool obj_physics_can_batch(object *objp)
+{
+	if ((objp->type != OBJ_WEAPON) || !(objp->flags[Object::Object_Flags::Physics]) || !(objp->phys_info.flags & PF_CONST_VEL)) {
+		return false;
+	}
+
+	if (physics_paused || (The_mission.flags[Mission::Mission_Flags::Mission_2d])) {
+		return false;
+	}
+
+	if (objp->flags[Object::Object_Flags::Immobile] && objp->hull_strength > 0.0f) {
+		return false;
+	}
+
+	if (MULTIPLAYER_MASTER && (objp->flags[Object::Object_Flags::Just_updated])) {
+		return false;
+	}
+
+	if (multi_oo_is_interp_object(objp)) {
+		return false;
+	}
+
+	weapon *wp = &Weapons[objp->instance];
+
+	// corkscrew missiles move themselves around in their pre- and post-move
+	return !(wp->weapon_flags[Weapon::Weapon_Flags::Dead_in_water]) && (wp->cscrew_index < 0);
+}
+
+/**
+ * Moves the objects gathered by obj_move_all() and does their post-move in the order they were gathered
+ */
+static void obj_move_physics_batch(float frametime)
+{
+	if (Physics_batch_objects.empty()) {
+		return;
+	}
+
+	auto count = Physics_batch_objects.size();
+
+	Physics_batch_positions.resize(count);
+	Physics_batch_velocities.resize(count);
+
+	for (size_t i = 0; i < count; ++i) {
+		Physics_batch_positions[i] = Physics_batch_objects[i]->pos;
+		Physics_batch_velocities[i] = Physics_batch_objects[i]->phys_info.vel;
+	}
+
+	{
+		TRACE_SCOPE(tracing::Physics);
+		physics_sim_const_vel_batch(Physics_batch_positions.data(), Physics_batch_velocities.data(), count, frametime);
+	}
+
+	for (size_t i = 0; i < count; ++i) {
+		Physics_batch_objects[i]->pos = Physics_batch_positions[i];
+
+		obj_move_all_post(Physics_batch_objects[i], frametime);
+	}
+
+	Physics_batch_objects.clear();
+}
+
 /**
  * Move all objects for the current frame
  */
@@ -1416,7 +1583,7 @@ void obj_move_all(float frametime)
 	TRACE_SCOPE(tracing::MoveObjects);
 
 	object *objp;	
-	SCP_vector<object*> cmeasure_list;
+	SCP_frame_vector<object*> cmeasure_list;
 	const bool global_cmeasure_timer = (Cmeasures_homing_check > 0);
 
 	Assertion(Cmeasures_homing_check >= 0, "Cmeasures_homing_check is %d in obj_move_all(); it should never be negative. Get a coder!\n", Cmeasures_homing_check);
@@ -1438,6 +1605,10 @@ void obj_move_all(float frametime)
 
 	MONITOR_INC( NumObjects, Num_objects );	
 
+	if (!physics_paused && !ai_paused) {
+		ai_think_all();
+	}
+
 	for (objp = GET_FIRST(&obj_used_list); objp != END_OF_LIST(&obj_used_list); objp = GET_NEXT(objp)) {
 		// skip objects which should be dead
 		if (objp->flags[Object::Object_Flags::Should_be_dead]) {
@@ -1473,6 +1644,13 @@ void obj_move_all(float frametime)
 			obj_check_object( objp );
 #endif
 
+		// Runs of weapons which only fly straight ahead are pre-moved one by one, then moved together and post-moved
+		// one by one again. Everything else has to wait until the weapons before it are completely done.
+		bool batch_physics = obj_physics_can_batch(objp);
+		if (!batch_physics) {
+			obj_move_physics_batch(frametime);
+		}
+
 		// pre-move
 		obj_move_all_pre(objp, frametime);
 
@@ -1480,6 +1658,15 @@ void obj_move_all(float frametime)
 		objp->last_pos = cur_pos;
 		objp->last_orient = objp->orient;
 
+		if (batch_physics) {
+			Physics_batch_objects.push_back(objp);
+
+			if (Physics_batch_objects.size() >= OBJ_PHYSICS_BATCH_SIZE) {
+				obj_move_physics_batch(frametime);
+			}
+			continue;
+		}
+
 		// Goober5000 - skip objects which don't move, but only until they're destroyed
 		if (!(objp->flags[Object::Object_Flags::Immobile] && objp->hull_strength > 0.0f)) {
 			// if this is an object which should be interpolated in multiplayer, do so
@@ -1512,6 +1699,8 @@ void obj_move_all(float frametime)
 		}
 	}
 
+	obj_move_physics_batch(frametime);
+
 	// Now that we've moved all the objects, move all the models that use intrinsic rotations.  We do that here because we already handled the
 	// ship models in obj_move_all_post, and this is more or less conceptually close enough to move the rest.  (Originally all models
 	// were intrinsic-rotated here, but for sequencing reasons, intrinsic ship rotations must happen along with regular ship rotations.)
@@ -198,6 +198,10 @@ extern int Show_waypoints;
 extern int Object_next_signature;		
 extern int Num_objects;
 
+// Changes whenever an object is created or freed or moved from the create list to the used list. Anything that depends
+// on which objects exist can be cached as long as this stays the same.
+extern int Object_list_version;
+
 extern object Objects[];
 extern int Highest_object_index;		//highest objnum
 extern int Highest_ever_object_index;
@@ -251,6 +255,46 @@ void obj_delete_all();
 // should only be used by the editor!
 void obj_merge_created_list(void);
 
+/**
+ * @brief The object numbers of all ships, weapons or debris pieces in no particular order
+ *
+ * Unlike obj_used_list and Ship_obj_list the numbers are stored next to each other so walking them does not chase
+ * pointers through the whole object array. Objects are added by obj_create() (so they show up before they are merged
+ * into obj_used_list) and removed by obj_free() which moves the last entry into their place. Objects created while a
+ * list is walked by index are visited as well. Objects must not be freed while a list is walked.
+ *
+ * @param type OBJ_SHIP, OBJ_WEAPON or OBJ_DEBRIS
+ */
+const SCP_vector<int>& obj_type_list(int type);
+
+/**
+ * @brief Walks one of the lists of obj_type_list() and hands out the objects
+ *
+ * Usage: for (auto objp : obj_type_range(OBJ_SHIP)) { ... }
+ */
+class obj_type_range {
+	const SCP_vector<int>* _list;
+
+  public:
+	class iterator {
+		const SCP_vector<int>* _list;
+		size_t _index;
+
+	  public:
+		iterator(const SCP_vector<int>* list, size_t index) : _list(list), _index(index) {}
+
+		object* operator*() const { return &Objects[(*_list)[_index]]; }
+		iterator& operator++() { ++_index; return *this; }
+		// Compares against the current size so objects created during the walk are visited as well
+		bool operator!=(const iterator& other) const { return _index < other._list->size(); }
+	};
+
+	explicit obj_type_range(int type) : _list(&obj_type_list(type)) {}
+
+	iterator begin() const { return iterator(_list, 0); }
+	iterator end() const { return iterator(_list, 0); }
+};
+
 // recalculate object pairs for an object
 #define OBJ_RECALC_PAIRS(obj_to_reset)		do {	obj_set_flags(obj_to_reset, obj_to_reset->flags - Object::Object_Flags::Collides); obj_set_flags(obj_to_reset, obj_to_reset->flags + Object::Object_Flags::Collides); } while(false);
 
@@ -27,6 +27,7 @@
 #include "render/batching.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/parallel.h"
 #include "weapon/weapon.h"
 #include "decals/decals.h"
 
@@ -109,6 +110,16 @@ SCP_vector<sorted_obj> Sorted_objects;
 SCP_vector<object*> effect_ships; 
 SCP_vector<object*> transparent_objects;
 bool object_had_transparency = false;
+
+// The objects obj_render_queue_all() considers for rendering and whether they passed culling
+static SCP_vector<object*> Render_candidates;
+static SCP_vector<ubyte> Render_candidate_visible;
+
+// The draw list of obj_render_queue_all() is kept between frames so its containers keep their memory
+static model_draw_list Render_scene;
+
+// Culling a single object is cheap so it is only worth handing off larger groups of objects
+static const size_t OBJ_CULL_MIN_CHUNK_SIZE = 128;
 // Used to (fairly) quicky find the 8 extreme
 // points around an object.
 vec3d check_offsets[8] = { 
@@ -129,6 +140,7 @@ vec3d check_offsets[8] = {
 // This routine could possibly be optimized.  Right now, for an
 // offscreen object, it has to rotate 8 points to determine it's
 // offscreen.  Not the best considering we're looking at a sphere.
+// This only reads the view state so it is safe to call from several threads at once.
 int obj_in_view_cone( object * objp )
 {
 	int i;
@@ -140,7 +152,11 @@ int obj_in_view_cone( object * objp )
 
 	for (i=0; i<8; i++ ) {
 		vm_vec_scale_add( &pt, &objp->pos, &check_offsets[i], objp->radius );
-		codes=g3_rotate_vector(&tmp,&pt);
+
+		// Same as g3_rotate_vector() but without touching the rotation counter
+		vm_vec_sub2( &pt, &View_position );
+		vm_vec_rotate( &tmp, &pt, &View_matrix );
+		codes=g3_code_vector(&tmp);
 		if ( !codes ) {
 			//mprintf(( "A point is inside, so render it.\n" ));
 			return 1;		// this point is in, so return 1
@@ -322,6 +338,26 @@ void obj_render_all(const std::function<void(object*)>& render_function, bool *d
 	batching_render_all(true);
 }
 
+// Checks if an object is in view and not hidden by the nebula
+static bool obj_render_is_visible(object *objp, bool full_neb)
+{
+	if ( !obj_in_view_cone(objp) ) {
+		return false;
+	}
+
+	if ( full_neb ) {
+		vec3d to_obj;
+		vm_vec_sub( &to_obj, &objp->pos, &Eye_position );
+		float z = vm_vec_dot( &Eye_matrix.vec.fvec, &to_obj );
+
+		if ( neb2_skip_render(objp, z) ){
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void obj_render_queue_all()
 {
 	GR_DEBUG_SCOPE("Render all objects");
@@ -329,7 +365,7 @@ void obj_render_queue_all()
 
 	object *objp;
 	int i;
-	model_draw_list scene;
+	model_draw_list &scene = Render_scene;
 
 	objp = Objects;
 
@@ -339,35 +375,46 @@ void obj_render_queue_all()
 
 	bool full_neb = is_full_nebula();
 
+	Render_candidates.clear();
+
 	for ( i = 0; i <= Highest_object_index; i++,objp++ ) {
 		if ( (objp->type != OBJ_NONE) && ( objp->flags [Object::Object_Flags::Renders] ) )	{
             objp->flags.remove(Object::Object_Flags::Was_rendered);
 
-			if ( !obj_in_view_cone(objp) ) {
-				continue;
-			}
+			Render_candidates.push_back(objp);
+		}
+	}
 
-			if ( full_neb ) {
-				vec3d to_obj;
-				vm_vec_sub( &to_obj, &objp->pos, &Eye_position );
-				float z = vm_vec_dot( &Eye_matrix.vec.fvec, &to_obj );
+	// Culling only reads the object and view state so it is spread over all cores. The results are stored per object so
+	// the objects are still queued in the same order as before.
+	Render_candidate_visible.resize(Render_candidates.size());
 
-				if ( neb2_skip_render(objp, z) ){
-					continue;
-				}
-			}
+	util::parallel_for(Render_candidates.size(), OBJ_CULL_MIN_CHUNK_SIZE, [full_neb](size_t begin, size_t end) {
+		for (auto k = begin; k < end; ++k) {
+			Render_candidate_visible[k] = obj_render_is_visible(Render_candidates[k], full_neb) ? 1 : 0;
+		}
+	});
 
+	// Queueing modifies state shared by all objects using the same model (and runs the scripting hooks) so it stays
+	// on this thread
+	for ( size_t k = 0; k < Render_candidates.size(); ++k ) {
+		if ( !Render_candidate_visible[k] ) {
+			continue;
+		}
 
-			if ( (objp->type == OBJ_SHIP) && Ships[objp->instance].shader_effect_active ) {
-				effect_ships.push_back(objp);
-				continue;
-			}
+		objp = Render_candidates[k];
 
-            objp->flags.set(Object::Object_Flags::Was_rendered);
-			obj_queue_render(objp, &scene);
+		if ( (objp->type == OBJ_SHIP) && Ships[objp->instance].shader_effect_active ) {
+			effect_ships.push_back(objp);
+			continue;
 		}
+
+		objp->flags.set(Object::Object_Flags::Was_rendered);
+		obj_queue_render(objp, &scene);
 	}
 
+	asteroid_render_far_field(&scene);
+
 	scene.init_render();
 
 	scene.render_all(ZBUFFER_TYPE_FULL);
@@ -418,4 +465,7 @@ void obj_render_queue_all()
 
 	gr_reset_lighting();
 	gr_set_lighting(false, false);
+
+	// hand back the uniform buffer now instead of holding on to it until the next frame
+	scene.reset();
 }
@@ -15,6 +15,8 @@
 #include <cstdarg>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
+#include <thread>
 
 #ifdef WIN32
 #include <direct.h>
@@ -53,6 +55,23 @@ const char *FreeSpace_logfilename = NULL;
 
 std::unique_ptr<osapi::DebugWindow> debugWindow;
 
+// Messages may be printed from other threads, for example by the sound decoding threads. The mutex protects the filters
+// and the log file. It is recursive since outwnd_print() prints a warning through itself.
+std::recursive_mutex Outwnd_mutex;
+
+// The debug window may only be used by the main thread so messages from other threads wait here for the next message
+// or frame of the main thread
+std::thread::id Outwnd_main_thread;
+SCP_vector<std::pair<SCP_string, SCP_string>> Outwnd_pending_window_messages;
+
+static void outwnd_flush_pending_window_messages()
+{
+	for (auto& message : Outwnd_pending_window_messages) {
+		debugWindow->addDebugMessage(message.first.c_str(), message.second.c_str());
+	}
+	Outwnd_pending_window_messages.clear();
+}
+
 void load_filter_info(void)
 {
 	FILE *fp = NULL;
@@ -188,6 +207,8 @@ void outwnd_print(const char *id, const char *tmp)
   	if ( !outwnd_inited )
   		return;
 
+	std::lock_guard<std::recursive_mutex> lock(Outwnd_mutex);
+
 	if (Outwnd_no_filter_file == 1) {
 		Outwnd_no_filter_file = 2;
 
@@ -225,7 +246,12 @@ void outwnd_print(const char *id, const char *tmp)
 	}
 
 	if (debugWindow) {
-		debugWindow->addDebugMessage(id, tmp);
+		if (std::this_thread::get_id() == Outwnd_main_thread) {
+			outwnd_flush_pending_window_messages();
+			debugWindow->addDebugMessage(id, tmp);
+		} else {
+			Outwnd_pending_window_messages.emplace_back(id, tmp);
+		}
 	}
 }
 
@@ -236,6 +262,8 @@ void outwnd_init()
 	if (outwnd_inited)
 		return;
 
+	Outwnd_main_thread = std::this_thread::get_id();
+
 	if (!running_unittests && Log_fp == NULL) {
 		char pathname[MAX_PATH_LEN];
 
@@ -279,6 +307,8 @@ void outwnd_init()
 
 void outwnd_close()
 {
+	std::lock_guard<std::recursive_mutex> lock(Outwnd_mutex);
+
 	if ( !running_unittests && Log_fp != NULL ) {
 		time_t timedate = time(NULL);
 		char datestr[50];
@@ -296,12 +326,22 @@ void outwnd_close()
 }
 
 void outwnd_debug_window_init() {
+	std::lock_guard<std::recursive_mutex> lock(Outwnd_mutex);
+
 	debugWindow.reset(new osapi::DebugWindow());
 }
 void outwnd_debug_window_do_frame(float frametime) {
+	{
+		std::lock_guard<std::recursive_mutex> lock(Outwnd_mutex);
+		outwnd_flush_pending_window_messages();
+	}
+
 	debugWindow->doFrame(frametime);
 }
 void outwnd_debug_window_deinit() {
+	std::lock_guard<std::recursive_mutex> lock(Outwnd_mutex);
+
+	Outwnd_pending_window_messages.clear();
 	debugWindow.reset();
 }
 
@@ -102,6 +102,7 @@
 #include "weapon/shockwave.h"
 #include "weapon/weapon.h"
 
+#include "parse/sexp/sexp_compiler.h"
 #include "parse/sexp/sexp_lookup.h"
 
 #ifndef NDEBUG
@@ -844,6 +845,7 @@ const char *Skybox_flags[] = {
 
 int	Directive_count;
 int	Sexp_useful_number;  // a variable to pass useful info in from external modules
+bool	Sexp_dependency_time_pending = false;
 int	Locked_sexp_true, Locked_sexp_false;
 int	Num_sexp_ai_goal_links = sizeof(Sexp_ai_goal_links) / sizeof(sexp_ai_goal_link);
 int	Sexp_clipboard = -1;  // used by Fred
@@ -1111,6 +1113,7 @@ void init_sexp()
 	Sexp_current_argument_nesting_level = 0;
 	Current_sexp_network_packet.initialize();
 
+	sexp::clear_compiled_formulas();
 	sexp_nodes_init();
 	init_sexp_vars();
 	Locked_sexp_false = Locked_sexp_true = -1;
@@ -1634,6 +1637,201 @@ int get_operator_const(int node)
 	return Operators[idx].value;
 }
 
+static int sexp_get_dependency_mask_of_args(int node)
+{
+	int mask = 0;
+
+	for (; node != -1; node = CDR(node)) {
+		mask |= sexp_get_dependency_mask(node);
+	}
+
+	return mask;
+}
+
+/**
+ * Determine which game state the given formula reads.  Only operators whose result is fully determined by their
+ * arguments and the tracked categories are recognized; everything else makes the formula SEXP_DEP_UNTRACKED.
+ */
+int sexp_get_dependency_mask(int node)
+{
+	if (node < 0) {
+		return 0;
+	}
+
+	// a list node evaluates to its head, just like in eval_sexp
+	if (Sexp_nodes[node].first != -1) {
+		return sexp_get_dependency_mask(CAR(node));
+	}
+
+	if (Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) {
+		return SEXP_DEP_VARIABLES;
+	}
+
+	// plain number or string
+	if (Sexp_nodes[node].subtype != SEXP_ATOM_OPERATOR) {
+		return 0;
+	}
+
+	int op_num = get_operator_const(node);
+	int args = CDR(node);
+
+	switch (op_num) {
+		// the actions of a when are only evaluated when its condition is true, and incremental evaluation only
+		// ever skips formulas whose last result was false
+		case OP_WHEN:
+			return sexp_get_dependency_mask(args);
+
+		// pure functions of their arguments
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_AND:
+		case OP_OR:
+		case OP_NOT:
+		case OP_XOR:
+		case OP_EQUALS:
+		case OP_GREATER_THAN:
+		case OP_LESS_THAN:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_OR_EQUAL:
+		case OP_STRING_EQUALS:
+		case OP_STRING_GREATER_THAN:
+		case OP_STRING_LESS_THAN:
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_MOD:
+		case OP_ABS:
+		case OP_MIN:
+		case OP_MAX:
+		case OP_AVG:
+		case OP_POW:
+		case OP_SIGNUM:
+		case OP_IS_BIT_SET:
+		case OP_BITWISE_AND:
+		case OP_BITWISE_OR:
+		case OP_BITWISE_NOT:
+		case OP_BITWISE_XOR:
+		// campaign state doesn't change during a mission
+		case OP_PREVIOUS_GOAL_TRUE:
+		case OP_PREVIOUS_GOAL_FALSE:
+		case OP_PREVIOUS_GOAL_INCOMPLETE:
+		case OP_PREVIOUS_EVENT_TRUE:
+		case OP_PREVIOUS_EVENT_FALSE:
+		case OP_PREVIOUS_EVENT_INCOMPLETE:
+			return sexp_get_dependency_mask_of_args(args);
+
+		// these only consult the mission log, the arrival list and wing counters
+		case OP_IS_DESTROYED:
+		case OP_IS_DESTROYED_DELAY:
+		case OP_WAS_DESTROYED_BY_DELAY:
+		case OP_IS_SUBSYSTEM_DESTROYED:
+		case OP_IS_SUBSYSTEM_DESTROYED_DELAY:
+		case OP_HAS_ARRIVED:
+		case OP_HAS_ARRIVED_DELAY:
+		case OP_HAS_DEPARTED:
+		case OP_HAS_DEPARTED_DELAY:
+		case OP_IS_DISABLED:
+		case OP_IS_DISABLED_DELAY:
+		case OP_IS_DISARMED:
+		case OP_IS_DISARMED_DELAY:
+		case OP_WAYPOINTS_DONE:
+		case OP_WAYPOINTS_DONE_DELAY:
+		case OP_HAS_DOCKED:
+		case OP_HAS_UNDOCKED:
+		case OP_HAS_DOCKED_DELAY:
+		case OP_HAS_UNDOCKED_DELAY:
+		case OP_SHIP_TYPE_DESTROYED:
+		case OP_PERCENT_SHIPS_ARRIVED:
+		case OP_PERCENT_SHIPS_DEPARTED:
+		case OP_PERCENT_SHIPS_DESTROYED:
+		case OP_PERCENT_SHIPS_DISARMED:
+		case OP_PERCENT_SHIPS_DISABLED:
+		case OP_DEPART_NODE_DELAY:
+		case OP_DESTROYED_DEPARTED_DELAY:
+		case OP_TIME_SHIP_DESTROYED:
+		case OP_TIME_WING_DESTROYED:
+		case OP_TIME_SHIP_ARRIVED:
+		case OP_TIME_WING_ARRIVED:
+		case OP_TIME_SHIP_DEPARTED:
+		case OP_TIME_WING_DEPARTED:
+			return SEXP_DEP_MISSION_LOG | sexp_get_dependency_mask_of_args(args);
+
+		case OP_EVENT_TRUE:
+		case OP_EVENT_FALSE:
+		case OP_EVENT_TRUE_DELAY:
+		case OP_EVENT_FALSE_DELAY:
+		case OP_EVENT_TRUE_MSECS_DELAY:
+		case OP_EVENT_FALSE_MSECS_DELAY:
+		case OP_EVENT_INCOMPLETE:
+			return SEXP_DEP_EVENTS | sexp_get_dependency_mask_of_args(args);
+
+		// goal status is read back from the mission log
+		case OP_GOAL_TRUE_DELAY:
+		case OP_GOAL_FALSE_DELAY:
+		case OP_GOAL_INCOMPLETE:
+			return SEXP_DEP_EVENTS | SEXP_DEP_MISSION_LOG | sexp_get_dependency_mask_of_args(args);
+
+		default:
+			return SEXP_DEP_UNTRACKED;
+	}
+}
+
+static int Sexp_dependency_serial = 0;
+static int Sexp_dependency_changed[SEXP_DEP_NUM_CATEGORIES] = { 0 };
+
+/**
+ * Record that the state of the given SEXP_DEP_* categories changed
+ */
+void sexp_dependency_mark_changed(int dep_mask)
+{
+	++Sexp_dependency_serial;
+
+	for (int i = 0; i < SEXP_DEP_NUM_CATEGORIES; i++) {
+		if (dep_mask & (1 << i)) {
+			Sexp_dependency_changed[i] = Sexp_dependency_serial;
+		}
+	}
+}
+
+int sexp_dependency_serial()
+{
+	return Sexp_dependency_serial;
+}
+
+/**
+ * Returns true if a formula with the given dependency mask, last evaluated at the given serial, may evaluate
+ * to something different now
+ */
+bool sexp_dependency_changed_since(int dep_mask, int serial)
+{
+	if (dep_mask & SEXP_DEP_UNTRACKED) {
+		return true;
+	}
+
+	for (int i = 0; i < SEXP_DEP_NUM_CATEGORIES; i++) {
+		if ((dep_mask & (1 << i)) && (Sexp_dependency_changed[i] > serial)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Compare the mission time against a logged time plus delay, noting that the formula is waiting on the clock
+ */
+static bool sexp_delay_elapsed(fix time, fix delay)
+{
+	if ((Missiontime - time) >= delay) {
+		return true;
+	}
+
+	Sexp_dependency_time_pending = true;
+	return false;
+}
+
 int query_sexp_args_count(int node, bool only_valid_args = false)
 {
 	int count = 0;
@@ -5744,7 +5942,7 @@ int sexp_is_destroyed_delay(int n)
 
 	if ( val ) {
 
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -5818,7 +6016,7 @@ int sexp_was_destroyed_by_delay(int n)
 
 	if (val)
 	{
-		if ((Missiontime - time) >= delay)
+		if (sexp_delay_elapsed(time, delay))
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -5850,7 +6048,7 @@ int sexp_is_subsystem_destroyed_delay(int n)
 		return SEXP_KNOWN_FALSE;
 
 	if ( mission_log_get_time(LOG_SHIP_SUBSYS_DESTROYED, ship_name, subsys_name, &time) ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -5882,7 +6080,7 @@ int sexp_is_disabled_delay(int n)
 		return SEXP_CANT_EVAL;
 
 	if ( val ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -5914,7 +6112,7 @@ int sexp_is_disarmed_delay(int n)
 		return SEXP_CANT_EVAL;
 
 	if ( val ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -5959,7 +6157,7 @@ int sexp_has_docked_or_undocked(int n, int op_num)
 
 		if ( mission_log_get_time_indexed(op_num == OP_HAS_DOCKED_DELAY ? LOG_SHIP_DOCKED : LOG_SHIP_UNDOCKED, docker, dockee, count, &time) )
 		{
-			if ( (Missiontime - time) >= delay )
+			if ( sexp_delay_elapsed(time, delay) )
 				return SEXP_KNOWN_TRUE;
 		}
 	}
@@ -6003,7 +6201,7 @@ int sexp_has_arrived_delay(int n)
 		return SEXP_CANT_EVAL;
 
 	if ( val ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -6036,7 +6234,7 @@ int sexp_has_departed_delay(int n)
 		return SEXP_CANT_EVAL;
 
 	if ( val ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	}
 
@@ -6088,7 +6286,7 @@ int sexp_are_waypoints_done_delay(int node)
 
 	// now check the log for the waypoints done entry
 	if ( mission_log_get_time_indexed(LOG_WAYPOINTS_DONE, ship_name, waypoint_name, count, &time) ) {
-		if ( (Missiontime - time) >= delay )
+		if ( sexp_delay_elapsed(time, delay) )
 			return SEXP_KNOWN_TRUE;
 	} else {
 		if ( mission_log_get_time(LOG_SHIP_DESTROYED, ship_name, NULL, NULL) || mission_log_get_time(LOG_SELF_DESTRUCTED, ship_name, NULL, NULL) )
@@ -8412,7 +8610,7 @@ int sexp_depart_node_delay(int n)
 		n = CDR(n);
 	}
 
-	if ( (count == num_departed) && ((Missiontime - latest_time) >= delay) )
+	if ( (count == num_departed) && sexp_delay_elapsed(latest_time, delay) )
 		return SEXP_KNOWN_TRUE;
 	else
 		return SEXP_FALSE;
@@ -8475,10 +8673,14 @@ int sexp_destroyed_departed_delay(int n)
 		n = CDR(n);
 	}
 
-	if ( (count == total) && (Missiontime > (latest_time + delay)) )
-		return SEXP_KNOWN_TRUE;
-	else
-		return SEXP_FALSE;
+	if ( count == total ) {
+		if ( Missiontime > (latest_time + delay) )
+			return SEXP_KNOWN_TRUE;
+
+		Sexp_dependency_time_pending = true;
+	}
+
+	return SEXP_FALSE;
 }
 
 int sexp_special_warpout_name( int node )
@@ -9154,6 +9356,41 @@ int eval_perform_actions(int n)
 	return val;
 }
 	
+/**
+ * Performs the 'then' actions of a when-type sexp whose conditional evaluated to true
+ */
+void eval_when_true_actions(int actions, int when_op_num)
+{
+	// get the operator
+	int exp = CAR(actions);
+
+	// if the mod.tbl setting is in effect we want to each evaluate all the SEXPs for 
+	// each argument	
+	if (True_loop_argument_sexps && special_argument_appears_in_sexp_tree(exp)) {	
+		if (exp != -1) {
+			eval_when_do_all_exp(actions, when_op_num);
+		}
+	}
+	// without the mod.tbl setting (or if there are no arguments in this SEXP) we loop 
+	// through every action performing them for all arguments
+	else {
+		while (actions != -1)
+		{
+			// get the operator
+			exp = CAR(actions);
+			if (exp != -1)
+				eval_when_do_one_exp(exp);
+
+			// iterate
+			actions = CDR(actions);
+
+			// if-then-else only has one "if" action
+			if (when_op_num == OP_IF_THEN_ELSE)
+				break;
+		}
+	}
+}
+
 /**
  * Evaluates the when conditional
  *
@@ -9191,34 +9428,7 @@ int eval_when(int n, int when_op_num)
 	// if value is true, perform the actions in the 'then' part
 	if (val == SEXP_TRUE) // note: SEXP_KNOWN_TRUE is never returned from eval_sexp
 	{
-		// get the operator
-		int exp = CAR(actions);
-
-		// if the mod.tbl setting is in effect we want to each evaluate all the SEXPs for 
-		// each argument	
-		if (True_loop_argument_sexps && special_argument_appears_in_sexp_tree(exp)) {	
-			if (exp != -1) {
-				eval_when_do_all_exp(actions, when_op_num);
-			}
-		}
-		// without the mod.tbl setting (or if there are no arguments in this SEXP) we loop 
-		// through every action performing them for all arguments
-		else {
-			while (actions != -1)
-			{
-				// get the operator
-				exp = CAR(actions);
-				if (exp != -1)
-					eval_when_do_one_exp(exp);
-
-				// iterate
-				actions = CDR(actions);
-
-				// if-then-else only has one "if" action
-				if (when_op_num == OP_IF_THEN_ELSE)
-					break;
-			}
-		}
+		eval_when_true_actions(actions, when_op_num);
 	}
 	// if-then-else has actions to perform under "else"
 	else if (val == SEXP_FALSE && when_op_num == OP_IF_THEN_ELSE) // note: SEXP_KNOWN_FALSE is never returned from eval_sexp
@@ -15105,6 +15315,7 @@ int sexp_event_delay_status( int n, int want_true, bool use_msecs = false)
 		// look for the event name, check it's status.  If formula is gone, we know the state won't ever change.
 		if ( !stricmp(Mission_events[i].name, name) ) {
 			if ( (fix) Mission_events[i].timestamp + delay >= Missiontime ) {
+				Sexp_dependency_time_pending = true;
 				rval = SEXP_FALSE;
 				break;
 			}
@@ -15191,7 +15402,7 @@ int sexp_goal_delay_status( int n, int want_true )
 		if ( mission_log_get_time(LOG_GOAL_FAILED, name, NULL, NULL) )
 			return SEXP_KNOWN_FALSE;
 		else if ( mission_log_get_time(LOG_GOAL_SATISFIED, name, NULL, &time) ) {
-			if ( (Missiontime - time) >= delay )
+			if ( sexp_delay_elapsed(time, delay) )
 				return SEXP_KNOWN_TRUE;
 		}
 	} else {
@@ -15199,7 +15410,7 @@ int sexp_goal_delay_status( int n, int want_true )
 		if ( mission_log_get_time(LOG_GOAL_SATISFIED, name, NULL, NULL) )
 			return SEXP_KNOWN_FALSE;
 		else if ( mission_log_get_time(LOG_GOAL_FAILED, name, NULL, &time) ) {
-			if ( (Missiontime - time) >= delay )
+			if ( sexp_delay_elapsed(time, delay) )
 				return SEXP_KNOWN_TRUE;
 		}
 	}
@@ -30469,6 +30680,7 @@ void sexp_modify_variable(const char *text, int index, bool sexp_callback)
 		strcpy_s(Sexp_variables[index].text, text);
 	}
 	Sexp_variables[index].type |= SEXP_VARIABLE_MODIFIED;
+	sexp_dependency_mark_changed(SEXP_DEP_VARIABLES);
 
 	// do multi_callback_here
 	// if we're called from the sexp code send a SEXP packet (more efficient) 
@@ -30504,6 +30716,7 @@ void multi_sexp_modify_variable()
 		}
 
 		strcpy_s(Sexp_variables[variable_index].text, value);
+		sexp_dependency_mark_changed(SEXP_DEP_VARIABLES);
 	}	
 }
 
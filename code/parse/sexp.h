@@ -1164,6 +1164,8 @@ extern int is_sexp_top_level( int node );
 // Goober5000 - renamed these to be more clear, to prevent bugs :p
 extern int get_operator_index(const char *token);
 extern int get_operator_const(const char *token);
+extern int get_operator_index(int node);
+extern int get_operator_const(int node);
 
 extern int check_sexp_syntax(int node, int return_type = OPR_BOOL, int recursive = 0, int *bad_node = 0 /*NULL*/, int mode = 0);
 extern int get_sexp_main(void);	//	Returns start node
@@ -1172,6 +1174,7 @@ extern int stuff_sexp_variable_list();
 extern int eval_sexp(int cur_node, int referenced_node = -1);
 extern int eval_num(int n, bool &is_nan, bool &is_nan_forever);
 extern bool is_sexp_true(int cur_node, int referenced_node = -1);
+extern void eval_when_true_actions(int actions, int when_op_num);
 extern int query_operator_return_type(int op);
 extern int query_operator_argument_type(int op, int argnum);
 extern void update_sexp_references(const char *old_name, const char *new_name);
@@ -1198,6 +1201,21 @@ extern int query_sexp_ai_goal_valid(int sexp_ai_goal, int ship);
 int query_node_in_sexp(int node, int sexp);
 void flush_sexp_tree(int node);
 
+// dependency tracking for incremental evaluation of events and goals.  A formula whose dependency mask
+// does not contain SEXP_DEP_UNTRACKED can only change its value when one of the listed categories changed
+#define SEXP_DEP_MISSION_LOG		(1<<0)	// ship/wing arrivals, departures, destruction, docking etc.
+#define SEXP_DEP_VARIABLES			(1<<1)	// sexp variable values
+#define SEXP_DEP_EVENTS				(1<<2)	// event results and goal status
+#define SEXP_DEP_NUM_CATEGORIES		3
+#define SEXP_DEP_UNTRACKED			(1<<30)	// reads state which isn't tracked (hull, positions, mission time...)
+
+extern bool Sexp_dependency_time_pending;	// set during evaluation when a delay operator is only waiting on mission time
+
+int sexp_get_dependency_mask(int node);
+void sexp_dependency_mark_changed(int dep_mask);
+int sexp_dependency_serial();
+bool sexp_dependency_changed_since(int dep_mask, int serial);
+
 // sexp_variable
 void sexp_modify_variable(const char *text, int index, bool sexp_callback = true);
 int get_index_sexp_variable_from_node (int node);
@@ -0,0 +1,546 @@
+#include "parse/sexp/sexp_compiler.h"
+
+#include "debugconsole/console.h"
+#include "mission/missiongoals.h"
+#include "parse/sexp.h"
+
+#include <climits>
+
+namespace {
+using namespace sexp;
+
+enum class opcode : ubyte {
+	List,		// evaluates its first element and takes over that node's value
+	Number,		// a constant number
+	Atom,		// a number that has to go through CTEXT (variables and special arguments)
+	Operator,	// one of the operators implemented below
+	Tree,		// anything else, which is left to eval_sexp
+};
+
+struct instruction {
+	opcode code;
+	int node;		// the SEXP node this instruction stands for
+	int op;			// operator constant
+	int child;		// List: instruction of the first element
+	int number;		// Number: the parsed value
+	int first_arg;	// Operator: index into compiled_formula::args
+	int num_args;
+	bool positive;	// the parent operator wants a positive value in this argument slot
+};
+
+struct argument {
+	int node;	// the list node of this argument
+	int eval;	// instruction evaluating the argument node itself
+	int car;	// instruction evaluating the first element of the argument node or -1 if it has none
+};
+
+struct compiled_formula {
+	SCP_vector<instruction> code;
+	SCP_vector<argument> args;
+};
+
+SCP_unordered_map<int, compiled_formula> Compiled_formulas;
+
+bool is_compiled_operator(int op)
+{
+	switch (op) {
+		case OP_TRUE:
+		case OP_FALSE:
+		case OP_AND:
+		case OP_OR:
+		case OP_NOT:
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_MOD:
+		case OP_EQUALS:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_THAN:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_THAN:
+		case OP_LESS_OR_EQUAL:
+		case OP_WHEN:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+bool is_number_compare(int op)
+{
+	return op == OP_EQUALS || op == OP_NOT_EQUAL || op == OP_GREATER_THAN || op == OP_GREATER_OR_EQUAL
+		|| op == OP_LESS_THAN || op == OP_LESS_OR_EQUAL;
+}
+
+/**
+ * Appends the instructions for the given node and returns the index of its instruction.  The parent operator and
+ * argument slot are the ones eval_sexp would find through find_parent_operator() and find_argnum().
+ */
+int compile_node(compiled_formula& formula, int node, int parent_op_index, int parent_argnum)
+{
+	int index = (int) formula.code.size();
+	formula.code.emplace_back();
+
+	instruction ins;
+	memset(&ins, 0, sizeof(ins));
+	ins.node = node;
+	ins.child = -1;
+	ins.first_arg = -1;
+
+	if (Sexp_nodes[node].first != -1) {
+		ins.code = opcode::List;
+		ins.child = compile_node(formula, Sexp_nodes[node].first, parent_op_index, parent_argnum);
+		formula.code[index] = ins;
+		return index;
+	}
+
+	ins.op = get_operator_const(node);
+
+	if (ins.op == 0) {
+		if ((Sexp_nodes[node].type & SEXP_FLAG_VARIABLE) || !strcmp(Sexp_nodes[node].text, SEXP_ARGUMENT_STRING)) {
+			ins.code = opcode::Atom;
+		} else {
+			ins.code = opcode::Number;
+			ins.number = atoi(Sexp_nodes[node].text);
+		}
+		formula.code[index] = ins;
+		return index;
+	}
+
+	int args = Sexp_nodes[node].rest;
+
+	// when needs a real condition to be handled here (its actions are always run through the tree) and the
+	// comparisons need something to compare
+	if (!is_compiled_operator(ins.op) || (ins.op == OP_WHEN && (args == -1 || Sexp_nodes[args].first == -1))
+		|| (is_number_compare(ins.op) && args == -1)) {
+		ins.code = opcode::Tree;
+		formula.code[index] = ins;
+		return index;
+	}
+
+	ins.code = opcode::Operator;
+	ins.positive = (parent_op_index >= 0) && (query_operator_argument_type(parent_op_index, parent_argnum) == OPF_POSITIVE);
+	ins.first_arg = (int) formula.args.size();
+
+	int op_index = get_operator_index(node);
+	for (int n = args; n != -1; n = Sexp_nodes[n].rest) {
+		formula.args.emplace_back();
+		ins.num_args++;
+		if (ins.op == OP_WHEN || ins.op == OP_NOT)
+			break;
+	}
+
+	int argnum = 0;
+	for (int n = args; argnum < ins.num_args; n = Sexp_nodes[n].rest, ++argnum) {
+		argument arg;
+		arg.node = n;
+		arg.eval = compile_node(formula, n, op_index, argnum);
+		arg.car = formula.code[arg.eval].child;
+		formula.args[ins.first_arg + argnum] = arg;
+	}
+
+	formula.code[index] = ins;
+	return index;
+}
+
+int eval_instruction(const compiled_formula& formula, int index);
+
+inline bool is_true(int result)
+{
+	return (result == SEXP_TRUE) || (result == SEXP_KNOWN_TRUE);
+}
+
+// the value of the first argument of an operator, which is either an expression or a number
+inline int eval_first_number(const compiled_formula& formula, const argument& arg)
+{
+	if (arg.car != -1)
+		return eval_instruction(formula, arg.car);
+
+	const instruction& ins = formula.code[arg.eval];
+	return (ins.code == opcode::Number) ? ins.number : atoi(CTEXT(arg.node));
+}
+
+// mirrors sexp_or() and sexp_and()
+int eval_and_or(const compiled_formula& formula, const instruction& ins)
+{
+	bool is_or = (ins.op == OP_OR);
+	bool all_known = true;
+	bool result = !is_or;
+
+	for (int i = 0; i < ins.num_args; ++i) {
+		const argument& arg = formula.args[ins.first_arg + i];
+		bool arg_result;
+		int value_node;
+
+		if (i == 0 && arg.car == -1) {
+			// this should never happen, because all arguments which return logical values are operators
+			arg_result = eval_first_number(formula, arg) != 0;
+			result = is_or ? (arg_result || result) : (arg_result && result);
+			continue;
+		}
+
+		if (i == 0) {
+			arg_result = is_true(eval_instruction(formula, arg.car));
+			value_node = formula.code[arg.car].node;
+		} else {
+			arg_result = is_true(eval_instruction(formula, arg.eval));
+			value_node = arg.node;
+		}
+
+		int value = Sexp_nodes[value_node].value;
+
+		if (is_or) {
+			result = arg_result || result;
+			if (value == SEXP_KNOWN_TRUE)
+				return SEXP_KNOWN_TRUE;
+			if (value != SEXP_KNOWN_FALSE)
+				all_known = false;
+		} else {
+			result = arg_result && result;
+			if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+				return SEXP_KNOWN_FALSE;
+			if (value != SEXP_KNOWN_TRUE)
+				all_known = false;
+		}
+	}
+
+	if (all_known)
+		return is_or ? SEXP_KNOWN_FALSE : SEXP_KNOWN_TRUE;
+
+	return result ? SEXP_TRUE : SEXP_FALSE;
+}
+
+// mirrors sexp_not()
+int eval_not(const compiled_formula& formula, const instruction& ins)
+{
+	bool result = false;
+
+	if (ins.num_args > 0) {
+		const argument& arg = formula.args[ins.first_arg];
+
+		if (arg.car != -1) {
+			result = is_true(eval_instruction(formula, arg.car));
+
+			int value = Sexp_nodes[formula.code[arg.car].node].value;
+			if (value == SEXP_KNOWN_FALSE || value == SEXP_NAN_FOREVER)
+				return SEXP_KNOWN_TRUE;
+			else if (value == SEXP_KNOWN_TRUE)
+				return SEXP_KNOWN_FALSE;
+			else if (value == SEXP_NAN)
+				return SEXP_TRUE;
+		}
+		// this should never happen, because all arguments which return logical values are operators
+		else
+			result = (eval_first_number(formula, arg) != 0);
+	}
+
+	return result ? SEXP_FALSE : SEXP_TRUE;
+}
+
+// mirrors add_sexps() and the other arithmetic operators
+int eval_arithmetic(const compiled_formula& formula, const instruction& ins)
+{
+	int sum = 0;
+
+	for (int i = 0; i < ins.num_args; ++i) {
+		const argument& arg = formula.args[ins.first_arg + i];
+		int val, value_node;
+
+		if (i == 0) {
+			val = eval_first_number(formula, arg);
+			if (arg.car == -1) {
+				sum = val;
+				continue;
+			}
+			value_node = formula.code[arg.car].node;
+		} else {
+			val = eval_instruction(formula, arg.eval);
+			value_node = arg.node;
+		}
+
+		// NaNs get propagated to the next highest function
+		if (Sexp_nodes[value_node].value == SEXP_NAN)
+			return SEXP_NAN;
+		else if (Sexp_nodes[value_node].value == SEXP_NAN_FOREVER)
+			return SEXP_NAN_FOREVER;
+
+		if (i == 0) {
+			sum = val;
+			continue;
+		}
+
+		switch (ins.op) {
+			case OP_PLUS:
+				sum += val;
+				break;
+
+			case OP_MINUS:
+				sum -= val;
+				break;
+
+			case OP_MUL:
+				sum *= val;
+				break;
+
+			case OP_DIV:
+				if (val == 0) {
+					Warning(LOCATION, "Division by zero in sexp. Please check all uses of the / operator for possible causes.\n");
+					return SEXP_NAN;
+				}
+				sum /= val;
+				break;
+
+			case OP_MOD:
+				if (val == 0) {
+					Warning(LOCATION, "Modulo by zero in sexp. Please check all uses of the %% operator for possible causes.\n");
+					return SEXP_NAN;
+				}
+				sum = sum % val;
+				break;
+
+			default:
+				UNREACHABLE("Unhandled arithmetic operator %d!", ins.op);
+				break;
+		}
+	}
+
+	return sum;
+}
+
+// returns the value of the first element of an argument node, if it has one
+inline int first_element_value(const argument& arg)
+{
+	return (arg.car != -1) ? Sexp_nodes[Sexp_nodes[arg.node].first].value : SEXP_UNKNOWN;
+}
+
+// mirrors sexp_number_compare(), including which nodes are checked for NaNs before each comparison
+int eval_compare(const compiled_formula& formula, const instruction& ins)
+{
+	const argument* args = &formula.args[ins.first_arg];
+	int first_number = eval_instruction(formula, args[0].eval);
+
+	for (int i = 0; i < ins.num_args; ++i) {
+		int value = first_element_value(args[i]);
+		if (value == SEXP_NAN) return SEXP_FALSE;
+		if (value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
+
+		if (i + 1 < ins.num_args) {
+			value = Sexp_nodes[args[i + 1].node].value;
+			if (value == SEXP_NAN) return SEXP_FALSE;
+			if (value == SEXP_NAN_FOREVER) return SEXP_KNOWN_FALSE;
+		}
+
+		if (i == 0)
+			continue;
+
+		int current_number = eval_instruction(formula, args[i].eval);
+
+		switch (ins.op) {
+			case OP_EQUALS:
+				if (first_number != current_number) return SEXP_FALSE;
+				break;
+
+			case OP_NOT_EQUAL:
+				if (first_number == current_number) return SEXP_FALSE;
+				break;
+
+			case OP_GREATER_THAN:
+				if (first_number <= current_number) return SEXP_FALSE;
+				break;
+
+			case OP_GREATER_OR_EQUAL:
+				if (first_number < current_number) return SEXP_FALSE;
+				break;
+
+			case OP_LESS_THAN:
+				if (first_number >= current_number) return SEXP_FALSE;
+				break;
+
+			case OP_LESS_OR_EQUAL:
+				if (first_number > current_number) return SEXP_FALSE;
+				break;
+
+			default:
+				Warning(LOCATION, "Unhandled comparison case!  Operator = %d", ins.op);
+				break;
+		}
+	}
+
+	return SEXP_TRUE;
+}
+
+// mirrors eval_when() for a plain when without arguments
+int eval_when(const compiled_formula& formula, const instruction& ins)
+{
+	const argument& arg = formula.args[ins.first_arg];
+	int cond = Sexp_nodes[arg.node].first;
+
+	int val = eval_instruction(formula, arg.car);
+
+	if (val == SEXP_TRUE)
+		eval_when_true_actions(Sexp_nodes[arg.node].rest, OP_WHEN);
+
+	if (Sexp_nodes[cond].value == SEXP_KNOWN_FALSE || Sexp_nodes[cond].value == SEXP_NAN_FOREVER)
+		return SEXP_KNOWN_FALSE;
+
+	return val;
+}
+
+int eval_operator(const compiled_formula& formula, const instruction& ins)
+{
+	switch (ins.op) {
+		case OP_TRUE:
+			return SEXP_KNOWN_TRUE;
+
+		case OP_FALSE:
+			return SEXP_KNOWN_FALSE;
+
+		case OP_AND:
+		case OP_OR:
+			return eval_and_or(formula, ins);
+
+		case OP_NOT:
+			return eval_not(formula, ins);
+
+		case OP_PLUS:
+		case OP_MINUS:
+		case OP_MUL:
+		case OP_DIV:
+		case OP_MOD:
+			return eval_arithmetic(formula, ins);
+
+		case OP_EQUALS:
+		case OP_NOT_EQUAL:
+		case OP_GREATER_THAN:
+		case OP_GREATER_OR_EQUAL:
+		case OP_LESS_THAN:
+		case OP_LESS_OR_EQUAL:
+			return eval_compare(formula, ins);
+
+		case OP_WHEN:
+			return eval_when(formula, ins);
+
+		default:
+			UNREACHABLE("Operator %d is not handled by the compiled formula evaluator!", ins.op);
+			return SEXP_FALSE;
+	}
+}
+
+/**
+ * The compiled counterpart of eval_sexp().  The known-value checks and the way the result is stored in the node are
+ * the same as in eval_sexp() so that the tree interpreter can take over at any point.
+ */
+int eval_instruction(const compiled_formula& formula, int index)
+{
+	const instruction& ins = formula.code[index];
+	int cur_node = ins.node;
+
+	if (ins.code == opcode::Tree)
+		return eval_sexp(cur_node);
+
+	if (Sexp_nodes[cur_node].value == SEXP_KNOWN_TRUE)
+		return SEXP_TRUE;
+	else if (Sexp_nodes[cur_node].value == SEXP_KNOWN_FALSE || Sexp_nodes[cur_node].value == SEXP_NAN_FOREVER)
+		return SEXP_FALSE;
+
+	switch (ins.code) {
+		case opcode::List: {
+			int sexp_val = eval_instruction(formula, ins.child);
+			Sexp_nodes[cur_node].value = Sexp_nodes[formula.code[ins.child].node].value;
+			return sexp_val;
+		}
+
+		case opcode::Number:
+			return ins.number;
+
+		case opcode::Atom:
+			return atoi(CTEXT(cur_node));
+
+		default:
+			break;
+	}
+
+	Current_sexp_operator.push_back(ins.op);
+	int sexp_val = eval_operator(formula, ins);
+	Assert(!Current_sexp_operator.empty());
+	Current_sexp_operator.pop_back();
+
+	if (sexp_val == SEXP_KNOWN_TRUE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_TRUE;
+		return SEXP_TRUE;
+	}
+
+	if (sexp_val == SEXP_KNOWN_FALSE) {
+		Sexp_nodes[cur_node].value = SEXP_KNOWN_FALSE;
+		return SEXP_FALSE;
+	}
+
+	if (sexp_val == SEXP_NAN) {
+		Sexp_nodes[cur_node].value = SEXP_NAN;
+		return SEXP_FALSE;
+	}
+
+	if (sexp_val == SEXP_NAN_FOREVER) {
+		Sexp_nodes[cur_node].value = SEXP_NAN_FOREVER;
+		return SEXP_FALSE;
+	}
+
+	if (Sexp_nodes[cur_node].value == SEXP_NAN) {
+		Sexp_nodes[cur_node].value = SEXP_UNKNOWN;
+		return sexp_val;
+	}
+
+	// the parent lookup eval_sexp does here was resolved when the formula was compiled
+	if (sexp_val < 0 && sexp_val > SEXP_UNLIKELY_RETURN_VALUE_BOUND && ins.positive)
+		sexp_val *= -1;
+
+	Sexp_nodes[cur_node].value = sexp_val ? SEXP_TRUE : SEXP_FALSE;
+
+	return sexp_val;
+}
+}
+
+namespace sexp {
+
+bool Use_compiled_formulas = true;
+
+bool compile_formula(int node)
+{
+	if (Fred_running || node < 0)
+		return false;
+
+	Compiled_formulas.erase(node);
+
+	compiled_formula formula;
+	compile_node(formula, node, -1, -1);
+
+	// there is nothing to gain if the whole formula is left to the tree interpreter anyway
+	if (formula.code.front().code == opcode::Tree)
+		return false;
+
+	Compiled_formulas.insert(std::make_pair(node, std::move(formula)));
+	return true;
+}
+
+int eval_formula(int node)
+{
+	if (node >= 0 && Use_compiled_formulas && !Log_event) {
+		auto iter = Compiled_formulas.find(node);
+
+		if (iter != Compiled_formulas.end())
+			return eval_instruction(iter->second, 0);
+	}
+
+	return eval_sexp(node);
+}
+
+void clear_compiled_formulas()
+{
+	Compiled_formulas.clear();
+}
+
+}
+
+DCF_BOOL(compiled_sexps, sexp::Use_compiled_formulas);
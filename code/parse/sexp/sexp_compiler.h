@@ -0,0 +1,44 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace sexp {
+
+/**
+ * @brief Whether mission formulas are evaluated through their compiled form
+ *
+ * When this is false every formula is evaluated by the tree interpreter (eval_sexp) which remains the reference
+ * implementation.
+ */
+extern bool Use_compiled_formulas;
+
+/**
+ * @brief Compiles the formula starting at the given node into a flat instruction list
+ *
+ * The logical, arithmetic and comparison operators as well as plain @c when are executed directly by the compiled
+ * form. Every other operator is handed back to eval_sexp so the result is always identical to evaluating the tree.
+ *
+ * @param node The top level node of the formula
+ * @return @c true if the formula was compiled, @c false if it has to be evaluated as a tree
+ */
+bool compile_formula(int node);
+
+/**
+ * @brief Evaluates a formula
+ *
+ * Uses the compiled form of the formula if compile_formula was called for it and falls back to eval_sexp otherwise.
+ * Event logging always uses the tree interpreter.
+ *
+ * @param node The top level node of the formula
+ * @return The same value eval_sexp would have returned for this node
+ */
+int eval_formula(int node);
+
+/**
+ * @brief Discards all compiled formulas
+ *
+ * This must be called whenever the SEXP nodes the formulas were compiled from are freed.
+ */
+void clear_compiled_formulas();
+
+}
@@ -25,7 +25,18 @@ using namespace particle;
 namespace
 {
 	SCP_vector<::particle::particle> Particles;
-	SCP_vector<ParticlePtr> Persistent_particles;
+
+	// Persistent particles are stored densely just like the normal particles. Handles refer to a slot which stores
+	// where the particle currently is in the dense array.
+	struct persistent_slot {
+		uint32_t generation = 0;
+		uint32_t dense_index = UINT32_MAX;	// UINT32_MAX if the slot is free
+	};
+
+	SCP_vector<::particle::particle> Persistent_particles;
+	SCP_vector<uint32_t> Persistent_particle_slots; // The slot of each particle in Persistent_particles
+	SCP_vector<persistent_slot> Persistent_slots;
+	SCP_vector<uint32_t> Persistent_free_slots;
 
 	int Anim_bitmap_id_fire = -1;
 	int Anim_num_frames_fire = -1;
@@ -38,7 +49,55 @@ namespace
 
 	static int Particles_enabled = 1;
 
-	float get_current_alpha(vec3d* pos)
+	uint32_t alloc_persistent_slot()
+	{
+		if (Persistent_free_slots.empty()) {
+			Persistent_slots.emplace_back();
+			return (uint32_t)(Persistent_slots.size() - 1);
+		}
+
+		auto slot = Persistent_free_slots.back();
+		Persistent_free_slots.pop_back();
+
+		return slot;
+	}
+
+	// Changing the generation makes all existing handles to the slot expire
+	void free_persistent_slot(uint32_t slot)
+	{
+		++Persistent_slots[slot].generation;
+		Persistent_slots[slot].dense_index = UINT32_MAX;
+
+		Persistent_free_slots.push_back(slot);
+	}
+
+	void remove_persistent_particle(size_t index)
+	{
+		free_persistent_slot(Persistent_particle_slots[index]);
+
+		auto last = Persistent_particles.size() - 1;
+		if (index != last) {
+			Persistent_particles[index] = Persistent_particles[last];
+			Persistent_particle_slots[index] = Persistent_particle_slots[last];
+
+			Persistent_slots[Persistent_particle_slots[index]].dense_index = (uint32_t)index;
+		}
+
+		Persistent_particles.pop_back();
+		Persistent_particle_slots.pop_back();
+	}
+
+	void remove_all_persistent_particles()
+	{
+		for (auto slot : Persistent_particle_slots) {
+			free_persistent_slot(slot);
+		}
+
+		Persistent_particles.clear();
+		Persistent_particle_slots.clear();
+	}
+
+	float get_current_alpha(const vec3d* pos)
 	{
 		float dist;
 		float alpha;
@@ -104,7 +163,7 @@ namespace particle
 	// only call from game_shutdown()!!!
 	void close()
 	{
-		Persistent_particles.clear();
+		remove_all_persistent_particles();
 		Particles.clear();
 	}
 
@@ -218,15 +277,38 @@ namespace particle
 	// Creates a single particle. See the PARTICLE_?? defines for types.
 	WeakParticlePtr createPersistent(particle_info* pinfo)
 	{
-		ParticlePtr new_particle = std::make_shared<particle>();
+		particle new_particle;
 
-		if (!init_particle(new_particle.get(), pinfo)) {
+		if (!init_particle(&new_particle, pinfo)) {
 			return WeakParticlePtr();
 		}
 
+		auto slot = alloc_persistent_slot();
+		Persistent_slots[slot].dense_index = (uint32_t)Persistent_particles.size();
+
 		Persistent_particles.push_back(new_particle);
+		Persistent_particle_slots.push_back(slot);
+
+		return WeakParticlePtr(slot, Persistent_slots[slot].generation);
+	}
+
+	bool WeakParticlePtr::expired() const
+	{
+		return lock() == nullptr;
+	}
+
+	ParticlePtr WeakParticlePtr::lock() const
+	{
+		if (_slot >= Persistent_slots.size()) {
+			return nullptr;
+		}
 
-		return WeakParticlePtr(new_particle);
+		auto& slot = Persistent_slots[_slot];
+		if (slot.generation != _generation || slot.dense_index == UINT32_MAX) {
+			return nullptr;
+		}
+
+		return &Persistent_particles[slot.dense_index];
 	}
 
 	void create(vec3d* pos,
@@ -323,25 +405,17 @@ namespace particle
 		if (Persistent_particles.empty() && Particles.empty())
 			return;
 
-		for (auto p = Persistent_particles.begin(); p != Persistent_particles.end();)
+		for (size_t i = 0; i < Persistent_particles.size();)
 		{
-			ParticlePtr part = *p;
-			if (move_particle(frametime, part.get()))
+			if (move_particle(frametime, &Persistent_particles[i]))
 			{
-				// if we're sitting on the very last particle, popping-back will invalidate the iterator!
-				if (p + 1 == Persistent_particles.end())
-				{
-					Persistent_particles.pop_back();
-					break;
-				}
-
-				*p = Persistent_particles.back();
-				Persistent_particles.pop_back();
+				// the last particle is moved into this place so process the same index again
+				remove_persistent_particle(i);
 				continue;
 			}
 
 			// next particle
-			++p;
+			++i;
 		}
 
 		for (auto p = Particles.begin(); p != Particles.end();)
@@ -370,28 +444,36 @@ namespace particle
 	{
 		// kill all active particles
 		Particles.clear();
-		Persistent_particles.clear();
+		remove_all_persistent_particles();
 	}
 
 	/**
-	 * @brief Renders a single particle
-	 * @param part The particle to render
-	 * @return @c true if the particle has been added to the rendering batch, @c false otherwise
+	 * @brief Computes the world position of a particle
+	 * @param part The particle
+	 * @param p_pos The world position is stored here
 	 */
-	static bool render_particle(particle* part) {
-		// skip back-facing particles (ripped from fullneb code)
+	static void particle_world_pos(const particle* part, vec3d* p_pos) {
 		// Wanderer - add support for attached particles
-		vec3d p_pos;
 		if (part->attached_objnum >= 0)
 		{
-			vm_vec_unrotate(&p_pos, &part->pos, &Objects[part->attached_objnum].orient);
-			vm_vec_add2(&p_pos, &Objects[part->attached_objnum].pos);
+			vm_vec_unrotate(p_pos, &part->pos, &Objects[part->attached_objnum].orient);
+			vm_vec_add2(p_pos, &Objects[part->attached_objnum].pos);
 		}
 		else
 		{
-			p_pos = part->pos;
+			*p_pos = part->pos;
 		}
+	}
 
+	/**
+	 * @brief Renders a single particle
+	 * @param part The particle to render
+	 * @param p_pos The world position of the particle
+	 * @param pos The particle position rotated into view space
+	 * @return @c true if the particle has been added to the rendering batch, @c false otherwise
+	 */
+	static bool render_particle(particle* part, const vec3d& p_pos, vertex& pos) {
+		// skip back-facing particles (ripped from fullneb code)
 		if (vm_vec_dot_to_point(&Eye_matrix.vec.fvec, &Eye_position, &p_pos) <= 0.0f)
 		{
 			return false;
@@ -406,10 +488,7 @@ namespace particle
 			return false;
 		}
 
-		vertex pos;
-		auto flags = g3_rotate_vertex(&pos, &p_pos);
-
-		if (flags)
+		if (pos.codes)
 		{
 			return false;
 		}
@@ -460,14 +539,30 @@ namespace particle
 		if (Persistent_particles.empty() && Particles.empty())
 			return;
 
+		// Gather all particles first so their positions can be rotated into view space in one go
+		static SCP_vector<particle*> parts;
+		static SCP_vector<vec3d> positions;
+		static SCP_vector<vertex> verts;
+
+		parts.clear();
 		for (auto& part : Persistent_particles) {
-			if (render_particle(part.get())) {
-				render_batch = true;
-			}
+			parts.push_back(&part);
 		}
-
 		for (auto& part : Particles) {
-			if (render_particle(&part)) {
+			parts.push_back(&part);
+		}
+
+		positions.resize(parts.size());
+		verts.resize(parts.size());
+
+		for (size_t i = 0; i < parts.size(); ++i) {
+			particle_world_pos(parts[i], &positions[i]);
+		}
+
+		g3_rotate_vertices(verts.data(), positions.data(), (int)parts.size());
+
+		for (size_t i = 0; i < parts.size(); ++i) {
+			if (render_particle(parts[i], positions[i], verts[i])) {
 				render_batch = true;
 			}
 		}
@@ -15,8 +15,6 @@
 #include "globalincs/pstypes.h"
 #include "object/object.h"
 
-#include <memory>
-
 namespace particle
 {
 	//============================================================================
@@ -95,8 +93,50 @@ namespace particle
 		int		particle_index;		// used to keep particle offset in dynamic array for orient usage
 	} particle;
 
-	typedef std::weak_ptr<particle> WeakParticlePtr;
-	typedef std::shared_ptr<particle> ParticlePtr;
+	/**
+	 * @brief A pointer to a persistent particle
+	 *
+	 * This is only valid until the next persistent particle is created or the particles are moved so it must not be
+	 * stored. Use WeakParticlePtr for keeping a reference to a particle.
+	 */
+	typedef particle* ParticlePtr;
+
+	/**
+	 * @brief A handle to a persistent particle
+	 *
+	 * Persistent particles are stored in a slot map. A handle refers to a slot and the generation the slot had when the
+	 * particle was created. The generation of a slot changes when its particle is removed so old handles expire even
+	 * after the slot has been reused by another particle.
+	 *
+	 * This has the same interface as the std::weak_ptr which was used for this previously.
+	 */
+	class WeakParticlePtr {
+		uint32_t _slot = UINT32_MAX;
+		uint32_t _generation = 0;
+
+	 public:
+		WeakParticlePtr() = default;
+		WeakParticlePtr(uint32_t slot, uint32_t generation) : _slot(slot), _generation(generation) {}
+
+		/**
+		 * @brief Checks if the particle has been removed
+		 * @return @c true if the particle does not exist anymore
+		 */
+		bool expired() const;
+
+		/**
+		 * @brief Gets the particle this handle refers to
+		 * @return The particle or @c nullptr if it has expired. See ParticlePtr for how long the pointer stays valid.
+		 */
+		ParticlePtr lock() const;
+
+		void reset() { *this = WeakParticlePtr(); }
+
+		bool operator==(const WeakParticlePtr& other) const {
+			return _slot == other._slot && _generation == other._generation;
+		}
+		bool operator!=(const WeakParticlePtr& other) const { return !(*this == other); }
+	};
 
 	/**
 	 * @brief Creates a non-persistent particle
@@ -128,9 +168,9 @@ namespace particle
 	/**
 	 * @brief Creates a persistent particle
 	 *
-	 * A persistent particle is handled differently from a standard particle. It is possible to hold a weak or strong
-	 * reference to a persistent particle which allows to track where the particle is and also allows to change particle
-	 * properties after it has been created.
+	 * A persistent particle is handled differently from a standard particle. It is possible to hold a handle to a
+	 * persistent particle which allows to track where the particle is and also allows to change particle properties
+	 * after it has been created.
 	 *
 	 * @param pinfo A structure containg information about how the particle should be created
 	 * @return A weak reference to the particle
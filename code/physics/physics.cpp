@@ -386,6 +386,14 @@ void physics_sim(vec3d* position, matrix* orient, physics_info* pi, float sim_ti
 
 }
 
+//	-----------------------------------------------------------------------------------------------------------
+// Simulate a batch of objects which have PF_CONST_VEL set.  This is the first case of physics_sim() done for many
+// objects at once.
+void physics_sim_const_vel_batch(vec3d *positions, const vec3d *vels, size_t count, float sim_time)
+{
+	vm_vec_scale_add2_batch(positions, vels, count, sim_time);
+}
+
 //	-----------------------------------------------------------------------------------------------------------
 // Simulate a physics object for this frame.  Used by the editor.  The difference between
 // this function and physics_sim() is that this one uses a heading change to rotate around
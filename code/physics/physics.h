@@ -138,6 +138,10 @@ extern void physics_read_flying_controls( matrix * orient, physics_info * pi, co
 extern void physics_sim(vec3d *position, matrix * orient, physics_info * pi, float sim_time );
 extern void physics_sim_editor(vec3d *position, matrix * orient, physics_info * pi, float sim_time);
 
+// Moves a whole array of objects with PF_CONST_VEL set, positions[i] ends up where physics_sim() would put it for
+// an object with velocity vels[i].  The caller gathers the positions and velocities and writes the positions back.
+extern void physics_sim_const_vel_batch(vec3d *positions, const vec3d *vels, size_t count, float sim_time);
+
 extern void physics_sim_vel(vec3d * position, physics_info * pi, float sim_time, matrix * orient);
 extern void physics_sim_rot(matrix * orient, physics_info * pi, float sim_time );
 extern void physics_apply_whack(vec3d *force, vec3d *pos, physics_info *pi, matrix *orient, float mass);
@@ -119,6 +119,11 @@ int g3_check_normal_facing(const vec3d *v, const vec3d *norm);
  */
 ubyte g3_rotate_vertex(vertex *dest, const vec3d *src);
 
+/**
+ * Rotates an array of points, same as calling g3_rotate_vertex for every one of them
+ */
+void g3_rotate_vertices(vertex *dest, const vec3d *src, int count);
+
 /**
  * Use this for stars, etc
  */
@@ -153,6 +153,41 @@ ubyte g3_rotate_vertex(vertex *dest, const vec3d *src)
 #endif
 }	
 
+void g3_rotate_vertices(vertex *dest, const vec3d *src, int count)
+{
+	const int chunk_size = 64;
+	vec3d rotated[chunk_size];
+
+	MONITOR_INC( NumRotations, count );
+
+	for (int start = 0; start < count; start += chunk_size) {
+		int num = MIN(count - start, chunk_size);
+
+		vm_vec_sub_rotate_batch(rotated, src + start, (size_t)num, &View_position, &View_matrix);
+
+		for (int i = 0; i < num; i++) {
+			vertex *v = &dest[start + i];
+			const vec3d *p = &rotated[i];
+			ubyte codes = 0;
+
+			if (p->xyz.x > p->xyz.z)		codes |= CC_OFF_RIGHT;
+			if (p->xyz.x < -p->xyz.z)		codes |= CC_OFF_LEFT;
+			if (p->xyz.y > p->xyz.z)		codes |= CC_OFF_TOP;
+			if (p->xyz.y < -p->xyz.z)		codes |= CC_OFF_BOT;
+			if (p->xyz.z < MIN_Z )			codes |= CC_BEHIND;
+
+			v->world = *p;
+
+			if ( G3_user_clip && g3_point_behind_user_plane(&v->world) ) {
+				codes |= CC_OFF_USER;
+			}
+
+			v->codes = codes;
+			v->flags = 0;	// not projected
+		}
+	}
+}
+
 
 ubyte g3_rotate_faraway_vertex(vertex *dest, const vec3d *src)
 {	
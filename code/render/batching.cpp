@@ -15,35 +15,105 @@
 #include "graphics/material.h"
 #include "tracing/tracing.h"
 
-static SCP_map<batch_info, primitive_batch> Batching_primitives;
+#include <algorithm>
+#include <memory>
+
+const size_t batch_vertex_chunk::NUM_VERTS;
+
+// All batches in the order they were created. A deque is used so that pointers to the batches stay valid.
+static SCP_deque<primitive_batch> Batching_primitives;
+
+// Open addressing hash table of indices into Batching_primitives, -1 marks an empty slot
+static SCP_vector<int> Batching_primitive_index;
+
+// The batches sorted by their batch_info which determines the render order. Only rebuilt when batches are added.
+static SCP_vector<primitive_batch*> Batching_sorted_primitives;
+static bool Batching_sorted_primitives_dirty = false;
+
+// Consecutive adds usually go to the same batch so the last lookup is cached. The texture is the one passed to
+// batching_find_batch() before it is resolved to the base frame.
+static struct {
+	int texture = -1;
+	batch_info::material_type mat_type = batch_info::FLAT_EMISSIVE;
+	primitive_type prim_type = PRIM_TYPE_TRIS;
+	bool thruster = false;
+
+	primitive_batch* batch = nullptr;
+} Batching_last_batch;
+
 static SCP_map<batch_buffer_key, primitive_batch_buffer> Batching_buffers;
+static primitive_batch_buffer* Batching_last_buffer = nullptr;
+static batch_buffer_key Batching_last_buffer_key;
+
+// Pool of vertex chunks shared by all batches
+static SCP_vector<std::unique_ptr<batch_vertex_chunk>> Batching_chunks;
+static SCP_vector<batch_vertex_chunk*> Batching_free_chunks;
+
+static batch_vertex_chunk* batching_alloc_chunk()
+{
+	if ( Batching_free_chunks.empty() ) {
+		Batching_chunks.emplace_back(new batch_vertex_chunk());
+		return Batching_chunks.back().get();
+	}
+
+	auto chunk = Batching_free_chunks.back();
+	Batching_free_chunks.pop_back();
+
+	return chunk;
+}
+
+primitive_batch::~primitive_batch()
+{
+	clear();
+}
+
+void primitive_batch::add_vertex(const batch_vertex* v)
+{
+	auto offset = Num_verts % batch_vertex_chunk::NUM_VERTS;
+
+	if ( offset == 0 ) {
+		Chunks.push_back(batching_alloc_chunk());
+	}
+
+	Chunks.back()->verts[offset] = *v;
+	++Num_verts;
+}
 
 void primitive_batch::add_triangle(batch_vertex* v0, batch_vertex* v1, batch_vertex *v2)
 {
-	Vertices.push_back(*v0);
-	Vertices.push_back(*v1);
-	Vertices.push_back(*v2);
+	add_vertex(v0);
+	add_vertex(v1);
+	add_vertex(v2);
 }
 
 void primitive_batch::add_point_sprite(batch_vertex *p)
 {
-	Vertices.push_back(*p);
+	add_vertex(p);
 }
 
 size_t primitive_batch::load_buffer(batch_vertex* buffer, size_t n_verts)
 {
-	size_t verts_to_render = Vertices.size();
+	size_t remaining = Num_verts;
+	auto dest = buffer + n_verts;
+
+	for ( auto chunk : Chunks ) {
+		auto count = std::min(remaining, batch_vertex_chunk::NUM_VERTS);
+
+		memcpy(dest, chunk->verts, count * sizeof(batch_vertex));
 
-	for ( size_t i = 0; i < verts_to_render; ++i) {
-		buffer[n_verts+i] = Vertices[i];
+		dest += count;
+		remaining -= count;
 	}
 
-	return verts_to_render;
+	return Num_verts;
 }
 
 void primitive_batch::clear()
 {
-	Vertices.clear();
+	Batching_free_chunks.insert(Batching_free_chunks.end(), Chunks.begin(), Chunks.end());
+
+	Chunks.clear();
+	Num_verts = 0;
 }
 
 void batching_setup_vertex_layout(vertex_layout *layout, uint vert_mask)
@@ -95,39 +165,111 @@ void batching_determine_blend_color(color *clr, int texture, float alpha)
 
 primitive_batch_buffer* batching_find_buffer(uint vertex_mask, primitive_type prim_type)
 {
+	if ( Batching_last_buffer != nullptr && Batching_last_buffer_key.Vertex_mask == vertex_mask
+		&& Batching_last_buffer_key.Prim_type == prim_type ) {
+		return Batching_last_buffer;
+	}
+
 	batch_buffer_key query(vertex_mask, prim_type);
 
 	SCP_map<batch_buffer_key, primitive_batch_buffer>::iterator iter = Batching_buffers.find(query);
 
+	primitive_batch_buffer *buffer;
+
 	if ( iter == Batching_buffers.end() ) {
-		primitive_batch_buffer *buffer = &Batching_buffers[query];
+		buffer = &Batching_buffers[query];
 
 		batching_init_buffer(buffer, prim_type, vertex_mask);
-
-		return buffer;
 	} else {
-		return &iter->second;
+		buffer = &iter->second;
+	}
+
+	Batching_last_buffer = buffer;
+	Batching_last_buffer_key = query;
+
+	return buffer;
+}
+
+static size_t batching_hash(const batch_info& info)
+{
+	size_t hash = (size_t)info.texture * 2654435761u;
+
+	hash ^= ((size_t)info.mat_type << 24) ^ ((size_t)info.prim_type << 16) ^ ((size_t)info.thruster << 8);
+
+	return hash ^ (hash >> 15);
+}
+
+static void batching_index_insert(int batch_index)
+{
+	auto mask = Batching_primitive_index.size() - 1;
+	auto slot = batching_hash(Batching_primitives[batch_index].get_render_info()) & mask;
+
+	while ( Batching_primitive_index[slot] >= 0 ) {
+		slot = (slot + 1) & mask;
+	}
+
+	Batching_primitive_index[slot] = batch_index;
+}
+
+static void batching_index_rebuild(size_t size)
+{
+	Batching_primitive_index.assign(size, -1);
+
+	for ( size_t i = 0; i < Batching_primitives.size(); ++i ) {
+		batching_index_insert((int)i);
 	}
 }
 
 primitive_batch* batching_find_batch(int texture, batch_info::material_type material_id, primitive_type prim_type, bool thruster)
 {
+	if ( Batching_last_batch.batch != nullptr && Batching_last_batch.texture == texture
+		&& Batching_last_batch.mat_type == material_id && Batching_last_batch.prim_type == prim_type
+		&& Batching_last_batch.thruster == thruster ) {
+		return Batching_last_batch.batch;
+	}
+
 	// Use the base texture for finding the batch item since all items can reuse the same texture array
 	auto base_tex = bm_get_base_frame(texture);
 
 	batch_info query(material_id, base_tex, prim_type, thruster);
 
-	SCP_map<batch_info, primitive_batch>::iterator iter = Batching_primitives.find(query);
+	primitive_batch* batch = nullptr;
 
-	if ( iter == Batching_primitives.end() ) {
-		primitive_batch* batch = &Batching_primitives[query];
+	if ( !Batching_primitive_index.empty() ) {
+		auto mask = Batching_primitive_index.size() - 1;
 
-		*batch = primitive_batch(query);
+		for ( auto slot = batching_hash(query) & mask; Batching_primitive_index[slot] >= 0; slot = (slot + 1) & mask ) {
+			auto candidate = &Batching_primitives[Batching_primitive_index[slot]];
 
-		return batch;
-	} else {
-		return &iter->second;
+			if ( candidate->get_render_info() == query ) {
+				batch = candidate;
+				break;
+			}
+		}
+	}
+
+	if ( batch == nullptr ) {
+		Batching_primitives.emplace_back(query);
+		batch = &Batching_primitives.back();
+
+		// Keep the table at most half full so the probe sequences stay short
+		if ( Batching_primitives.size() * 2 > Batching_primitive_index.size() ) {
+			batching_index_rebuild(std::max(Batching_primitive_index.size() * 2, (size_t)64));
+		} else {
+			batching_index_insert((int)Batching_primitives.size() - 1);
+		}
+
+		Batching_sorted_primitives.push_back(batch);
+		Batching_sorted_primitives_dirty = true;
 	}
+
+	Batching_last_batch.texture = texture;
+	Batching_last_batch.mat_type = material_id;
+	Batching_last_batch.prim_type = prim_type;
+	Batching_last_batch.thruster = thruster;
+	Batching_last_batch.batch = batch;
+
+	return batch;
 }
 
 uint batching_determine_vertex_layout(batch_info *info)
@@ -813,8 +955,9 @@ void batching_allocate_and_load_buffer(primitive_batch_buffer *draw_queue)
 		offset += item->n_verts;
 	}
 
-	if ( draw_queue->buffer_num >= 0 ) {
-		gr_update_buffer_data(draw_queue->buffer_num, draw_queue->buffer_size, draw_queue->buffer_ptr);
+	// Only upload what has been filled in this frame
+	if ( draw_queue->buffer_num >= 0 && offset > 0 ) {
+		gr_update_buffer_data(draw_queue->buffer_num, offset * sizeof(batch_vertex), draw_queue->buffer_ptr);
 	}
 }
 
@@ -828,9 +971,16 @@ void batching_load_buffers(bool distortion)
 		buffer_iter.second.desired_buffer_size = 0;
 	}
 
+	if ( Batching_sorted_primitives_dirty ) {
+		std::sort(Batching_sorted_primitives.begin(), Batching_sorted_primitives.end(),
+				  [](primitive_batch* a, primitive_batch* b) { return a->get_render_info() < b->get_render_info(); });
+
+		Batching_sorted_primitives_dirty = false;
+	}
+
 	// assign primitive batch items
-	for (auto &bi : Batching_primitives) {
-		if ( bi.first.mat_type == batch_info::DISTORTION ) {
+	for (auto batch : Batching_sorted_primitives) {
+		if ( batch->get_render_info().mat_type == batch_info::DISTORTION ) {
 			if ( !distortion ) {
 				continue;
 			}
@@ -840,10 +990,10 @@ void batching_load_buffers(bool distortion)
 			}
 		}
 
-		size_t num_verts = bi.second.num_verts();
+		size_t num_verts = batch->num_verts();
 
 		if ( num_verts > 0 ) {
-			batch_info render_info = bi.second.get_render_info();
+			batch_info render_info = batch->get_render_info();
 			uint vertex_mask = batching_determine_vertex_layout(&render_info);
 
 			primitive_batch_buffer *buffer = batching_find_buffer(vertex_mask, render_info.prim_type);
@@ -852,7 +1002,7 @@ void batching_load_buffers(bool distortion)
 			draw_item.batch_item_info = render_info;
 			draw_item.offset = 0;
 			draw_item.n_verts = num_verts;
-			draw_item.batch = &bi.second;
+			draw_item.batch = batch;
 
 			buffer->desired_buffer_size += num_verts * sizeof(batch_vertex);
 			buffer->items.push_back(draw_item);
@@ -910,4 +1060,12 @@ void batching_shutdown()
 			batch_buffer->buffer_ptr = nullptr;
 		}
 	}
+
+	Batching_last_batch.batch = nullptr;
+	Batching_sorted_primitives.clear();
+	Batching_primitive_index.clear();
+	Batching_primitives.clear();
+
+	Batching_free_chunks.clear();
+	Batching_chunks.clear();
 }
@@ -48,7 +48,11 @@ struct batch_info {
 			return prim_type < batch.prim_type;
 		}
 
-		return thruster != batch.thruster;
+		return thruster < batch.thruster;
+	}
+
+	bool operator == (const batch_info& batch) const {
+		return mat_type == batch.mat_type && texture == batch.texture && prim_type == batch.prim_type && thruster == batch.thruster;
 	}
 };
 
@@ -68,14 +72,32 @@ struct batch_buffer_key {
 	}
 };
 
+// A fixed size block of vertices, see primitive_batch
+struct batch_vertex_chunk {
+	static const size_t NUM_VERTS = 1020; // a multiple of 6 so that quads never span two chunks
+
+	batch_vertex verts[NUM_VERTS];
+};
+
 class primitive_batch
 {
 	batch_info render_info;
-	SCP_vector<batch_vertex> Vertices;
+
+	// The vertices are stored in chunks from a pool shared by all batches. The chunks are returned to the pool once
+	// the vertices have been copied into the vertex buffer so batches that are only used in some frames do not hold on
+	// to their memory and growing a batch never copies the vertices it already has.
+	SCP_vector<batch_vertex_chunk*> Chunks;
+	size_t Num_verts;
+
+	inline void add_vertex(const batch_vertex* v);
 
 public:
-	primitive_batch() : render_info() {}
-	primitive_batch(batch_info info): render_info(info) {}
+	primitive_batch() : render_info(), Num_verts(0) {}
+	primitive_batch(batch_info info): render_info(info), Num_verts(0) {}
+	~primitive_batch();
+
+	primitive_batch(const primitive_batch&) = delete;
+	primitive_batch& operator=(const primitive_batch&) = delete;
 
 	batch_info &get_render_info() { return render_info; }
 
@@ -84,7 +106,7 @@ public:
 
 	size_t load_buffer(batch_vertex* buffer, size_t n_verts);
 
-	size_t num_verts() { return Vertices.size();  }
+	size_t num_verts() { return Num_verts;  }
 
 	void clear();
 };
@@ -55,6 +55,89 @@ extern int ships_inited;
 namespace scripting {
 namespace api {
 
+namespace {
+
+// Dense list of the object numbers of one kind of object so scripts can index the mission objects in constant time
+// instead of scanning all slots for every element of a loop. Rebuilt whenever the set of objects changes.
+struct mission_object_index {
+	int version = -1;
+	SCP_vector<int> objnums;
+
+	template <typename Builder>
+	const SCP_vector<int>& get(Builder build)
+	{
+		if (version != Object_list_version) {
+			objnums.clear();
+			build(objnums);
+			version = Object_list_version;
+		}
+		return objnums;
+	}
+};
+
+mission_object_index Mission_ship_index;
+mission_object_index Mission_waypoint_index;
+mission_object_index Mission_weapon_index;
+mission_object_index Mission_beam_index;
+
+const SCP_vector<int>& mission_ships()
+{
+	return Mission_ship_index.get([](SCP_vector<int>& objnums) {
+		for (int i = 0; i < MAX_SHIPS; i++) {
+			if (Ships[i].objnum < 0 || Objects[Ships[i].objnum].type != OBJ_SHIP)
+				continue;
+
+			objnums.push_back(Ships[i].objnum);
+		}
+	});
+}
+
+const SCP_vector<int>& mission_waypoints()
+{
+	return Mission_waypoint_index.get([](SCP_vector<int>& objnums) {
+		for (object* ptr = GET_FIRST(&obj_used_list); ptr != END_OF_LIST(&obj_used_list); ptr = GET_NEXT(ptr)) {
+			if (ptr->type == OBJ_WAYPOINT)
+				objnums.push_back(OBJ_INDEX(ptr));
+		}
+	});
+}
+
+const SCP_vector<int>& mission_weapons()
+{
+	return Mission_weapon_index.get([](SCP_vector<int>& objnums) {
+		for (int i = 0; i < MAX_WEAPONS; i++) {
+			if (Weapons[i].weapon_info_index < 0 || Weapons[i].objnum < 0 ||
+				Objects[Weapons[i].objnum].type != OBJ_WEAPON)
+				continue;
+
+			objnums.push_back(Weapons[i].objnum);
+		}
+	});
+}
+
+const SCP_vector<int>& mission_beams()
+{
+	return Mission_beam_index.get([](SCP_vector<int>& objnums) {
+		for (int i = 0; i < MAX_BEAMS; i++) {
+			if (Beams[i].weapon_info_index < 0 || Beams[i].objnum < 0 || Objects[Beams[i].objnum].type != OBJ_BEAM)
+				continue;
+
+			objnums.push_back(Beams[i].objnum);
+		}
+	});
+}
+
+// Looks up a 1-based script index in one of the indices above, returns nullptr if it is out of range
+object* mission_index_lookup(const SCP_vector<int>& objnums, int idx)
+{
+	if (idx < 1 || idx > (int)objnums.size())
+		return nullptr;
+
+	return &Objects[objnums[idx - 1]];
+}
+
+}
+
 
 //**********LIBRARY: Mission
 ADE_LIB(l_Mission, "Mission", "mn", "Mission library");
@@ -312,18 +395,9 @@ ADE_INDEXER(l_Mission_Ships, "number Index/string Name", "Gets ship", "ship", "S
 		idx = atoi(name);
 		if(idx > 0)
 		{
-			int count=1;
-
-			for(int i = 0; i < MAX_SHIPS; i++)
-			{
-				if (Ships[i].objnum < 0 || Objects[Ships[i].objnum].type != OBJ_SHIP)
-					continue;
-
-				if(count == idx) {
-					return ade_set_args(L, "o", l_Ship.Set(object_h(&Objects[Ships[i].objnum])));
-				}
-
-				count++;
+			auto objp = mission_index_lookup(mission_ships(), idx);
+			if (objp != nullptr) {
+				return ade_set_args(L, "o", l_Ship.Set(object_h(objp)));
 			}
 		}
 	}
@@ -333,13 +407,12 @@ ADE_INDEXER(l_Mission_Ships, "number Index/string Name", "Gets ship", "ship", "S
 
 ADE_FUNC(__len, l_Mission_Ships, NULL,
 		 "Number of ships in the mission. "
-			 "This function is somewhat slow, and should be set to a variable for use in looping situations. "
 			 "Note that the value returned is only good until a ship is destroyed, and so cannot be relied on for more than one frame.",
 		 "number",
 		 "Number of ships in the mission, or 0 if ships haven't been initialized yet")
 {
 	if(ships_inited)
-		return ade_set_args(L, "i", ship_get_num_ships());
+		return ade_set_args(L, "i", (int)mission_ships().size());
 	else
 		return ade_set_args(L, "i", 0);
 }
@@ -353,20 +426,9 @@ ADE_INDEXER(l_Mission_Waypoints, "number Index", "Array of waypoints in the curr
 	if(!ade_get_args(L, "*i", &idx))
 		return ade_set_error(L, "o", l_Waypoint.Set(object_h()));
 
-	//Remember, Lua indices start at 0.
-	int count=0;
-
-	object *ptr = GET_FIRST(&obj_used_list);
-	while (ptr != END_OF_LIST(&obj_used_list))
-	{
-		if (ptr->type == OBJ_WAYPOINT)
-			count++;
-
-		if(count == idx) {
-			return ade_set_args(L, "o", l_Waypoint.Set(object_h(ptr)));
-		}
-
-		ptr = GET_NEXT(ptr);
+	auto objp = mission_index_lookup(mission_waypoints(), idx);
+	if (objp != nullptr) {
+		return ade_set_args(L, "o", l_Waypoint.Set(object_h(objp)));
 	}
 
 	return ade_set_error(L, "o", l_Waypoint.Set(object_h()));
@@ -374,14 +436,7 @@ ADE_INDEXER(l_Mission_Waypoints, "number Index", "Array of waypoints in the curr
 
 ADE_FUNC(__len, l_Mission_Waypoints, NULL, "Gets number of waypoints in mission. Note that this is only accurate for one frame.", "number", "Number of waypoints in the mission")
 {
-	uint count=0;
-	for(uint i = 0; i < MAX_OBJECTS; i++)
-	{
-		if (Objects[i].type == OBJ_WAYPOINT)
-			count++;
-	}
-
-	return ade_set_args(L, "i", count);
+	return ade_set_args(L, "i", (int)mission_waypoints().size());
 }
 
 //****SUBLIBRARY: Mission/WaypointLists
@@ -426,26 +481,16 @@ ADE_INDEXER(l_Mission_Weapons, "number Index", "Gets handle to a weapon object i
 	if(!ade_get_args(L, "*i", &idx))
 		return ade_set_error(L, "o", l_Weapon.Set(object_h()));
 
-	//Remember, Lua indices start at 0.
-	int count=1;
-
-	for(int i = 0; i < MAX_WEAPONS; i++)
-	{
-		if (Weapons[i].weapon_info_index < 0 || Weapons[i].objnum < 0 || Objects[Weapons[i].objnum].type != OBJ_WEAPON)
-			continue;
-
-		if(count == idx) {
-			return ade_set_args(L, "o", l_Weapon.Set(object_h(&Objects[Weapons[i].objnum])));
-		}
-
-		count++;
+	auto objp = mission_index_lookup(mission_weapons(), idx);
+	if (objp != nullptr) {
+		return ade_set_args(L, "o", l_Weapon.Set(object_h(objp)));
 	}
 
 	return ade_set_error(L, "o", l_Weapon.Set(object_h()));
 }
 ADE_FUNC(__len, l_Mission_Weapons, NULL, "Number of weapon objects in mission. Note that this is only accurate for one frame.", "number", "Number of weapon objects in mission")
 {
-	return ade_set_args(L, "i", Num_weapons);
+	return ade_set_args(L, "i", (int)mission_weapons().size());
 }
 
 //****SUBLIBRARY: Mission/Beams
@@ -457,26 +502,16 @@ ADE_INDEXER(l_Mission_Beams, "number Index", "Gets handle to a beam object in th
 	if(!ade_get_args(L, "*i", &idx))
 		return ade_set_error(L, "o", l_Beam.Set(object_h()));
 
-	//Remember, Lua indices start at 0.
-	int count=1;
-
-	for(int i = 0; i < MAX_BEAMS; i++)
-	{
-		if (Beams[i].weapon_info_index < 0 || Beams[i].objnum < 0 || Objects[Beams[i].objnum].type != OBJ_BEAM)
-			continue;
-
-		if(count == idx) {
-			return ade_set_args(L, "o", l_Beam.Set(object_h(&Objects[Beams[i].objnum])));
-		}
-
-		count++;
+	auto objp = mission_index_lookup(mission_beams(), idx);
+	if (objp != nullptr) {
+		return ade_set_args(L, "o", l_Beam.Set(object_h(objp)));
 	}
 
 	return ade_set_error(L, "o", l_Beam.Set(object_h()));
 }
 ADE_FUNC(__len, l_Mission_Beams, NULL, "Number of beam objects in mission. Note that this is only accurate for one frame.", "number", "Number of beam objects in mission")
 {
-	return ade_set_args(L, "i", Beam_count);
+	return ade_set_args(L, "i", (int)mission_beams().size());
 }
 
 //****SUBLIBRARY: Mission/Wings
@@ -76,6 +76,7 @@ ADE_VIRTVAR(Type, l_SEXPVariable, "enumeration", "SEXP Variable type, uses SEXPV
 			sv->type |= SEXP_VARIABLE_NUMBER;
 			sv->type &= ~(SEXP_VARIABLE_STRING);
 		}
+		sexp_dependency_mark_changed(SEXP_DEP_VARIABLES);
 	}
 
 	enum_h ren;
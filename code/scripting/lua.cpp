@@ -72,6 +72,9 @@
 
 // End of definitions includes
 
+#include "io/timer.h"
+#include "tracing/Monitor.h"
+
 using namespace scripting;
 using namespace scripting::api;
 
@@ -117,25 +120,14 @@ static int ade_return_hack(lua_State *L)
 	return num;
 }
 
-static void *vm_lua_alloc(void*, void *ptr, size_t, size_t nsize) {
-	if (nsize == 0)
-	{
-		vm_free(ptr);
-		return NULL;
-	}
-	else
-	{
-		return vm_realloc(ptr, nsize);
-	}
-}
-
 //Inits LUA
 //Note that "libraries" must end with a {NULL, NULL}
 //element
 int script_state::CreateLuaState()
 {
 	mprintf(("LUA: Opening LUA state...\n"));
-	lua_State *L = lua_newstate(vm_lua_alloc, nullptr);
+	std::unique_ptr<luacpp::LuaAllocator> allocator(new luacpp::LuaAllocator());
+	lua_State *L = lua_newstate(luacpp::LuaAllocator::allocate, allocator.get());
 
 	if(L == NULL)
 	{
@@ -202,6 +194,11 @@ int script_state::CreateLuaState()
 	mprintf(("ADE: Assigning Lua session...\n"));
 	SetLuaSession(L);
 
+	// The previous state used the old allocator so it may only be replaced once that state is closed
+	LuaAlloc = std::move(allocator);
+	GcCycleRunning = false;
+	GcStartKB = lua_gc(L, LUA_GCCOUNT, 0) * 2;
+
 	//***** LOAD DEFAULT SCRIPTS
 	mprintf(("ADE: Loading default scripts...\n"));
 	load_default_script(L, "cfile_require.lua");
@@ -209,9 +206,67 @@ int script_state::CreateLuaState()
 	return 1;
 }
 
+MONITOR(LuaMemoryKB)
+MONITOR(LuaAllocations)
+MONITOR(LuaGCSteps)
+MONITOR(LuaGCTimeUs)
+
+// Time spent collecting garbage at the end of every frame, more is used if the frame finished early
+static const int LUA_GC_FRAME_BUDGET_US = 250;
+
+// Size of a single collection step in KB, small enough to stay within the budget
+static const int LUA_GC_STEP_SIZE_KB = 8;
+
+// A new cycle is started once memory use has grown by this many percent since the end of the last cycle. Lua itself
+// waits until it has doubled.
+static const int LUA_GC_START_GROWTH = 50;
+
+void script_state::RunGarbageCollector(int budget_us)
+{
+	if (LuaState == nullptr || budget_us <= 0) {
+		return;
+	}
+
+	auto start = timer_get_microseconds();
+	auto end = start + budget_us;
+
+	do {
+		if (!GcCycleRunning) {
+			if (lua_gc(LuaState, LUA_GCCOUNT, 0) < GcStartKB) {
+				break;
+			}
+			GcCycleRunning = true;
+		}
+
+		++GcFrameSteps;
+		if (lua_gc(LuaState, LUA_GCSTEP, LUA_GC_STEP_SIZE_KB)) {
+			GcCycleRunning = false;
+			GcStartKB = lua_gc(LuaState, LUA_GCCOUNT, 0) * (100 + LUA_GC_START_GROWTH) / 100;
+			break;
+		}
+	} while (timer_get_microseconds() < end);
+
+	GcFrameTime += timer_get_microseconds() - start;
+}
+
 void script_state::EndLuaFrame()
 {
 	scripting::api::graphics_on_frame();
+
+	RunGarbageCollector(LUA_GC_FRAME_BUDGET_US);
+
+	if (LuaAlloc) {
+		auto& stats = LuaAlloc->stats();
+
+		mon_LuaMemoryKB = (int)(stats.bytes_in_use / 1024);
+		mon_LuaAllocations = (int)(stats.allocations - GcLastAllocations);
+		GcLastAllocations = stats.allocations;
+	}
+	mon_LuaGCSteps = (int)GcFrameSteps;
+	mon_LuaGCTimeUs = (int)GcFrameTime;
+
+	GcFrameSteps = 0;
+	GcFrameTime = 0;
 }
 
 void ade_output_toc(FILE *fp, ade_table_entry *ate)
@@ -0,0 +1,106 @@
+
+#include "LuaAllocator.h"
+
+namespace luacpp {
+
+LuaAllocator::LuaAllocator() {
+	for (auto& list : _freeLists) {
+		list = nullptr;
+	}
+}
+
+LuaAllocator::~LuaAllocator() {
+	for (auto chunk : _chunks) {
+		vm_free(chunk);
+	}
+}
+
+size_t LuaAllocator::sizeClass(size_t size) {
+	return (size + SIZE_CLASS_GRANULARITY - 1) / SIZE_CLASS_GRANULARITY - 1;
+}
+
+void LuaAllocator::refill(size_t size_class) {
+	auto block_size = (size_class + 1) * SIZE_CLASS_GRANULARITY;
+
+	auto chunk = static_cast<ubyte*>(vm_malloc(CHUNK_SIZE));
+	_chunks.push_back(chunk);
+	_stats.bytes_reserved += CHUNK_SIZE;
+
+	// Link the blocks so that they are handed out in address order
+	FreeBlock* head = _freeLists[size_class];
+	for (auto offset = (CHUNK_SIZE / block_size) * block_size; offset >= block_size; offset -= block_size) {
+		auto block = reinterpret_cast<FreeBlock*>(chunk + offset - block_size);
+		block->next = head;
+		head = block;
+	}
+	_freeLists[size_class] = head;
+}
+
+void* LuaAllocator::allocateBlock(size_t size) {
+	++_stats.allocations;
+	_stats.bytes_in_use += size;
+
+	if (size > MAX_POOLED_SIZE) {
+		return vm_malloc(size);
+	}
+
+	auto size_class = sizeClass(size);
+	if (_freeLists[size_class] == nullptr) {
+		refill(size_class);
+	}
+
+	auto block = _freeLists[size_class];
+	_freeLists[size_class] = block->next;
+
+	return block;
+}
+
+void LuaAllocator::freeBlock(void* ptr, size_t size) {
+	++_stats.frees;
+	_stats.bytes_in_use -= size;
+
+	if (size > MAX_POOLED_SIZE) {
+		vm_free(ptr);
+		return;
+	}
+
+	auto size_class = sizeClass(size);
+	auto block = static_cast<FreeBlock*>(ptr);
+
+	block->next = _freeLists[size_class];
+	_freeLists[size_class] = block;
+}
+
+void* LuaAllocator::allocate(void* ud, void* ptr, size_t osize, size_t nsize) {
+	auto allocator = static_cast<LuaAllocator*>(ud);
+
+	if (ptr == nullptr) {
+		return nsize == 0 ? nullptr : allocator->allocateBlock(nsize);
+	}
+
+	if (nsize == 0) {
+		allocator->freeBlock(ptr, osize);
+		return nullptr;
+	}
+
+	if (osize > MAX_POOLED_SIZE && nsize > MAX_POOLED_SIZE) {
+		// Both sizes live on the normal heap which may be able to resize the block in place
+		allocator->_stats.bytes_in_use += nsize;
+		allocator->_stats.bytes_in_use -= osize;
+		return vm_realloc(ptr, nsize);
+	}
+
+	if (osize <= MAX_POOLED_SIZE && nsize <= MAX_POOLED_SIZE && sizeClass(osize) == sizeClass(nsize)) {
+		allocator->_stats.bytes_in_use += nsize;
+		allocator->_stats.bytes_in_use -= osize;
+		return ptr;
+	}
+
+	auto block = allocator->allocateBlock(nsize);
+	memcpy(block, ptr, std::min(osize, nsize));
+	allocator->freeBlock(ptr, osize);
+
+	return block;
+}
+
+}
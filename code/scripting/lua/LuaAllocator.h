@@ -0,0 +1,66 @@
+#ifndef LUA_ALLOCATOR_H
+#define LUA_ALLOCATOR_H
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace luacpp {
+
+/**
+ * @brief Memory allocator for lua states
+ *
+ * Most allocations of a lua state are small, short lived objects like strings, tables, closures and upvalues. Blocks up
+ * to MAX_POOLED_SIZE bytes are handed out from free lists of fixed size classes which are refilled from larger chunks,
+ * bigger blocks go to the normal heap. Lua always passes the old size of a block so no size has to be stored with it.
+ *
+ * Memory of the free lists is only given back when the allocator is destroyed so it must outlive the lua state using it.
+ */
+class LuaAllocator {
+ public:
+	static const size_t MAX_POOLED_SIZE = 256;
+
+	struct Stats {
+		uint64_t allocations = 0;		//!< Number of allocations, including reallocations that moved a block
+		uint64_t frees = 0;
+		size_t bytes_in_use = 0;		//!< Bytes lua has currently allocated
+		size_t bytes_reserved = 0;		//!< Bytes held in chunks for the size classes
+	};
+
+ private:
+	static const size_t SIZE_CLASS_GRANULARITY = 16;
+	static const size_t NUM_SIZE_CLASSES = MAX_POOLED_SIZE / SIZE_CLASS_GRANULARITY;
+	static const size_t CHUNK_SIZE = 64 * 1024;
+
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	FreeBlock* _freeLists[NUM_SIZE_CLASSES];
+	SCP_vector<void*> _chunks;
+
+	Stats _stats;
+
+	static size_t sizeClass(size_t size);
+
+	void* allocateBlock(size_t size);
+	void freeBlock(void* ptr, size_t size);
+	void refill(size_t size_class);
+
+ public:
+	LuaAllocator();
+	~LuaAllocator();
+
+	LuaAllocator(const LuaAllocator&) = delete;
+	LuaAllocator& operator=(const LuaAllocator&) = delete;
+
+	/**
+	 * @brief The lua_Alloc function, the allocator has to be passed as the user data
+	 */
+	static void* allocate(void* ud, void* ptr, size_t osize, size_t nsize);
+
+	const Stats& stats() const { return _stats; }
+};
+
+}
+
+#endif // LUA_ALLOCATOR_H
@@ -898,6 +898,7 @@ void script_state::Clear()
 
 		lua_close(LuaState);
 	}
+	LuaAlloc.reset();
 
 	StateName[0] = '\0';
 	Langs = 0;
@@ -915,6 +916,12 @@ script_state::script_state(const char *name)
 
 	LuaState = NULL;
 	LuaLibs = NULL;
+
+	GcCycleRunning = false;
+	GcStartKB = 0;
+	GcFrameTime = 0;
+	GcFrameSteps = 0;
+	GcLastAllocations = 0;
 }
 
 script_state::~script_state()
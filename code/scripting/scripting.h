@@ -5,6 +5,7 @@
 #include "globalincs/pstypes.h"
 #include "graphics/2d.h"
 #include "scripting/ade_args.h"
+#include "scripting/lua/LuaAllocator.h"
 #include "scripting/lua/LuaFunction.h"
 #include "utils/event.h"
 
@@ -218,6 +219,14 @@ private:
 	int Langs;
 	struct lua_State *LuaState;
 	const struct script_lua_lib_list *LuaLibs;
+	std::unique_ptr<luacpp::LuaAllocator> LuaAlloc;
+
+	// Garbage collection scheduling, see RunGarbageCollector()
+	bool GcCycleRunning;
+	int GcStartKB;						// Memory use at which the next collection cycle is started
+	uint64_t GcFrameTime;				// Microseconds spent collecting since the last frame ended
+	uint64_t GcFrameSteps;
+	uint64_t GcLastAllocations;
 
 	//Utility variables
 	SCP_vector<image_desc> ScriptImages;
@@ -296,6 +305,18 @@ public:
 	//*****Other functions
 	void EndFrame();
 
+	/**
+	 * @brief Runs incremental garbage collection steps for at most the given time
+	 *
+	 * Called every frame with a small budget and with the time left over before the frame cap is reached. A new
+	 * collection cycle is only started once memory use has grown enough since the last one. Lua still collects on its
+	 * own while a cycle is running or if memory use gets out of hand, this just moves most of that work into time that
+	 * would otherwise be spent waiting.
+	 *
+	 * @param budget_us The time in microseconds that may be spent
+	 */
+	void RunGarbageCollector(int budget_us);
+
 	util::event<void, lua_State*> OnStateDestroy;
 };
 
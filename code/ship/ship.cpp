@@ -63,6 +63,7 @@
 #include "object/objectsnd.h"
 #include "object/waypoint.h"
 #include "parse/parselo.h"
+#include "parse/sexp.h"
 #include "scripting/scripting.h"
 #include "particle/particle.h"
 #include "playerman/player.h"
@@ -2358,6 +2359,11 @@ int parse_warp_params(const WarpParams *inherit_from, WarpDirection direction, c
 	return find_or_add_warp_params(params);
 }
 
+// How long parsing the ship tables spent on the default closeup positions, logged by ship_init()
+static std::uint64_t Closeup_pos_parse_time = 0;
+static int Closeup_pos_from_header = 0;
+static int Closeup_pos_from_model = 0;
+
 /**
  * Puts values into a ship_info.
  */
@@ -3618,22 +3624,37 @@ static int parse_ship_values(ship_info* sip, const bool is_template, const bool
 	}
 	else if (first_time && strlen(sip->pof_file))
 	{
-		//Calculate from the model file. This is inefficient, but whatever
-		int model_idx = model_load(sip->pof_file, 0, NULL);
-		polymodel *pm = model_get(model_idx);
+		//Calculate from the bounding box of the model. Only the header of the model file is read since there is
+		//no need to load the whole model with its textures for this.
+		auto start_time = timer_get_microseconds();
+		vec3d mins, maxs;
+
+		if (model_read_bounding_box(sip->pof_file, &mins, &maxs)) {
+			Closeup_pos_from_header++;
+		} else {
+			Closeup_pos_from_model++;
+
+			//Let the model code report what is wrong with the file
+			int model_idx = model_load(sip->pof_file, 0, NULL);
+			polymodel *pm = model_get(model_idx);
+
+			mins = pm->mins;
+			maxs = pm->maxs;
+
+			model_unload(model_idx);
+		}
+
+		Closeup_pos_parse_time += timer_get_microseconds() - start_time;
 
 		//Go through, find best
-		sip->closeup_pos.xyz.z = fabsf(pm->maxs.xyz.z);
+		sip->closeup_pos.xyz.z = fabsf(maxs.xyz.z);
 
-		float temp = fabsf(pm->mins.xyz.z);
+		float temp = fabsf(mins.xyz.z);
 		if(temp > sip->closeup_pos.xyz.z)
 			sip->closeup_pos.xyz.z = temp;
 
 		//Now multiply by 2
 		sip->closeup_pos.xyz.z *= -2.0f;
-
-		//We're done with the model.
-		model_unload(model_idx);
 	}
 
 	if (optional_string("$Closeup_zoom:")) {
@@ -5327,6 +5348,11 @@ void ship_init()
 			Num_engine_wash_types = 0;
 			strcpy_s(default_player_ship, "");
 
+			auto start_time = timer_get_microseconds();
+			Closeup_pos_parse_time = 0;
+			Closeup_pos_from_header = 0;
+			Closeup_pos_from_model = 0;
+
 			//Parse main TBL first
 			parse_shiptbl("ships.tbl");
 
@@ -5335,6 +5361,9 @@ void ship_init()
 
 			ship_parse_post_cleanup();
 
+			mprintf(("Parsed ship tables in %.1f ms, %.1f ms of it for default closeup positions (%d read from model headers, %d from loaded models)\n",
+				(timer_get_microseconds() - start_time) / 1000.0, Closeup_pos_parse_time / 1000.0, Closeup_pos_from_header, Closeup_pos_from_model));
+
 			ships_inited = 1;
 		}
 
@@ -7380,6 +7409,9 @@ void ship_cleanup(int shipnum, int cleanup_mode)
 	object *objp = &Objects[shipp->objnum];
 	char *jumpnode_name = nullptr;
 
+	// wing counts and the arrival list change even when nothing gets logged, e.g. for vanished ships
+	sexp_dependency_mark_changed(SEXP_DEP_MISSION_LOG);
+
 	// add the information to the exited ship list
 	switch (cleanup_mode) {
 	case SHIP_DESTROYED:
@@ -246,36 +246,24 @@ int ds_get_sid()
 	return (int)(sound_buffers.size() - 1);
 }
 
-int ds_load_buffer(int *sid, int  /*flags*/, ffmpeg::WaveFile* file)
+bool ds_decode_file(ffmpeg::WaveFile* file, ds_pcm_data* pcm)
 {
-	Assert(sid != NULL);
 	Assert(file != NULL);
+	Assert(pcm != NULL);
 
-	// All sounds are required to have a software buffer
-	*sid = ds_get_sid();
-	if (*sid == -1) {
-		nprintf(("Sound", "SOUND ==> No more sound buffers available\n"));
-		return -1;
-	}
-
-	ALuint pi;
-	OpenAL_ErrorCheck(alGenBuffers(1, &pi), return -1);
-
-	ALenum format;
-	ALsizei size = file->getTotalSamples() * file->getSampleByteSize();
-	ALint n_channels = file->getNumChannels();
-	ALsizei frequency;
-		
-	// format is now in pcm
-	frequency = file->getSampleRate();
-	format = file->getALFormat();
+	pcm->format = file->getALFormat();
 
-	if (format == AL_INVALID_VALUE) {
-		return -1;
+	if (pcm->format == AL_INVALID_VALUE) {
+		return false;
 	}
 
-	SCP_vector<uint8_t> audio_buffer;
-	audio_buffer.reserve(size);
+	pcm->sample_rate = file->getSampleRate();
+	pcm->n_channels = file->getNumChannels();
+	pcm->bits_per_sample = (file->getSampleByteSize() / file->getNumChannels()) * 8;
+	pcm->duration = file->getDuration();
+
+	pcm->data.clear();
+	pcm->data.reserve(file->getTotalSamples() * file->getSampleByteSize());
 
 	SCP_vector<uint8_t> buffer(file->getSampleRate() * file->getSampleByteSize());
 	int read;
@@ -284,21 +272,56 @@ int ds_load_buffer(int *sid, int  /*flags*/, ffmpeg::WaveFile* file)
 			// buffer not large enough
 			buffer.resize(buffer.size() * 2);
 		} else {
-			audio_buffer.insert(audio_buffer.end(), buffer.begin(), std::next(buffer.begin(), read));
+			pcm->data.insert(pcm->data.end(), buffer.begin(), std::next(buffer.begin(), read));
 		}
 	}
 
-	Snd_sram += audio_buffer.size();
+	return true;
+}
+
+int ds_load_buffer(int *sid, int  /*flags*/, ffmpeg::WaveFile* file)
+{
+	Assert(sid != NULL);
+	Assert(file != NULL);
+
+	ds_pcm_data pcm;
+	if (!ds_decode_file(file, &pcm)) {
+		return -1;
+	}
+
+	return ds_load_buffer(sid, &pcm);
+}
+
+int ds_load_buffer(int *sid, const ds_pcm_data* pcm)
+{
+	Assert(sid != NULL);
+	Assert(pcm != NULL);
+
+	// All sounds are required to have a software buffer
+	*sid = ds_get_sid();
+	if (*sid == -1) {
+		nprintf(("Sound", "SOUND ==> No more sound buffers available\n"));
+		return -1;
+	}
+
+	if (pcm->format == AL_INVALID_VALUE) {
+		return -1;
+	}
+
+	ALuint pi;
+	OpenAL_ErrorCheck(alGenBuffers(1, &pi), return -1);
+
+	Snd_sram += pcm->data.size();
 
-	OpenAL_ErrorCheck(alBufferData(pi, format, audio_buffer.data(), (ALsizei)audio_buffer.size(), frequency), return -1; );
+	OpenAL_ErrorCheck(alBufferData(pi, pcm->format, pcm->data.data(), (ALsizei)pcm->data.size(), pcm->sample_rate), return -1; );
 
 	sound_buffers[*sid].buf_id = pi;
 	sound_buffers[*sid].channel_id = -1;
-	sound_buffers[*sid].frequency = frequency;
-	sound_buffers[*sid].bits_per_sample = (file->getSampleByteSize() / file->getNumChannels()) * 8;
-	sound_buffers[*sid].nchannels = n_channels;
-	sound_buffers[*sid].nseconds = fl2i(file->getDuration());
-	sound_buffers[*sid].nbytes = (int)audio_buffer.size();
+	sound_buffers[*sid].frequency = pcm->sample_rate;
+	sound_buffers[*sid].bits_per_sample = pcm->bits_per_sample;
+	sound_buffers[*sid].nchannels = pcm->n_channels;
+	sound_buffers[*sid].nseconds = fl2i(pcm->duration);
+	sound_buffers[*sid].nbytes = (int)pcm->data.size();
 
 	return 0;
 }
@@ -56,7 +56,29 @@ using ds_sound_handle = ::util::ID<ds_sound_handle_tag, int, -1>;
 
 int ds_init();
 void ds_close();
+/**
+ * @brief Fully decoded audio data of a sound
+ */
+struct ds_pcm_data {
+	SCP_vector<uint8_t> data;
+	ALenum format = AL_INVALID_VALUE;
+	int sample_rate = 0;
+	int n_channels = 0;
+	int bits_per_sample = 0;
+	double duration = 0.0;	// in seconds
+};
+
+/**
+ * @brief Decodes all remaining audio of a file into memory
+ *
+ * This only uses the passed file so it may be called from other threads.
+ *
+ * @return @c true if successful, @c false if the audio format is not supported
+ */
+bool ds_decode_file(ffmpeg::WaveFile* file, ds_pcm_data* pcm);
+
 int ds_load_buffer(int *sid, int flags, ffmpeg::WaveFile* file);
+int ds_load_buffer(int *sid, const ds_pcm_data* pcm);
 void ds_unload_buffer(int sid);
 ds_sound_handle ds_play(int sid, int snd_id, int priority, const EnhancedSoundData* enhanced_sound_data, float volume,
                         float pan, int looping, bool is_voice_msg = false);
@@ -155,7 +155,7 @@ bool WaveFile::Open(const char* pszFilename, bool keep_ext) {
 				throw FFmpegException("File not found.");
 			}
 
-			cfp = cfopen_special(res.full_name.c_str(), "rb", res.size, res.offset, res.data_ptr, CF_TYPE_ANY);
+			cfp = cfopen_special(res, "rb", CF_TYPE_ANY);
 		}
 		else {
 			// ... otherwise we just find the best match
@@ -174,7 +174,7 @@ bool WaveFile::Open(const char* pszFilename, bool keep_ext) {
 			// set proper filename for later use
 			strcat_s(filename, audio_ext_list[res.extension_index]);
 
-			cfp = cfopen_special(res.full_name.c_str(), "rb", res.size, res.offset, res.data_ptr, CF_TYPE_ANY);
+			cfp = cfopen_special(res, "rb", CF_TYPE_ANY);
 		}
 
 		if (cfp == NULL) {
@@ -182,59 +182,79 @@ bool WaveFile::Open(const char* pszFilename, bool keep_ext) {
 		}
 
 		m_ctx = FFmpegContext::createContext(cfp);
-		auto ctx = m_ctx->ctx();
+		openAudioStream(filename);
+	} catch (const FFmpegException& e) {
+		mprintf(("SOUND ==> Could not open wave file %s for streaming. Reason: %s\n", filename, e.what()));
+		return false;
+	}
 
-		AVCodec* audio_codec = nullptr;
-		m_audioStreamIndex = av_find_best_stream(ctx, AVMEDIA_TYPE_AUDIO, -1, -1, &audio_codec, 0);
-		if (m_audioStreamIndex < 0) {
-			throw FFmpegException("Failed to find audio stream in file.");
-		}
-		m_audioStream = ctx->streams[m_audioStreamIndex];
+	nprintf(("SOUND", "SOUND => Successfully opened: %s\n", filename));
+
+	// If we are here it means that everything went fine
+	return true;
+}
+
+bool WaveFile::OpenMemory(const char* name, const uint8_t* data, size_t size) {
+	using namespace libs::ffmpeg;
+
+	try {
+		m_ctx = FFmpegContext::createContext(data, size);
+		openAudioStream(name);
+	} catch (const FFmpegException& e) {
+		mprintf(("SOUND ==> Could not open wave file %s from memory. Reason: %s\n", name, e.what()));
+		return false;
+	}
+
+	return true;
+}
+
+void WaveFile::openAudioStream(const char* filename) {
+	using namespace libs::ffmpeg;
+
+	auto ctx = m_ctx->ctx();
+
+	AVCodec* audio_codec = nullptr;
+	m_audioStreamIndex = av_find_best_stream(ctx, AVMEDIA_TYPE_AUDIO, -1, -1, &audio_codec, 0);
+	if (m_audioStreamIndex < 0) {
+		throw FFmpegException("Failed to find audio stream in file.");
+	}
+	m_audioStream = ctx->streams[m_audioStreamIndex];
 
-		int err;
+	int err;
 #if LIBAVCODEC_VERSION_INT > AV_VERSION_INT(57, 24, 255)
-        m_audioCodecCtx = avcodec_alloc_context3(audio_codec);
-
-        // Copy codec parameters from input stream to output codec context
-        err = avcodec_parameters_to_context(m_audioCodecCtx, m_audioStream->codecpar);
-        if (err < 0) {
-            char errorStr[512];
-            av_strerror(err, errorStr, sizeof(errorStr));
-            throw FFmpegException(errorStr);
-        }
+    m_audioCodecCtx = avcodec_alloc_context3(audio_codec);
+
+    // Copy codec parameters from input stream to output codec context
+    err = avcodec_parameters_to_context(m_audioCodecCtx, m_audioStream->codecpar);
+    if (err < 0) {
+        char errorStr[512];
+        av_strerror(err, errorStr, sizeof(errorStr));
+        throw FFmpegException(errorStr);
+    }
 #else
-		m_audioCodecCtx = m_audioStream->codec;
+	m_audioCodecCtx = m_audioStream->codec;
 #endif
 
-		err = avcodec_open2(m_audioCodecCtx, audio_codec, nullptr);
-		if (err < 0) {
-			char errorStr[512];
-			av_strerror(err, errorStr, sizeof(errorStr));
-			throw FFmpegException(errorStr);
-		}
-
-		m_baseAudioProps = getAudioProps(m_audioStream);
+	err = avcodec_open2(m_audioCodecCtx, audio_codec, nullptr);
+	if (err < 0) {
+		char errorStr[512];
+		av_strerror(err, errorStr, sizeof(errorStr));
+		throw FFmpegException(errorStr);
+	}
 
-		setAdjustedAudioProperties(getAdjustedAudioProps(m_baseAudioProps));
+	m_baseAudioProps = getAudioProps(m_audioStream);
 
-		if (getALFormat() == AL_INVALID_VALUE) {
-			throw FFmpegException("Invalid audio format.");
-		}
+	setAdjustedAudioProperties(getAdjustedAudioProps(m_baseAudioProps));
 
-		nprintf(("SOUND", "SOUND => %s => Using codec %s (%s)\n", filename, audio_codec->long_name, audio_codec->name));
-	} catch (const FFmpegException& e) {
-		mprintf(("SOUND ==> Could not open wave file %s for streaming. Reason: %s\n", filename, e.what()));
-		return false;
+	if (getALFormat() == AL_INVALID_VALUE) {
+		throw FFmpegException("Invalid audio format.");
 	}
 
+	nprintf(("SOUND", "SOUND => %s => Using codec %s (%s)\n", filename, audio_codec->long_name, audio_codec->name));
+
 	// Cue for streaming
 	Cue();
 	m_frameReader.reset(new FFmpegAudioReader(m_ctx->ctx(), m_audioCodecCtx, m_audioStreamIndex));
-
-	nprintf(("SOUND", "SOUND => Successfully opened: %s\n", filename));
-
-	// If we are here it means that everything went fine
-	return true;
 }
 
 
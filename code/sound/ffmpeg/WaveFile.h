@@ -52,6 +52,8 @@ class WaveFile
 	std::unique_ptr<FFmpegAudioReader> m_frameReader;
 
 	size_t getBufferedData(uint8_t* buffer, size_t buffer_size);
+
+	void openAudioStream(const char* filename);
  public:
 	 WaveFile();
 	 ~WaveFile();
@@ -71,6 +73,18 @@ class WaveFile
 	 */
 	bool Open (const char *pszFilename, bool keep_ext = true);
 
+	/**
+	 * @brief Opens audio data which is already in memory
+	 *
+	 * This does not use the file system so it may be used from a different thread than the main thread.
+	 *
+	 * @param name The name of the sound, only used for log messages
+	 * @param data The contents of the audio file. Must stay valid as long as this object exists.
+	 * @param size The size of the data
+	 * @return @c true if the data was succesfully loaded, @c false otherwise
+	 */
+	bool OpenMemory(const char* name, const uint8_t* data, size_t size);
+
 	/**
 	 * @brief Prepare file for audio reading
 	 *
@@ -25,6 +25,7 @@
 #include "sound/ds.h"
 #include "sound/ds3d.h"
 #include "sound/dscap.h"
+#include "sound/soundloader.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
 
@@ -35,6 +36,7 @@
 const unsigned int SND_ENHANCED_MAX_LIMIT = 15; // seems like a good max limit
 
 #define SND_F_USED			(1<<0)		// Sounds[] element is used
+#define SND_F_LOADING		(1<<1)		// Sounds[] element is still being decoded in the background
 
 typedef struct sound	{
 	int				sid;			// software id
@@ -154,6 +156,10 @@ int snd_init()
 
 	// Init the audio streaming stuff
 	audiostream_init();
+
+	if (!Cmdline_no_async_sound) {
+		snd_loader_init();
+	}
 			
 	ds_initialized = 1;
 	Sound_enabled = TRUE;
@@ -239,6 +245,94 @@ void snd_spew_debug_info()
 	gr_printf_no_resize(sx, sy, "Total sounds : %d\n", game_sounds + interface_sounds + message_sounds);
 }
 
+// Finds the Sounds[] element for a sound file. If the sound is not loaded yet a free element is returned.
+//
+// returns:		true	=>	the sound has already been loaded (or is being loaded) into the returned element
+//				false	=>	the returned element is free
+//
+static bool snd_find_slot(const game_snd_entry* entry, int flags, size_t* slot)
+{
+	size_t n;
+
+	for (n = 0; n < Sounds.size(); n++) {
+		if ( !(Sounds[n].flags & SND_F_USED) ) {
+			break;
+		} else if ( !stricmp( Sounds[n].filename, entry->filename) ) {
+			// the channel count is only known once the sound has been decoded
+			if ( (Sounds[n].flags & SND_F_LOADING) && (flags & GAME_SND_USE_DS3D) ) {
+				snd_finish_loading(sound_load_id(static_cast<int>(n)));
+
+				if ( !(Sounds[n].flags & SND_F_USED) ) {
+					break;
+				}
+			}
+
+			// extra check: make sure the sound is actually loaded in a compatible way (2D vs. 3D)
+			//
+			// NOTE: this will allow a duplicate 3D entry if 2D stereo entry exists,
+			//       but will not load a duplicate 2D entry to get stereo if 3D
+			//       version already loaded
+			if ( (Sounds[n].info.n_channels == 1) || !(flags & GAME_SND_USE_DS3D) ) {
+				*slot = n;
+				return true;
+			}
+		}
+	}
+
+	if ( n == Sounds.size() ) {
+		sound new_sound;
+		new_sound.sid = -1;
+		new_sound.flags = 0;
+
+		Sounds.push_back( new_sound );
+	}
+
+	*slot = n;
+	return false;
+}
+
+// Marks a Sounds[] element as used by the given game sound entry
+static void snd_assign_slot(game_snd_entry* entry, size_t n, int flags)
+{
+	sound* snd = &Sounds[n];
+
+	strcpy_s( snd->filename, entry->filename );
+	snd->flags = flags;
+
+	snd->sig = snd_next_sig++;
+	if (snd_next_sig < 0 ) snd_next_sig = 1;
+	entry->id_sig = snd->sig;
+	entry->id     = sound_load_id(static_cast<int>(n));
+}
+
+#ifndef NDEBUG
+static void snd_warn_multichannel_3d(const char* filename)
+{
+	// Retail has a few sounds that triggers this warning so we need to ignore those
+	const char* warning_ignore_list[] = {
+		"l_hit.wav",
+		"m_hit.wav",
+		"s_hit_2.wav",
+		"Pirate.wav",
+	};
+
+	for (auto& name : warning_ignore_list) {
+		if (!stricmp(name, filename)) {
+			return;
+		}
+	}
+
+	if (mod_supports_version(3, 8, 0)) {
+		// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
+		// with more than one channel. This will silence the warnings for any mod that does not support
+		// 3.8.0.
+		Warning(LOCATION, "Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have one channel.", filename);
+	} else {
+		mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have one channel.\n", filename));
+	}
+}
+#endif
+
 // ---------------------------------------------------------------------------------------
 // snd_load() 
 //
@@ -252,6 +346,8 @@ void snd_spew_debug_info()
 // returns:			success => index of sound in Sounds[] array
 //						failure => -1
 //
+// If the sound is currently being decoded in the background this waits until it is done.
+//
 //int snd_load( char *filename, int hardware, int use_ds3d, int *sig)
 sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_load*/)
 {
@@ -267,27 +363,16 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 	if ( !VALID_FNAME(entry->filename) )
 		return sound_load_id::invalid();
 
-	for (n = 0; n < Sounds.size(); n++) {
+	if ( snd_find_slot(entry, flags, &n) ) {
+		auto id = sound_load_id(static_cast<int>(n));
+
+		snd_finish_loading(id);
+
 		if ( !(Sounds[n].flags & SND_F_USED) ) {
-			break;
-		} else if ( !stricmp( Sounds[n].filename, entry->filename) ) {
-			// extra check: make sure the sound is actually loaded in a compatible way (2D vs. 3D)
-			//
-			// NOTE: this will allow a duplicate 3D entry if 2D stereo entry exists,
-			//       but will not load a duplicate 2D entry to get stereo if 3D
-			//       version already loaded
-			if ( (Sounds[n].info.n_channels == 1) || !(flags & GAME_SND_USE_DS3D) ) {
-				return sound_load_id(static_cast<int>(n));
-			}
+			return sound_load_id::invalid();
 		}
-	}
 
-	if ( n == Sounds.size() ) {
-		sound new_sound;
-		new_sound.sid = -1;
-		new_sound.flags = 0;
-
-		Sounds.push_back( new_sound );
+		return id;
 	}
 
 	snd = &Sounds[n];
@@ -316,32 +401,7 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 			audio_file->setAdjustedAudioProperties(current);
 
 #ifndef NDEBUG
-            // Retail has a few sounds that triggers this warning so we need to ignore those
-            const char* warning_ignore_list[] = {
-				"l_hit.wav",
-				"m_hit.wav",
-				"s_hit_2.wav",
-				"Pirate.wav",
-			};
-
-			bool show_warning = true;
-			for (auto& name : warning_ignore_list) {
-				if (!stricmp(name, entry->filename)) {
-					show_warning = false;
-					break;
-				}
-			}
-
-			if (show_warning) {
-				if (mod_supports_version(3, 8, 0)) {
-					// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
-					// with more than one channel. This will silence the warnings for any mod that does not support
-					// 3.8.0.
-					Warning(LOCATION, "Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have one channel.", entry->filename);
-				} else {
-					mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have one channel.\n", entry->filename));
-				}
-			}
+			snd_warn_multichannel_3d(entry->filename);
 #endif
 		}
 	}
@@ -364,19 +424,135 @@ sound_load_id snd_load(game_snd_entry* entry, int flags, int /*allow_hardware_lo
 	// NOTE: "si" values can change once loaded in the buffer
 	snd->duration = fl2i(1000.0f * audio_file->getDuration());
 
-	strcpy_s( snd->filename, entry->filename );
-	snd->flags = SND_F_USED;
-
-	snd->sig = snd_next_sig++;
-	if (snd_next_sig < 0 ) snd_next_sig = 1;
-	entry->id_sig = snd->sig;
-	entry->id     = sound_load_id(static_cast<int>(n));
+	snd_assign_slot(entry, n, SND_F_USED);
 
 	nprintf(("Sound", "SOUND ==> Finished loading '%s'\n", entry->filename));
 
 	return sound_load_id(static_cast<int>(n));
 }
 
+// ---------------------------------------------------------------------------------------
+// snd_preload() 
+//
+// Same as snd_load() but the sound is decoded in the background.  The sound can be played
+// once decoding has finished, functions that need the sound data wait for it.
+//
+sound_load_id snd_preload(game_snd_entry* entry, int flags)
+{
+	size_t n;
+
+	if ( Cmdline_no_async_sound )
+		return snd_load(entry, flags);
+
+	if ( !ds_initialized )
+		return sound_load_id::invalid();
+
+	if ( !VALID_FNAME(entry->filename) )
+		return sound_load_id::invalid();
+
+	if ( snd_find_slot(entry, flags, &n) ) {
+		return sound_load_id(static_cast<int>(n));
+	}
+
+	nprintf(("Sound", "SOUND ==> Queueing '%s'\n", entry->filename));
+
+	auto sig = snd_next_sig;
+	if ( !snd_loader_queue(static_cast<int>(n), sig, entry->filename, (flags & GAME_SND_USE_DS3D) != 0) ) {
+		nprintf(("Sound", "SOUND ==> Could not find '%s'\n", entry->filename));
+		return sound_load_id::invalid();
+	}
+
+	sound* snd = &Sounds[n];
+	snd->sid = -1;
+	snd->info = sound_info();
+	snd->uncompressed_size = 0;
+	snd->duration = 0;
+
+	snd_assign_slot(entry, n, SND_F_USED | SND_F_LOADING);
+	Assert(snd->sig == sig);
+
+	return sound_load_id(static_cast<int>(n));
+}
+
+// Uploads a sound that has been decoded in the background
+static void snd_finish_decoded(snd_decoded_sound& decoded)
+{
+	if ( (decoded.id < 0) || ((size_t)decoded.id >= Sounds.size()) ) {
+		return;
+	}
+
+	sound* snd = &Sounds[decoded.id];
+
+	// the sound may have been unloaded in the meantime
+	if ( !(snd->flags & SND_F_LOADING) || (snd->sig != decoded.sig) ) {
+		return;
+	}
+
+	snd->flags &= ~SND_F_LOADING;
+
+	if ( !decoded.success ) {
+		nprintf(("Sound", "SOUND ==> Failed to decode '%s'\n", snd->filename));
+		snd->flags = 0;
+		return;
+	}
+
+#ifndef NDEBUG
+	if ( decoded.mono && (decoded.source_channels > 1) ) {
+		snd_warn_multichannel_3d(snd->filename);
+	}
+#endif
+
+	auto& pcm = decoded.pcm;
+	auto si = &snd->info;
+
+	si->n_channels			= pcm.n_channels;
+	si->sample_rate			= pcm.sample_rate;
+	si->avg_bytes_per_sec	= pcm.sample_rate * (pcm.bits_per_sample / 8) * pcm.n_channels;
+	si->bits				= pcm.bits_per_sample;
+	si->size				= (uint)pcm.data.size();
+
+	snd->uncompressed_size = si->size;
+
+	if (ds_load_buffer(&snd->sid, &pcm) == -1) {
+		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", snd->filename));
+		snd->sid = -1;
+		snd->flags = 0;
+		return;
+	}
+
+	snd->duration = fl2i(1000.0f * pcm.duration);
+
+	nprintf(("Sound", "SOUND ==> Finished loading '%s'%s\n", snd->filename, decoded.from_cache ? " from the cache" : ""));
+}
+
+// ---------------------------------------------------------------------------------------
+// snd_finish_loading() 
+//
+// Waits until a sound that is decoded in the background is ready
+//
+void snd_finish_loading(sound_load_id n)
+{
+	if ( !n.isValid() || ((size_t)n.value() >= Sounds.size()) ) {
+		return;
+	}
+
+	while ( Sounds[n.value()].flags & SND_F_LOADING ) {
+		snd_decoded_sound decoded;
+
+		if ( !snd_loader_get_decoded(decoded, true) ) {
+			// The loader lost track of this sound, this should never happen
+			Sounds[n.value()].flags = 0;
+			break;
+		}
+
+		snd_finish_decoded(decoded);
+
+		if ( (size_t)n.value() >= Sounds.size() ) {
+			break;
+		}
+	}
+}
+
 // ---------------------------------------------------------------------------------------
 // snd_unload() 
 //
@@ -398,6 +574,9 @@ int snd_unload(sound_load_id n)
 
 	auto& snd = Sounds[n.value()];
 
+	// a sound that is still being decoded is discarded once the decoding is done
+	snd.flags &= ~SND_F_LOADING;
+
 	ds_unload_buffer(snd.sid);
 
 	if (snd.sid != -1) {
@@ -437,9 +616,13 @@ void snd_close(void)
 {
 	snd_stop_all();
 	if (!ds_initialized) return;
+	snd_loader_close();
 	snd_unload_all();		// free the sound data stored in DirectSound secondary buffers
 	dscap_close();	// Close DirectSoundCapture
 	ds_close();		// Close DirectSound off
+
+	// allows snd_init() to open the device again
+	ds_initialized = 0;
 }
 
 // ---------------------------------------------------------------------------------------
@@ -535,6 +718,10 @@ sound_handle snd_play(game_snd* gs, float pan, float vol_scale, int priority, bo
 	if ( !(snd->flags & SND_F_USED) )
 		return sound_handle::invalid();
 
+	// not playable until it has been decoded
+	if ( snd->flags & SND_F_LOADING )
+		return sound_handle::invalid();
+
 	if (!ds_initialized)
 		return sound_handle::invalid();
 
@@ -613,6 +800,10 @@ sound_handle snd_play_3d(game_snd* gs, vec3d* source_pos, vec3d* listen_pos, flo
 	if ( !(snd->flags & SND_F_USED) )
 		return sound_handle::invalid();
 
+	// not playable until it has been decoded
+	if ( snd->flags & SND_F_LOADING )
+		return sound_handle::invalid();
+
 	if (snd->sid < 0) {
 		return sound_handle::invalid();
 	}
@@ -815,6 +1006,9 @@ sound_handle snd_play_looping(game_snd* gs, float pan, int /*start_loop*/, int /
 	if (!entry->id.isValid())
 		return sound_handle::invalid();
 
+	// looping sounds are usually only started once so don't skip them
+	snd_finish_loading(entry->id);
+
 	snd = &Sounds[entry->id.value()];
 
 	if ( !(snd->flags & SND_F_USED) )
@@ -1064,6 +1258,8 @@ int snd_get_duration(sound_load_id snd_id)
 	if ( Sounds.empty() )
 		return 0;
 
+	snd_finish_loading(snd_id);
+
 	Assertion(Sounds[snd_id.value()].duration > 0, "Sound duration for sound %s is bogus (%d)\n",
 	          Sounds[snd_id.value()].filename, Sounds[snd_id.value()].duration);
 
@@ -1193,6 +1389,8 @@ int snd_get_data(sound_load_id handle, char* data)
 {
 	Assert(handle.isValid());
 
+	snd_finish_loading(handle);
+
 	if (ds_get_data(Sounds[handle.value()].sid, data)) {
 		return -1;
 	}
@@ -1205,6 +1403,8 @@ int snd_size(sound_load_id handle, int* size)
 {
 	Assert(handle.isValid());
 
+	snd_finish_loading(handle);
+
 	if (ds_get_size(Sounds[handle.value()].sid, size)) {
 		return -1;
 	}
@@ -1217,6 +1417,8 @@ void snd_get_format(sound_load_id handle, int* bits_per_sample, int* frequency)
 {
 	Assert((handle.isValid()) && ((size_t)handle.value() < Sounds.size()));
 
+	snd_finish_loading(handle);
+
 	if (bits_per_sample)
 		*bits_per_sample = Sounds[handle.value()].info.bits;
 
@@ -1369,6 +1571,14 @@ int sound_env_supported()
 void adjust_volume_on_frame(float* volume_now, aav* data);
 void snd_do_frame()
 {
+	// make the sounds that have been decoded in the background playable
+	if (!Cmdline_no_async_sound && ds_initialized) {
+		snd_decoded_sound decoded;
+		while (snd_loader_get_decoded(decoded, false)) {
+			snd_finish_decoded(decoded);
+		}
+	}
+
 	adjust_volume_on_frame(&aav_music_volume, &aav_data[AAV_MUSIC]);
 	adjust_volume_on_frame(&aav_voice_volume, &aav_data[AAV_VOICE]);
 	adjust_volume_on_frame(&aav_effect_volume, &aav_data[AAV_EFFECTS]);
@@ -124,6 +124,12 @@ extern float aav_effect_volume;
 //int	snd_load( char *filename, int hardware=0, int three_d=0, int *sig=NULL );
 sound_load_id snd_load(game_snd_entry* entry, int flags, int allow_hardware_load = 0);
 
+// Like snd_load() but decodes the sound in the background. The sound can't be played until decoding has finished.
+sound_load_id snd_preload(game_snd_entry* entry, int flags);
+
+// Waits until a sound queued with snd_preload() has been decoded
+void snd_finish_loading(sound_load_id n);
+
 int snd_unload(sound_load_id sndnum);
 void	snd_unload_all();
 
@@ -0,0 +1,414 @@
+#include "sound/soundloader.h"
+
+#include "cfile/cfile.h"
+#include "cfile/cfilesystem.h"
+#include "cmdline/cmdline.h"
+#include "sound/audiostr.h"
+#include "sound/ffmpeg/WaveFile.h"
+#include "tracing/tracing.h"
+
+#include <md5.h>
+
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Increase this whenever the layout of the cache files or the decoding output changes
+const uint32_t PCM_CACHE_VERSION = 1;
+
+const char* const PCM_CACHE_PREFIX = "snd_pcm-";
+
+// Decoded sounds are much larger than their sources so the cache is pruned to this size when the loader starts
+const size_t PCM_CACHE_MAX_SIZE = 512 * 1024 * 1024;
+
+struct pcm_cache_header {
+	char magic[4];
+	uint32_t version;
+	int32_t format;
+	int32_t sample_rate;
+	int32_t n_channels;
+	int32_t bits_per_sample;
+	int32_t source_channels;
+	double duration;
+	uint64_t data_size;
+};
+
+struct decode_job {
+	int id = -1;
+	int sig = -1;
+	SCP_string filename;
+	CFileLocation location;
+	bool mono = false;
+	int sound_quality = 0;
+	int float_supported = 0;
+};
+
+std::mutex Loader_mutex;
+std::condition_variable Loader_job_added;
+std::condition_variable Loader_job_done;
+
+SCP_deque<decode_job> Loader_jobs;
+SCP_deque<snd_decoded_sound> Loader_results;
+size_t Loader_jobs_running = 0;
+bool Loader_shutdown = false;
+
+SCP_vector<std::thread> Loader_threads;
+
+// Path prefix of the cache files, empty if the cache is disabled
+SCP_string Loader_cache_prefix;
+
+bool read_source(const decode_job& job, SCP_vector<uint8_t>& buffer)
+{
+	buffer.resize(job.location.size);
+
+	// The file system is not thread safe so the file is read directly from the location which already points into the
+	// right pack file if necessary
+	return cf_read_location(job.location, buffer.data());
+}
+
+SCP_string get_cache_key(const decode_job& job, const SCP_vector<uint8_t>& source)
+{
+	MD5 md5;
+	md5.update(reinterpret_cast<const char*>(source.data()), (MD5::size_type)source.size());
+
+	// The output format depends on these so they are part of the key
+	int32_t params[] = { (int32_t)PCM_CACHE_VERSION, job.mono ? 1 : 0, job.sound_quality, job.float_supported };
+	md5.update(reinterpret_cast<const char*>(params), sizeof(params));
+
+	md5.finalize();
+
+	return md5.hexdigest();
+}
+
+// Marks a cache file as recently used so pruning the cache removes it last
+void touch_cache_file(const SCP_string& path)
+{
+#ifdef _WIN32
+	_utime(path.c_str(), nullptr);
+#else
+	utime(path.c_str(), nullptr);
+#endif
+}
+
+}
+
+bool snd_loader_read_cache(const SCP_string& path, snd_decoded_sound& result)
+{
+	auto fp = fopen(path.c_str(), "rb");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	pcm_cache_header header;
+	bool success = fread(&header, sizeof(header), 1, fp) == 1 && memcmp(header.magic, "SPCM", 4) == 0 &&
+		header.version == PCM_CACHE_VERSION;
+
+	if (success) {
+		result.pcm.format = header.format;
+		result.pcm.sample_rate = header.sample_rate;
+		result.pcm.n_channels = header.n_channels;
+		result.pcm.bits_per_sample = header.bits_per_sample;
+		result.pcm.duration = header.duration;
+		result.source_channels = header.source_channels;
+
+		result.pcm.data.resize((size_t)header.data_size);
+		success = fread(result.pcm.data.data(), 1, result.pcm.data.size(), fp) == result.pcm.data.size();
+	}
+
+	fclose(fp);
+
+	return success;
+}
+
+void snd_loader_write_cache(const SCP_string& path, const snd_decoded_sound& result)
+{
+	pcm_cache_header header;
+	memcpy(header.magic, "SPCM", 4);
+	header.version = PCM_CACHE_VERSION;
+	header.format = result.pcm.format;
+	header.sample_rate = result.pcm.sample_rate;
+	header.n_channels = result.pcm.n_channels;
+	header.bits_per_sample = result.pcm.bits_per_sample;
+	header.source_channels = result.source_channels;
+	header.duration = result.pcm.duration;
+	header.data_size = result.pcm.data.size();
+
+	// Write to a temporary file first so a different instance of the game never sees a partial file
+	auto tmp_path = path + ".tmp";
+
+	auto fp = fopen(tmp_path.c_str(), "wb");
+	if (fp == nullptr) {
+		return;
+	}
+
+	bool success = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+		fwrite(result.pcm.data.data(), 1, result.pcm.data.size(), fp) == result.pcm.data.size();
+
+	success = fclose(fp) == 0 && success;
+
+	if (!success || rename(tmp_path.c_str(), path.c_str()) != 0) {
+		remove(tmp_path.c_str());
+	}
+}
+
+namespace {
+
+bool decode(const decode_job& job, const SCP_vector<uint8_t>& source, snd_decoded_sound& result)
+{
+	ffmpeg::WaveFile audio_file;
+
+	if (!audio_file.OpenMemory(job.filename.c_str(), source.data(), source.size())) {
+		return false;
+	}
+
+	result.source_channels = audio_file.getNumChannels();
+
+	if (job.mono && audio_file.getNumChannels() > 1) {
+		// We need to resample the audio down to one channel
+		auto current = audio_file.getAudioProperties();
+		current.channel_layout = AV_CH_LAYOUT_MONO;
+
+		audio_file.setAdjustedAudioProperties(current);
+	}
+
+	return ds_decode_file(&audio_file, &result.pcm);
+}
+
+void run_job(const decode_job& job, snd_decoded_sound& result)
+{
+	SCP_vector<uint8_t> source;
+	if (!read_source(job, source)) {
+		return;
+	}
+
+	SCP_string cache_path;
+	if (!Loader_cache_prefix.empty()) {
+		cache_path = Loader_cache_prefix + get_cache_key(job, source) + ".bin";
+
+		if (snd_loader_read_cache(cache_path, result)) {
+			touch_cache_file(cache_path);
+
+			result.success = true;
+			result.from_cache = true;
+			return;
+		}
+	}
+
+	if (!decode(job, source, result)) {
+		return;
+	}
+
+	result.success = true;
+
+	if (!cache_path.empty()) {
+		snd_loader_write_cache(cache_path, result);
+	}
+}
+
+void loader_thread()
+{
+	std::unique_lock<std::mutex> lock(Loader_mutex);
+
+	while (true) {
+		Loader_job_added.wait(lock, []() { return Loader_shutdown || !Loader_jobs.empty(); });
+
+		if (Loader_shutdown) {
+			return;
+		}
+
+		auto job = std::move(Loader_jobs.front());
+		Loader_jobs.pop_front();
+		++Loader_jobs_running;
+
+		lock.unlock();
+
+		snd_decoded_sound result;
+		result.id = job.id;
+		result.sig = job.sig;
+		result.mono = job.mono;
+
+		run_job(job, result);
+
+		lock.lock();
+
+		--Loader_jobs_running;
+		Loader_results.push_back(std::move(result));
+
+		Loader_job_done.notify_all();
+	}
+}
+
+}
+
+void snd_loader_init()
+{
+	if (!Loader_threads.empty()) {
+		return;
+	}
+
+	Loader_cache_prefix.clear();
+	if (!Cmdline_no_sound_cache) {
+		const auto location_flags = CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT;
+
+		cf_create_directory(CF_TYPE_CACHE, location_flags);
+		cf_create_default_path_string(Loader_cache_prefix, CF_TYPE_CACHE, PCM_CACHE_PREFIX, false, location_flags);
+
+		// Without a real directory there is no place for the cache
+		if (Loader_cache_prefix.find(DIR_SEPARATOR_CHAR) == SCP_string::npos) {
+			Loader_cache_prefix.clear();
+		}
+
+		snd_loader_prune_cache(PCM_CACHE_MAX_SIZE);
+	}
+
+	Loader_shutdown = false;
+
+	// Leave one core for the main thread
+	auto num_threads = std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, 4u);
+
+	for (uint i = 0; i < num_threads; ++i) {
+		Loader_threads.emplace_back(loader_thread);
+	}
+
+	mprintf(("SOUND => Decoding sounds with %u background threads\n", num_threads));
+}
+
+void snd_loader_close()
+{
+	{
+		std::lock_guard<std::mutex> lock(Loader_mutex);
+		Loader_shutdown = true;
+		Loader_jobs.clear();
+	}
+	Loader_job_added.notify_all();
+	Loader_job_done.notify_all();
+
+	for (auto& thread : Loader_threads) {
+		thread.join();
+	}
+	Loader_threads.clear();
+
+	Loader_results.clear();
+	Loader_jobs_running = 0;
+}
+
+void snd_loader_prune_cache(size_t max_size)
+{
+	if (Loader_cache_prefix.empty()) {
+		return;
+	}
+
+	auto cache_dir = Loader_cache_prefix.substr(0, Loader_cache_prefix.find_last_of(DIR_SEPARATOR_CHAR) + 1);
+
+	// This lists the same directory the cache prefix points to
+	SCP_vector<SCP_string> names;
+	cf_get_file_list(names, CF_TYPE_CACHE, (SCP_string(PCM_CACHE_PREFIX) + "*.bin").c_str(), CF_SORT_NONE, nullptr,
+	                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+
+	struct cache_file {
+		SCP_string path;
+		time_t last_used;
+		size_t size;
+	};
+
+	SCP_vector<cache_file> files;
+	size_t total_size = 0;
+
+	for (auto& name : names) {
+		cache_file file;
+		file.path = cache_dir + name + ".bin";
+
+		struct stat buf;
+		if (stat(file.path.c_str(), &buf) != 0) {
+			continue;
+		}
+
+		file.last_used = buf.st_mtime;
+		file.size = (size_t)buf.st_size;
+
+		total_size += file.size;
+		files.push_back(std::move(file));
+	}
+
+	if (total_size <= max_size) {
+		return;
+	}
+
+	std::sort(files.begin(), files.end(),
+	          [](const cache_file& a, const cache_file& b) { return a.last_used < b.last_used; });
+
+	int num_removed = 0;
+	for (auto& file : files) {
+		if (total_size <= max_size) {
+			break;
+		}
+
+		if (remove(file.path.c_str()) == 0) {
+			total_size -= file.size;
+			++num_removed;
+		}
+	}
+
+	mprintf(("SOUND => Removed %d decoded sounds from the cache, " SIZE_T_ARG " bytes are left\n", num_removed, total_size));
+}
+
+bool snd_loader_queue(int id, int sig, const char* filename, bool mono)
+{
+	Assertion(!Loader_threads.empty(), "The sound loader has not been initialized!");
+
+	auto res = cf_find_file_location_ext(filename, NUM_AUDIO_EXT, audio_ext_list, CF_TYPE_ANY, false);
+
+	if (!res.found) {
+		return false;
+	}
+
+	decode_job job;
+	job.id = id;
+	job.sig = sig;
+	job.filename = filename;
+	job.location = res;
+	job.mono = mono;
+	job.sound_quality = Ds_sound_quality;
+	job.float_supported = Ds_float_supported;
+
+	{
+		std::lock_guard<std::mutex> lock(Loader_mutex);
+		Loader_jobs.push_back(std::move(job));
+	}
+	Loader_job_added.notify_one();
+
+	return true;
+}
+
+bool snd_loader_get_decoded(snd_decoded_sound& result, bool wait)
+{
+	std::unique_lock<std::mutex> lock(Loader_mutex);
+
+	if (wait) {
+		TRACE_SCOPE(tracing::LoadSound);
+
+		Loader_job_done.wait(lock, []() {
+			return Loader_shutdown || !Loader_results.empty() || (Loader_jobs.empty() && Loader_jobs_running == 0);
+		});
+	}
+
+	if (Loader_results.empty()) {
+		return false;
+	}
+
+	result = std::move(Loader_results.front());
+	Loader_results.pop_front();
+
+	return true;
+}
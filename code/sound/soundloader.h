@@ -0,0 +1,82 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "sound/ds.h"
+
+/**
+ * @brief The result of decoding a sound in the background
+ */
+struct snd_decoded_sound {
+	int id = -1;	// The Sounds[] index this sound was queued for
+	int sig = -1;	// The signature the Sounds[] entry had when the sound was queued
+	bool success = false;
+	bool mono = false;	// The sound was converted to one channel
+	bool from_cache = false;	// The sound was read from the on-disk cache instead of being decoded
+	int source_channels = 0;	// The number of channels in the sound file
+	ds_pcm_data pcm;
+};
+
+/**
+ * @brief Starts the threads that decode sounds in the background
+ *
+ * Must be called after the file system has been initialized.
+ */
+void snd_loader_init();
+
+/**
+ * @brief Stops the decoding threads and discards all sounds that have not been retrieved yet
+ */
+void snd_loader_close();
+
+/**
+ * @brief Queues a sound file for decoding
+ *
+ * The file is located in the file system before this returns so this must be called from the main thread. Decoded
+ * sounds are kept in an on-disk cache keyed by the contents of the source file and the output format so later loads
+ * of the same sound can skip decoding.
+ *
+ * @param id The Sounds[] index to decode the sound for
+ * @param sig The signature of the Sounds[] entry
+ * @param filename The file name of the sound. Any audio extension is accepted.
+ * @param mono @c true if the sound has to be converted to one channel for 3D playback
+ * @return @c false if the file could not be found
+ */
+bool snd_loader_queue(int id, int sig, const char* filename, bool mono);
+
+/**
+ * @brief Retrieves a decoded sound
+ *
+ * @param result The decoded sound is moved into this
+ * @param wait @c true to wait until a queued sound has been decoded
+ * @return @c true if a sound has been retrieved, @c false if there are no decoded sounds (or no queued ones if @c wait
+ * is set)
+ */
+bool snd_loader_get_decoded(snd_decoded_sound& result, bool wait);
+
+/**
+ * @brief Removes the least recently used sounds from the on-disk cache until it is no larger than the given size
+ *
+ * This is done by snd_loader_init(). It must not be called while sounds are being decoded.
+ *
+ * @param max_size The maximum size of all cache files in bytes
+ */
+void snd_loader_prune_cache(size_t max_size);
+
+/**
+ * @brief Reads a decoded sound from a cache file
+ *
+ * @param path The full path of the cache file
+ * @param result Receives the sound data and format
+ * @return @c false if the file does not exist or is not a valid cache file of this version
+ */
+bool snd_loader_read_cache(const SCP_string& path, snd_decoded_sound& result);
+
+/**
+ * @brief Writes a decoded sound to a cache file
+ *
+ * The file is written under a temporary name first so no other reader ever sees a partial file.
+ *
+ * @param path The full path of the cache file
+ * @param result The sound to write
+ */
+void snd_loader_write_cache(const SCP_string& path, const snd_decoded_sound& result);
@@ -64,6 +64,7 @@ add_file_folder("CFile"
 	cfile/cfilelist.cpp
 	cfile/cfilesystem.cpp
 	cfile/cfilesystem.h
+	cfile/vpformat.h
 )
 
 # Cmdline files
@@ -331,6 +332,7 @@ IF (WIN32)
 ENDIF(WIN32)
 
 add_file_folder("GlobalIncs\\\\Memory"
+	globalincs/memory/frame_arena.cpp
 	globalincs/memory/memory.h
 	globalincs/memory/memory.cpp
 	globalincs/memory/utils.h
@@ -630,6 +632,7 @@ add_file_folder("Math"
 	math/staticrand.h
 	math/vecmat.cpp
 	math/vecmat.h
+	math/vecmat_batch.cpp
 )
 
 # MenuUI files
@@ -900,6 +903,8 @@ add_file_folder("Parse\\\\SEXP"
 	parse/sexp/DynamicSEXP.h
 	parse/sexp/LuaSEXP.cpp
 	parse/sexp/LuaSEXP.h
+	parse/sexp/sexp_compiler.cpp
+	parse/sexp/sexp_compiler.h
 	parse/sexp/sexp_lookup.cpp
 	parse/sexp/sexp_lookup.h
 )
@@ -1183,6 +1188,8 @@ add_file_folder("Scripting\\\\Api\\\\Objs"
 )
 
 add_file_folder("Scripting\\\\Lua"
+	scripting/lua/LuaAllocator.cpp
+	scripting/lua/LuaAllocator.h
 	scripting/lua/LuaArgs.cpp
 	scripting/lua/LuaArgs.h
 	scripting/lua/LuaConvert.cpp
@@ -1240,6 +1247,8 @@ add_file_folder("Sound"
 	sound/rtvoice.h
 	sound/sound.cpp
 	sound/sound.h
+	sound/soundloader.cpp
+	sound/soundloader.h
 	sound/speech.cpp
 	sound/speech.h
 	sound/voicerec.cpp
@@ -1292,6 +1301,8 @@ add_file_folder("Tracing"
 	tracing/categories.h
 	tracing/FrameProfiler.h
 	tracing/FrameProfiler.cpp
+	tracing/hwcounters.cpp
+	tracing/hwcounters.h
 	tracing/MainFrameTimer.h
 	tracing/MainFrameTimer.cpp
 	tracing/Monitor.h
@@ -1331,7 +1342,11 @@ add_file_folder("Utils"
     utils/event.h
 	utils/HeapAllocator.cpp
 	utils/HeapAllocator.h
+	utils/RadixSort.cpp
+	utils/RadixSort.h
 	utils/id.h
+	utils/parallel.cpp
+	utils/parallel.h
 	utils/RandomRange.h
 	utils/string_utils.cpp
 	utils/string_utils.h
@@ -5,6 +5,8 @@
 
 #include "globalincs/systemvars.h"
 
+#include <cinttypes>
+
 using namespace tracing;
 
 namespace {
@@ -102,6 +104,11 @@ void process_end(SCP_vector<profile_sample>& samples, const trace_event& evt) {
 			// save sample time in accumulator
 			samples[i].accumulator += end_time - samples[i].start_time;
 
+			samples[i].counters += evt.counters;
+			if (parent >= 0) {
+				samples[parent].children_counters += evt.counters;
+			}
+
 			break;
 		}
 	}
@@ -232,8 +239,18 @@ void FrameProfiler::dump_output(SCP_stringstream& out,
 								uint64_t  /*start_profile_time*/,
 								uint64_t  /*end_profile_time*/,
 								SCP_vector<profile_sample>& samples) {
-	out << "  Avg :  Min :  Max :   # : Profile Name\n";
-	out << "----------------------------------------\n";
+	bool has_hw_counters = false;
+	for (auto& sample : samples) {
+		has_hw_counters = has_hw_counters || sample.counters.has_hw_counters;
+	}
+
+	if (has_hw_counters) {
+		out << "  Avg :  Min :  Max :   # : Allocs :  IPC : LLC miss : Br miss : Profile Name\n";
+		out << "-------------------------------------------------------------------------\n";
+	} else {
+		out << "  Avg :  Min :  Max :   # : Allocs : Profile Name\n";
+		out << "-------------------------------------------------\n";
+	}
 
 	for (int i = 0; i < (int) samples.size(); i++) {
 		uint64_t sample_time;
@@ -268,8 +285,19 @@ void FrameProfiler::dump_output(SCP_stringstream& out,
 		}
 		indented_name += samples[i].name;
 
+		// Like the time only count what happened outside of the child samples
+		auto counters = samples[i].counters;
+		counters -= samples[i].children_counters;
+
 		char line[256];
-		sprintf_safe(line, "%5s : %5s : %5s : %3s : ", avg, min, max, num);
+		sprintf_safe(line, "%5s : %5s : %5s : %3s : %6" PRIu64 " : ", avg, min, max, num, counters.allocations);
+
+		if (has_hw_counters) {
+			char hw_line[128];
+			float ipc = counters.cycles > 0 ? (float)counters.instructions / (float)counters.cycles : 0.0f;
+			sprintf_safe(hw_line, "%5.2f : %8" PRIu64 " : %7" PRIu64 " : ", ipc, counters.cache_misses, counters.branch_misses);
+			strcat_s(line, hw_line);
+		}
 
 		out << line + indented_name + "\n";
 	}
@@ -33,6 +33,9 @@ struct profile_sample {
 	uint num_parents;
 	uint num_children;
 	int parent;
+
+	scope_counters counters;
+	scope_counters children_counters;
 };
 
 class FrameProfiler {
@@ -45,6 +45,14 @@ void writeCompleteEvent(std::ofstream& out_str, const trace_event* evt) {
 
 	out_str << ",\"dur\":";
 	writeTime(out_str, evt->duration);
+
+	auto& counters = evt->counters;
+	out_str << ",\"args\": {\"allocs\": " << counters.allocations << ", \"alloc_bytes\": " << counters.allocated_bytes;
+	if (counters.has_hw_counters) {
+		out_str << ", \"cycles\": " << counters.cycles << ", \"instructions\": " << counters.instructions
+				<< ", \"llc_misses\": " << counters.cache_misses << ", \"branch_misses\": " << counters.branch_misses;
+	}
+	out_str << "}";
 }
 }
 
@@ -46,6 +46,7 @@ Category ShipPostMove("Ship post move", false);
 Category FireballPostMove("Fireball post move", false);
 Category DebrisPostMove("Debris post move", false);
 Category AsteroidPostMove("Asteroid post move", false);
+Category AsteroidFarField("Asteroid far field", false);
 Category PreMove("Pre Move", false);
 Category Physics("Physics", false);
 Category PostMove("Post Move", false);
@@ -54,7 +55,9 @@ Category CollisionDetection("Collision Detection", false);
 Category RenderBuffer("Render Buffer", true);
 
 Category QueueRender("Queue Render", false);
+Category QueueAsteroidFarField("Queue Asteroid Far Field", false);
 Category BuildModelUniforms("Build Model Uniforms", false);
+Category SortModelDraws("Sort Model Draws", false);
 Category UploadModelUniforms("Upload Model Uniforms", true);
 Category SubmitDraws("Submit Draws", true);
 Category ApplyLights("Apply Lights", true);
@@ -83,6 +86,7 @@ Category BuildShadowMap("Build Shadow Map", true);
 Category RenderScene("Render scene", true);
 Category RenderTrails("Render trails", true);
 Category MoveObjects("Move Objects", false);
+Category AIThink("AI think", false);
 Category ProcessParticleEffects("Process particle effects", false);
 Category TrailsMoveAll("Trails move all", false);
 Category Simulation("Simulation", false);
@@ -58,6 +58,7 @@ extern Category ShipPostMove;
 extern Category FireballPostMove;
 extern Category DebrisPostMove;
 extern Category AsteroidPostMove;
+extern Category AsteroidFarField;
 extern Category PreMove;
 extern Category Physics;
 extern Category PostMove;
@@ -66,7 +67,9 @@ extern Category CollisionDetection;
 extern Category RenderBuffer;
 
 extern Category QueueRender;
+extern Category QueueAsteroidFarField;
 extern Category BuildModelUniforms;
+extern Category SortModelDraws;
 extern Category UploadModelUniforms;
 extern Category SubmitDraws;
 extern Category ApplyLights;
@@ -95,6 +98,7 @@ extern Category BuildShadowMap;
 extern Category RenderScene;
 extern Category RenderTrails;
 extern Category MoveObjects;
+extern Category AIThink;
 extern Category ProcessParticleEffects;
 extern Category TrailsMoveAll;
 extern Category Simulation;
@@ -0,0 +1,146 @@
+#include "tracing/hwcounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+namespace {
+
+using namespace tracing::hwcounters;
+
+const std::uint64_t Counter_configs[NUM_COUNTERS] = {
+	PERF_COUNT_HW_CPU_CYCLES,
+	PERF_COUNT_HW_INSTRUCTIONS,
+	PERF_COUNT_HW_CACHE_MISSES,
+	PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+int perf_event_open(perf_event_attr* attr, pid_t pid, int cpu, int group_fd, unsigned long flags)
+{
+	return (int)syscall(__NR_perf_event_open, attr, pid, cpu, group_fd, flags);
+}
+
+// The counters of one thread. They are opened as one group so a single read gets all of them.
+struct thread_counters {
+	bool opened;
+	bool valid;
+	int fds[NUM_COUNTERS];
+
+	thread_counters() : opened(false), valid(false) {
+		for (auto& fd : fds) {
+			fd = -1;
+		}
+	}
+	~thread_counters() {
+		close_all();
+	}
+
+	void open_all() {
+		opened = true;
+
+		for (int i = 0; i < NUM_COUNTERS; ++i) {
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = Counter_configs[i];
+			attr.read_format = PERF_FORMAT_GROUP;
+			attr.disabled = i == 0 ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+
+			// Only count the calling thread on whatever CPU it runs on
+			fds[i] = perf_event_open(&attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+
+			if (fds[i] < 0) {
+				close_all();
+				return;
+			}
+		}
+
+		ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+		valid = true;
+	}
+
+	void close_all() {
+		for (auto& fd : fds) {
+			if (fd >= 0) {
+				close(fd);
+				fd = -1;
+			}
+		}
+		valid = false;
+	}
+};
+
+thread_local thread_counters Thread_counters;
+
+}
+
+namespace tracing {
+namespace hwcounters {
+
+bool init()
+{
+	std::uint64_t values[NUM_COUNTERS];
+	if (!read(values)) {
+		mprintf(("Hardware performance counters are not available. Check /proc/sys/kernel/perf_event_paranoid.\n"));
+		return false;
+	}
+
+	return true;
+}
+
+bool read(std::uint64_t values[NUM_COUNTERS])
+{
+	auto& counters = Thread_counters;
+
+	if (!counters.opened) {
+		counters.open_all();
+	}
+	if (!counters.valid) {
+		return false;
+	}
+
+	// With PERF_FORMAT_GROUP the kernel writes the number of counters followed by their values
+	std::uint64_t buffer[NUM_COUNTERS + 1];
+	if (::read(counters.fds[0], buffer, sizeof(buffer)) != (ssize_t)sizeof(buffer) || buffer[0] != NUM_COUNTERS) {
+		return false;
+	}
+
+	for (int i = 0; i < NUM_COUNTERS; ++i) {
+		values[i] = buffer[i + 1];
+	}
+
+	return true;
+}
+
+}
+}
+
+#else
+
+namespace tracing {
+namespace hwcounters {
+
+bool init()
+{
+	mprintf(("Hardware performance counters are only supported on Linux.\n"));
+	return false;
+}
+
+bool read(std::uint64_t /*values*/[NUM_COUNTERS])
+{
+	return false;
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/** @file
+ *  @ingroup tracing
+ *
+ *  Access to the hardware performance counters of the CPU. Only implemented on Linux through perf_event_open, every
+ *  other platform reports the counters as unavailable.
+ */
+
+namespace tracing {
+namespace hwcounters {
+
+enum Counter {
+	Cycles = 0,
+	Instructions,
+	CacheMisses,	// Misses of the last level cache
+	BranchMisses,
+
+	NUM_COUNTERS
+};
+
+/**
+ * @brief Checks if the counters can be used by opening them for the calling thread
+ * @return @c true if the counters are available
+ */
+bool init();
+
+/**
+ * @brief Reads the counters of the calling thread
+ *
+ * The counters of a thread are opened the first time it calls this function. The values only have a meaning relative
+ * to an earlier value of the same thread.
+ *
+ * @param values Receives the current value of every counter
+ * @return @c false if the counters could not be read, @p values is left untouched in that case
+ */
+bool read(std::uint64_t values[NUM_COUNTERS]);
+
+}
+}
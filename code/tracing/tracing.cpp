@@ -1,5 +1,6 @@
 
 #include "tracing/tracing.h"
+#include "tracing/hwcounters.h"
 #include "graphics/2d.h"
 #include "parse/parselo.h"
 #include "io/timer.h"
@@ -100,6 +101,8 @@ bool initialized = false;
 bool do_trace_events = false;
 bool do_async_events = false;
 bool do_counter_events = false;
+bool do_scope_statistics = false;
+bool do_hw_counters = false;
 std::int64_t main_thread_id = -1;
 
 int gpu_start_query = -1;
@@ -108,6 +111,9 @@ std::uint64_t cpu_start_time = 0;
 
 std::uint64_t current_id = 0;
 
+// only touched by the main thread so there is no need for any synchronization
+SCP_unordered_map<const Category*, scope_statistics> scope_statistics_map;
+
 void submit_event(trace_event* evt) {
 	if (evt->pid == GPU_PID) {
 		evt->timestamp -= gpu_start_time;
@@ -127,6 +133,13 @@ void submit_event(trace_event* evt) {
 	if (frameProfiler) {
 		frameProfiler->processEvent(evt);
 	}
+
+	if (do_scope_statistics && evt->type == EventType::Complete && evt->tid == main_thread_id) {
+		auto& stats = scope_statistics_map[evt->category];
+		stats.category = evt->category;
+		++stats.count;
+		stats.total_duration += evt->duration;
+	}
 }
 
 void process_gpu_events() {
@@ -199,6 +212,24 @@ void process_gpu_events() {
 	}
 }
 
+void read_scope_counters(scope_counters* counters) {
+	auto& allocations = memory::Thread_allocations;
+	counters->allocations = allocations.count;
+	counters->allocated_bytes = allocations.bytes;
+
+	if (do_hw_counters) {
+		std::uint64_t values[hwcounters::NUM_COUNTERS];
+		counters->has_hw_counters = hwcounters::read(values);
+
+		if (counters->has_hw_counters) {
+			counters->cycles = values[hwcounters::Cycles];
+			counters->instructions = values[hwcounters::Instructions];
+			counters->cache_misses = values[hwcounters::CacheMisses];
+			counters->branch_misses = values[hwcounters::BranchMisses];
+		}
+	}
+}
+
 void init_event(const Category& category, trace_event* evt) {
 	evt->category = &category;
 
@@ -210,10 +241,41 @@ void init_event(const Category& category, trace_event* evt) {
 }
 
 namespace tracing {
+scope_counters& scope_counters::operator+=(const scope_counters& other) {
+	allocations += other.allocations;
+	allocated_bytes += other.allocated_bytes;
+
+	has_hw_counters = has_hw_counters || other.has_hw_counters;
+	cycles += other.cycles;
+	instructions += other.instructions;
+	cache_misses += other.cache_misses;
+	branch_misses += other.branch_misses;
+
+	return *this;
+}
+
+scope_counters& scope_counters::operator-=(const scope_counters& other) {
+	// Clamped at zero since the overhead of reading the counters can make the children look bigger than the parent
+	auto sub = [](std::uint64_t& value, std::uint64_t other_value) {
+		value = value > other_value ? value - other_value : 0;
+	};
+
+	sub(allocations, other.allocations);
+	sub(allocated_bytes, other.allocated_bytes);
+
+	sub(cycles, other.cycles);
+	sub(instructions, other.instructions);
+	sub(cache_misses, other.cache_misses);
+	sub(branch_misses, other.branch_misses);
+
+	return *this;
+}
+
 void init() {
 	do_trace_events = false;
 	do_async_events = false;
 	do_counter_events = false;
+	do_hw_counters = false;
 
 	if (Cmdline_json_profiling) {
 		traceEventWriter.reset(new ThreadedTraceEventWriter());
@@ -229,6 +291,12 @@ void init() {
 		frameProfiler.reset(new FrameProfiler());
 		do_trace_events = true;
 	}
+	if (do_scope_statistics) {
+		do_trace_events = true;
+	}
+	if (Cmdline_profile_counters && do_trace_events) {
+		do_hw_counters = hwcounters::init();
+	}
 
 	do_gpu_queries = gr_is_capable(CAPABILITY_TIMESTAMP_QUERY);
 
@@ -279,6 +347,23 @@ void shutdown() {
 	initialized = false;
 }
 
+void enable_scope_statistics() {
+	do_scope_statistics = true;
+}
+
+SCP_vector<scope_statistics> get_scope_statistics() {
+	Assertion(!initialized || get_tid() == main_thread_id, "This function must be called from the main thread!");
+
+	SCP_vector<scope_statistics> stats;
+	stats.reserve(scope_statistics_map.size());
+
+	for (auto& entry : scope_statistics_map) {
+		stats.push_back(entry.second);
+	}
+
+	return stats;
+}
+
 namespace complete {
 
 void start(const Category& category, trace_event* evt) {
@@ -297,6 +382,9 @@ void start(const Category& category, trace_event* evt) {
 	evt->type = EventType::Complete;
 	evt->event_id = ++current_id;
 
+	// Read last so the time spent on starting the event is not counted
+	read_scope_counters(&evt->counters);
+
 	if (do_gpu_queries && category.usesGPUCounter()) {
 		Assertion(get_tid() == main_thread_id, "This function must be called from the main thread!");
 
@@ -326,6 +414,12 @@ void end(trace_event* evt) {
 	Assertion(evt->pid == get_pid(), "Complete events must be generated from the same process!");
 	Assertion(evt->tid == get_tid(), "Complete events must be generated from the same thread!");
 
+	scope_counters end_counters;
+	read_scope_counters(&end_counters);
+	end_counters -= evt->counters;
+	end_counters.has_hw_counters = end_counters.has_hw_counters && evt->counters.has_hw_counters;
+	evt->counters = end_counters;
+
 	evt->duration = timer_get_nanoseconds() - evt->timestamp;
 	evt->end_event_id = ++current_id;
 
@@ -36,6 +36,25 @@ enum class EventType {
 	Counter
 };
 
+/**
+ * @brief What happened on the thread of a complete event while it was running
+ *
+ * The hardware counters are only filled in if they were enabled with -profile_counters and are available.
+ */
+struct scope_counters {
+	std::uint64_t allocations = 0;		// vm_malloc and vm_realloc calls
+	std::uint64_t allocated_bytes = 0;
+
+	bool has_hw_counters = false;
+	std::uint64_t cycles = 0;
+	std::uint64_t instructions = 0;
+	std::uint64_t cache_misses = 0;	// Last level cache misses
+	std::uint64_t branch_misses = 0;
+
+	scope_counters& operator+=(const scope_counters& other);
+	scope_counters& operator-=(const scope_counters& other);
+};
+
 /**
  * @brief Data of a trace event
  */
@@ -54,6 +73,9 @@ struct trace_event {
 	std::int64_t pid = -1;
 
 	float value = -1.f;
+
+	// Only used by complete events
+	scope_counters counters;
 };
 
 /**
@@ -79,6 +101,33 @@ SCP_string get_frame_profile_output();
  */
 void shutdown();
 
+/**
+ * @brief Accumulated timings of one category of complete events
+ */
+struct scope_statistics {
+	const Category* category = nullptr;
+
+	std::uint64_t count = 0;
+	std::uint64_t total_duration = 0; // in nanoseconds
+};
+
+/**
+ * @brief Enables accumulating the durations of the complete events of the main thread
+ *
+ * This is much cheaper than the other tracing modes since nothing is written anywhere, so it may be left enabled for a
+ * long running process. Must be called before init().
+ */
+void enable_scope_statistics();
+
+/**
+ * @brief Gets the accumulated durations of all categories which have been traced so far
+ *
+ * @warning Must be called from the main thread
+ *
+ * @return The statistics of every category with at least one event
+ */
+SCP_vector<scope_statistics> get_scope_statistics();
+
 namespace complete {
 /**
  * @brief Starts a complete event
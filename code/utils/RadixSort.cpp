@@ -0,0 +1,74 @@
+#include "utils/RadixSort.h"
+
+#include <algorithm>
+
+namespace {
+
+const size_t RADIX_BITS = 8;
+const size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+const size_t RADIX_PASSES = sizeof(std::uint64_t) * 8 / RADIX_BITS;
+
+// Below this size the histograms cost more than a comparison sort
+const size_t RADIX_MIN_ENTRIES = 64;
+
+}
+
+namespace util {
+
+void radix_sort(SCP_vector<RadixSortEntry>& entries, SCP_vector<RadixSortEntry>& scratch)
+{
+	const auto count = entries.size();
+
+	if (count < RADIX_MIN_ENTRIES) {
+		std::sort(entries.begin(), entries.end(), [](const RadixSortEntry& a, const RadixSortEntry& b) {
+			if (a.key != b.key) {
+				return a.key < b.key;
+			}
+			return a.index < b.index;
+		});
+		return;
+	}
+
+	// Build the histograms of all passes at once so the input is only read one additional time
+	size_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+
+	for (auto& entry : entries) {
+		for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+			++histograms[pass][(entry.key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+		}
+	}
+
+	scratch.resize(count);
+
+	auto src = &entries;
+	auto dest = &scratch;
+
+	for (size_t pass = 0; pass < RADIX_PASSES; ++pass) {
+		auto& histogram = histograms[pass];
+		const auto shift = pass * RADIX_BITS;
+
+		// If every key has the same digit then this pass would not change anything
+		if (histogram[((*src)[0].key >> shift) & (RADIX_BUCKETS - 1)] == count) {
+			continue;
+		}
+
+		size_t offsets[RADIX_BUCKETS];
+		size_t sum = 0;
+		for (size_t i = 0; i < RADIX_BUCKETS; ++i) {
+			offsets[i] = sum;
+			sum += histogram[i];
+		}
+
+		for (auto& entry : *src) {
+			(*dest)[offsets[(entry.key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+		}
+
+		std::swap(src, dest);
+	}
+
+	if (src != &entries) {
+		entries.swap(scratch);
+	}
+}
+
+}
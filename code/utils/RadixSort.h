@@ -0,0 +1,28 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <cstdint>
+
+namespace util {
+
+/**
+ * @brief A sort key together with the index of the element it belongs to
+ */
+struct RadixSortEntry {
+	std::uint64_t key = 0;
+	int index = -1;
+};
+
+/**
+ * @brief Sorts entries by their key with a stable least significant digit radix sort
+ *
+ * Entries with equal keys keep their relative order. Passes over bytes that are the same in all keys are skipped so
+ * keys which only use a few bits are cheap to sort.
+ *
+ * @param entries The entries to sort
+ * @param scratch A buffer the sort may use, passing the same buffer every time avoids reallocations
+ */
+void radix_sort(SCP_vector<RadixSortEntry>& entries, SCP_vector<RadixSortEntry>& scratch);
+
+}
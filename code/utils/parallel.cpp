@@ -0,0 +1,175 @@
+#include "utils/parallel.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// More threads than this rarely help with the amount of work a single frame has
+const size_t MAX_WORKER_THREADS = 7;
+
+std::mutex Parallel_mutex;
+std::condition_variable Parallel_job_started;
+std::condition_variable Parallel_worker_done;
+
+SCP_vector<std::thread> Parallel_threads;
+bool Parallel_shutdown = false;
+
+// The current job, only valid while Parallel_func is not null
+const util::ParallelRangeFunc* Parallel_func = nullptr;
+size_t Parallel_count = 0;
+size_t Parallel_chunk_size = 0;
+size_t Parallel_num_chunks = 0;
+uint64_t Parallel_generation = 0;
+std::atomic<size_t> Parallel_next_chunk(0);
+
+// Number of worker threads that are currently processing the job
+size_t Parallel_active_workers = 0;
+
+// Makes sure the threads are stopped before the objects above are destroyed if the program exits without calling
+// parallel_shutdown()
+struct shutdown_guard {
+	~shutdown_guard() { util::parallel_shutdown(); }
+} Parallel_shutdown_guard;
+
+void run_chunks(const util::ParallelRangeFunc& func, size_t count, size_t chunk_size, size_t num_chunks)
+{
+	size_t chunk;
+	while ((chunk = Parallel_next_chunk.fetch_add(1)) < num_chunks) {
+		auto begin = chunk * chunk_size;
+		func(begin, std::min(begin + chunk_size, count));
+	}
+}
+
+void worker_thread()
+{
+	uint64_t last_generation = 0;
+
+	std::unique_lock<std::mutex> lock(Parallel_mutex);
+
+	while (true) {
+		Parallel_job_started.wait(lock, [&last_generation]() {
+			return Parallel_shutdown || (Parallel_func != nullptr && Parallel_generation != last_generation);
+		});
+
+		if (Parallel_shutdown) {
+			return;
+		}
+
+		last_generation = Parallel_generation;
+		++Parallel_active_workers;
+
+		auto func = Parallel_func;
+		auto count = Parallel_count;
+		auto chunk_size = Parallel_chunk_size;
+		auto num_chunks = Parallel_num_chunks;
+
+		lock.unlock();
+
+		run_chunks(*func, count, chunk_size, num_chunks);
+
+		lock.lock();
+
+		--Parallel_active_workers;
+		Parallel_worker_done.notify_all();
+	}
+}
+
+void start_threads()
+{
+	auto hardware_threads = (size_t)std::thread::hardware_concurrency();
+
+	// The calling thread also works on the range
+	auto num_workers = std::min(std::max(hardware_threads, (size_t)1) - 1, MAX_WORKER_THREADS);
+
+	Parallel_shutdown = false;
+	for (size_t i = 0; i < num_workers; ++i) {
+		Parallel_threads.emplace_back(worker_thread);
+	}
+
+	mprintf(("Started %d worker threads for parallel processing\n", (int)num_workers));
+}
+
+}
+
+namespace util {
+
+void parallel_for(size_t count, size_t min_chunk_size, const ParallelRangeFunc& func)
+{
+	if (count == 0) {
+		return;
+	}
+
+	min_chunk_size = std::max(min_chunk_size, (size_t)1);
+
+	if (count <= min_chunk_size) {
+		func(0, count);
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(Parallel_mutex);
+
+	if (Parallel_threads.empty()) {
+		start_threads();
+	}
+
+	if (Parallel_threads.empty()) {
+		// Nothing to hand the work off to
+		lock.unlock();
+		func(0, count);
+		return;
+	}
+
+	// A few chunks per thread give the threads a chance to balance uneven work
+	auto num_threads = Parallel_threads.size() + 1;
+	auto chunk_size = std::max(min_chunk_size, (count + num_threads * 4 - 1) / (num_threads * 4));
+
+	Parallel_func = &func;
+	Parallel_count = count;
+	Parallel_chunk_size = chunk_size;
+	Parallel_num_chunks = (count + chunk_size - 1) / chunk_size;
+	Parallel_next_chunk = 0;
+	++Parallel_generation;
+
+	auto num_chunks = Parallel_num_chunks;
+
+	lock.unlock();
+	Parallel_job_started.notify_all();
+
+	run_chunks(func, count, chunk_size, num_chunks);
+
+	// All chunks have been handed out at this point so only wait for the threads that are still working on one
+	lock.lock();
+	Parallel_worker_done.wait(lock, []() { return Parallel_active_workers == 0; });
+
+	Parallel_func = nullptr;
+}
+
+size_t parallel_num_threads()
+{
+	std::lock_guard<std::mutex> lock(Parallel_mutex);
+
+	if (Parallel_threads.empty()) {
+		start_threads();
+	}
+
+	return Parallel_threads.size() + 1;
+}
+
+void parallel_shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(Parallel_mutex);
+		Parallel_shutdown = true;
+	}
+	Parallel_job_started.notify_all();
+
+	for (auto& thread : Parallel_threads) {
+		thread.join();
+	}
+	Parallel_threads.clear();
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <functional>
+
+namespace util {
+
+/**
+ * @brief A function processing the elements [begin, end) of a range
+ */
+typedef std::function<void(size_t begin, size_t end)> ParallelRangeFunc;
+
+/**
+ * @brief Processes a range of elements on all available cores
+ *
+ * The range is split into chunks of at least @c min_chunk_size elements which are handed out to a set of persistent
+ * worker threads. The calling thread works on chunks as well and this only returns once all chunks have been processed.
+ * Small ranges are processed on the calling thread directly.
+ *
+ * The function must not touch state that is shared between elements unless it is protected. This must only be called
+ * from the main thread and is not reentrant.
+ *
+ * @param count The number of elements in the range
+ * @param min_chunk_size The minimum number of elements a single call of @c func should process
+ * @param func The function processing a chunk of the range
+ */
+void parallel_for(size_t count, size_t min_chunk_size, const ParallelRangeFunc& func);
+
+/**
+ * @brief The number of threads that work on a range, including the calling thread
+ */
+size_t parallel_num_threads();
+
+/**
+ * @brief Stops the worker threads
+ *
+ * They are started again by the next parallel_for call that needs them.
+ */
+void parallel_shutdown();
+
+}
@@ -587,7 +587,7 @@ int	weapon_area_calc_damage(object *objp, vec3d *pos, float inner_rad, float out
 										float *blast, float *damage, float limit);
 
 missile_obj *missile_obj_return_address(int index);
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list);
+void find_homing_object_cmeasures(const SCP_frame_vector<object*> &cmeasure_list);
 
 // THE FOLLOWING FUNCTION IS IN SHIP.CPP!!!!
 // JAS - figure out which thruster bitmap will get rendered next
@@ -175,6 +175,9 @@ int Num_weapon_types = 0;
 
 int Num_weapons = 0;
 int Weapons_inited = 0;
+
+// Countermeasure ignore lists of deleted weapons, kept around so new weapons don't have to allocate them again
+static SCP_vector<SCP_vector<int>*> Cmeasure_ignore_list_pool;
 int Weapon_expl_initted = 0;
 
 int laser_model_inner = -1;
@@ -3556,6 +3559,11 @@ void weapon_close()
 		vm_free(Spawn_names);
 		Spawn_names = NULL;
 	}
+
+	for (auto list : Cmeasure_ignore_list_pool) {
+		delete list;
+	}
+	Cmeasure_ignore_list_pool.clear();
 }
 
 /**
@@ -3647,7 +3655,8 @@ void weapon_delete(object *obj)
 		model_delete_instance(wp->model_instance_num);
 
 	if (wp->cmeasure_ignore_list != nullptr) {
-		delete wp->cmeasure_ignore_list;
+		wp->cmeasure_ignore_list->clear();
+		Cmeasure_ignore_list_pool.push_back(wp->cmeasure_ignore_list);
 		wp->cmeasure_ignore_list = nullptr;
 	}
 
@@ -3862,7 +3871,7 @@ void find_homing_object(object *weapon_objp, int num)
 /**
  * For all homing weapons, see if they should be decoyed by a countermeasure.
  */
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
+void find_homing_object_cmeasures(const SCP_frame_vector<object*> &cmeasure_list)
 {
 	for (object *weapon_objp = GET_FIRST(&obj_used_list); weapon_objp != END_OF_LIST(&obj_used_list); weapon_objp = GET_NEXT(weapon_objp) ) {
 		if (weapon_objp->type == OBJ_WEAPON) {
@@ -3891,7 +3900,12 @@ void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
 						float chance;
 
 						if (wp->cmeasure_ignore_list == nullptr) {
-							wp->cmeasure_ignore_list = new SCP_vector<int>;
+							if (!Cmeasure_ignore_list_pool.empty()) {
+								wp->cmeasure_ignore_list = Cmeasure_ignore_list_pool.back();
+								Cmeasure_ignore_list_pool.pop_back();
+							} else {
+								wp->cmeasure_ignore_list = new SCP_vector<int>;
+							}
 						}
 						else {
 							bool found = false;
@@ -316,7 +316,7 @@ BOOL asteroid_editor::OnInitDialog()
 	update_init();
 	theApp.init_window(&Asteroid_wnd_data, this);
 
-	m_density_spin.SetRange(1, MAX_ASTEROIDS);
+	m_density_spin.SetRange(1, MAX_FIELD_ASTEROIDS);
 	return TRUE;
 }
 
@@ -332,8 +332,8 @@ void asteroid_editor::update_init()
 		if (a_field[last_field].num_initial_asteroids < 0)
 			a_field[last_field].num_initial_asteroids = 0;
 
-		if (a_field[last_field].num_initial_asteroids > MAX_ASTEROIDS)
-			a_field[last_field].num_initial_asteroids = MAX_ASTEROIDS;
+		if (a_field[last_field].num_initial_asteroids > MAX_FIELD_ASTEROIDS)
+			a_field[last_field].num_initial_asteroids = MAX_FIELD_ASTEROIDS;
 
 		if (num_asteroids != a_field[last_field].num_initial_asteroids)
 			set_modified();
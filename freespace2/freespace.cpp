@@ -126,6 +126,7 @@
 #include "network/multi_rate.h"
 #include "network/multi_respawn.h"
 #include "network/multi_voice.h"
+#include "network/multi_xfer.h"
 #include "network/multimsgs.h"
 #include "network/multiteamselect.h"
 #include "network/multiui.h"
@@ -174,6 +175,7 @@
 #include "stats/stats.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/parallel.h"
 #include "weapon/beam.h"
 #include "weapon/emp.h"
 #include "weapon/flak.h"
@@ -2056,6 +2058,9 @@ MONITOR(NumVerts)
 MONITOR(BmpUsed)
 MONITOR(BmpNew)
 
+// Number of vm_malloc calls during the last frame, should stay close to zero while nothing new gets loaded
+MONITOR(NumFrameAllocations)
+
 void game_get_framerate()
 {	
 	if (frame_int == -1) {
@@ -2222,6 +2227,9 @@ void game_show_framerate()
 		gr_printf_no_resize( sx, sy, NOX("Snds: %d"), snd_num_playing() );
 		sy += line_height;
 
+		gr_printf_no_resize( sx, sy, NOX("ASTS: %d + %d far"), asteroid_count(), asteroid_far_field_count() );
+		sy += line_height;
+
 		if ( Timing_total > 0.01f )	{
 			gr_printf_no_resize(  sx, sy, NOX("CLEAR: %.0f%%"), Timing_clear*100.0f/Timing_total );
 			sy += line_height;
@@ -4071,6 +4079,10 @@ void game_frame(bool paused)
 			;
 	}
 #endif
+	// temporaries of this frame are released on the way out, whichever way that is
+	memory::frame_arena_scope frame_arena;
+	MONITOR_SET(NumFrameAllocations, (int)memory::frame_allocations());
+
 	// start timing frame
 	TRACE_SCOPE(tracing::MainFrame);
 
@@ -4434,6 +4446,14 @@ void game_set_frametime(int state)
 		fix cap;
 
 		cap = F1_0/Framerate_cap;
+		if (Frametime < cap) {
+			// Collect Lua garbage in half of the time that is left instead of doing it while the next frame runs
+			Script_system.RunGarbageCollector(static_cast<int>(f2fl(cap - Frametime) * 500000.0f));
+
+			auto gc_end = timer_get_fixed_seconds();
+			Frametime += gc_end - thistime;
+			thistime = gc_end;
+		}
 		if (Frametime < cap) {
 			thistime = cap - Frametime;
 //  			mprintf(("Sleeping for %6.3f seconds.\n", f2fl(thistime)));
@@ -6877,6 +6897,7 @@ void game_shutdown(void)
 
 	particle::ParticleManager::shutdown();
 	batching_shutdown();
+	util::parallel_shutdown();
 
 	// load up common multiplayer icons
 	multi_unload_common_icons();
@@ -6895,6 +6916,7 @@ void game_shutdown(void)
 	message_mission_close();	// clear loaded table data from message.tbl
 	mission_parse_close();		// clear out any extra memory that may be in use by mission parsing
 	multi_voice_close();			// close down multiplayer voice (including freeing buffers, etc)
+	multi_xfer_close();			// delete partially received files
 	multi_log_close();
 	logfile_close(LOGFILE_EVENT_LOG); // close down the mission log
 #ifdef MULTI_USE_LAG
@@ -345,7 +345,7 @@ void AsteroidEditorDialogModel::update_init()
 		// store into temp asteroid field
 		num_asteroids = _a_field.num_initial_asteroids;
 		_a_field.num_initial_asteroids = _enable_asteroids ? _num_asteroids : 0;
-		CLAMP(_a_field.num_initial_asteroids, 0, MAX_ASTEROIDS);
+		CLAMP(_a_field.num_initial_asteroids, 0, MAX_FIELD_ASTEROIDS);
 
 		if (num_asteroids != _a_field.num_initial_asteroids) {
 			set_modified();
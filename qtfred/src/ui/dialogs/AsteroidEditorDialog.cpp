@@ -40,7 +40,7 @@ AsteroidEditorDialog::AsteroidEditorDialog(FredView *parent, EditorViewport* vie
 				AsteroidEditorDialog::toggleAsteroid(AsteroidEditorDialogModel::_AST_ORANGE, enabled); });
 
 	// (come in) spinners
-	ui->spinBoxNumber->setRange(1, MAX_ASTEROIDS);
+	ui->spinBoxNumber->setRange(1, MAX_FIELD_ASTEROIDS);
 	ui->spinBoxNumber->setValue(_model->getNumAsteroids());
 	// only connect once we're done setting values or unwanted signal's will be sent
 	connect(ui->spinBoxNumber, QOverload<int>::of(&QSpinBox::valueChanged), this, \
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <asteroid/asteroid.h>
+#include <math/vecmat.h>
+#include <object/object.h>
+#include <render/3d.h>
+
+class AsteroidFarFieldTest : public ::testing::Test {
+ protected:
+	void SetUp() override {
+		asteroid_far_field_clear();
+
+		Asteroid_field = asteroid_field();
+		Asteroid_field.field_type = FT_ACTIVE;
+		Asteroid_field.has_inner_bound = false;
+		vm_vec_make(&Asteroid_field.min_bound, -1000.0f, -1000.0f, -1000.0f);
+		vm_vec_make(&Asteroid_field.max_bound, 1000.0f, 1000.0f, 1000.0f);
+		Asteroid_field.bound_rad = 1800.0f;
+
+		// Far away and looking away from the field so nothing keeps an asteroid from wrapping
+		vm_vec_make(&Eye_position, 0.0f, 0.0f, -100000.0f);
+		vm_vec_make(&Eye_matrix.vec.rvec, 1.0f, 0.0f, 0.0f);
+		vm_vec_make(&Eye_matrix.vec.uvec, 0.0f, 1.0f, 0.0f);
+		vm_vec_make(&Eye_matrix.vec.fvec, 0.0f, 0.0f, -1.0f);
+	}
+	void TearDown() override {
+		asteroid_far_field_clear();
+	}
+
+	static void make_object(object* objp, const vec3d& pos, const vec3d& vel, const angles& orient, const vec3d& rotvel) {
+		objp->pos = pos;
+		objp->phys_info.vel = vel;
+		vm_angles_2_matrix(&objp->orient, &orient);
+		objp->phys_info.rotvel = rotvel;
+		objp->radius = 50.0f;
+	}
+};
+
+TEST_F(AsteroidFarFieldTest, demote_and_promote_keep_state) {
+	vec3d pos, vel, rotvel;
+	vm_vec_make(&pos, 123.5f, -456.25f, 789.0f);
+	vm_vec_make(&vel, -12.0f, 3.5f, 40.25f);
+	vm_vec_make(&rotvel, 0.1f, -0.2f, 0.3f);
+
+	angles orient;
+	orient.p = 0.3f;
+	orient.b = 1.2f;
+	orient.h = 2.1f;
+
+	object demoted;
+	make_object(&demoted, pos, vel, orient, rotvel);
+
+	asteroid_far_field_add_object(&demoted, 0, 0);
+	ASSERT_EQ(1, asteroid_far_field_count());
+
+	object promoted;
+	asteroid_far_field_copy_to_object(0, &promoted);
+
+	ASSERT_EQ(demoted.pos.xyz.x, promoted.pos.xyz.x);
+	ASSERT_EQ(demoted.pos.xyz.y, promoted.pos.xyz.y);
+	ASSERT_EQ(demoted.pos.xyz.z, promoted.pos.xyz.z);
+
+	ASSERT_EQ(demoted.phys_info.vel.xyz.x, promoted.phys_info.vel.xyz.x);
+	ASSERT_EQ(demoted.phys_info.vel.xyz.y, promoted.phys_info.vel.xyz.y);
+	ASSERT_EQ(demoted.phys_info.vel.xyz.z, promoted.phys_info.vel.xyz.z);
+
+	ASSERT_EQ(demoted.phys_info.rotvel.xyz.x, promoted.phys_info.rotvel.xyz.x);
+	ASSERT_EQ(demoted.phys_info.rotvel.xyz.y, promoted.phys_info.rotvel.xyz.y);
+	ASSERT_EQ(demoted.phys_info.rotvel.xyz.z, promoted.phys_info.rotvel.xyz.z);
+
+	// The far field stores the orientation as angles so it only has to match up to rounding
+	for (int i = 0; i < 9; ++i) {
+		ASSERT_NEAR(demoted.orient.a1d[i], promoted.orient.a1d[i], 1e-5f);
+	}
+}
+
+TEST_F(AsteroidFarFieldTest, move_wraps_like_full_asteroids) {
+	vec3d pos, vel, rotvel;
+	vm_vec_make(&pos, 990.0f, -995.0f, 100.0f);
+	vm_vec_make(&vel, 20.0f, -15.0f, 5.0f);
+	rotvel = vmd_zero_vector;
+
+	angles orient;
+	orient.p = orient.b = orient.h = 0.0f;
+
+	object demoted;
+	make_object(&demoted, pos, vel, orient, rotvel);
+	asteroid_far_field_add_object(&demoted, 0, 0);
+
+	asteroid_far_field_move(1.0f);
+
+	// Moved to (1010, -1010, 105), asteroid_wrap_pos() moves it by the overshoot from the opposite bound
+	object promoted;
+	asteroid_far_field_copy_to_object(0, &promoted);
+
+	ASSERT_FLOAT_EQ(-990.0f, promoted.pos.xyz.x);
+	ASSERT_FLOAT_EQ(990.0f, promoted.pos.xyz.y);
+	ASSERT_FLOAT_EQ(105.0f, promoted.pos.xyz.z);
+
+	// The velocity is only reversed if the player would see the asteroid wrap
+	ASSERT_EQ(vel.xyz.x, promoted.phys_info.vel.xyz.x);
+	ASSERT_EQ(vel.xyz.y, promoted.phys_info.vel.xyz.y);
+	ASSERT_EQ(vel.xyz.z, promoted.phys_info.vel.xyz.z);
+}
+
+TEST_F(AsteroidFarFieldTest, move_keeps_asteroids_inside_the_field) {
+	vec3d pos, vel, rotvel;
+	vm_vec_make(&pos, 100.0f, 200.0f, 300.0f);
+	vm_vec_make(&vel, 10.0f, 20.0f, 30.0f);
+	rotvel = vmd_zero_vector;
+
+	angles orient;
+	orient.p = orient.b = orient.h = 0.0f;
+
+	object demoted;
+	make_object(&demoted, pos, vel, orient, rotvel);
+	asteroid_far_field_add_object(&demoted, 0, 0);
+
+	asteroid_far_field_move(0.5f);
+
+	object promoted;
+	asteroid_far_field_copy_to_object(0, &promoted);
+
+	ASSERT_FLOAT_EQ(105.0f, promoted.pos.xyz.x);
+	ASSERT_FLOAT_EQ(210.0f, promoted.pos.xyz.y);
+	ASSERT_FLOAT_EQ(315.0f, promoted.pos.xyz.z);
+}
@@ -90,6 +90,51 @@ TEST_F(CFileTest, list_files_in_vps_and_dirs) {
 	ASSERT_STREQ("dir2", table_files[1].c_str());
 }
 
+TEST_F(CFileTest, read_packed_files) {
+	auto fp = cfopen("test.tbl", "rb", CFILE_NORMAL, CF_TYPE_TABLES);
+	ASSERT_TRUE(fp != nullptr);
+
+	char buffer[5];
+	ASSERT_EQ(5, cfilelength(fp));
+	ASSERT_EQ(1, cfread(buffer, sizeof(buffer), 1, fp));
+	ASSERT_EQ(0, memcmp("asdf\n", buffer, sizeof(buffer)));
+	ASSERT_TRUE(cfeof(fp));
+
+	cfclose(fp);
+
+	// Packs are mapped into memory so their files can also be accessed directly
+	fp = cfopen("test2.tbl", "rb", CFILE_MEMORY_MAPPED, CF_TYPE_TABLES);
+	ASSERT_TRUE(fp != nullptr);
+
+	ASSERT_EQ(5, cfilelength(fp));
+	ASSERT_EQ(0, memcmp("asdf\n", cf_returndata(fp), 5));
+
+	cfclose(fp);
+}
+
+TEST_F(CFileTest, read_compressed_packed_files) {
+	SCP_string expected;
+	for (int i = 0; i < 100; ++i) {
+		expected += "0123456789\n";
+	}
+
+	auto fp = cfopen("compressed.tbl", "rb", CFILE_NORMAL, CF_TYPE_TABLES);
+	ASSERT_TRUE(fp != nullptr);
+
+	ASSERT_EQ((int)expected.size(), cfilelength(fp));
+
+	SCP_string content(expected.size(), '\0');
+	ASSERT_EQ(1, cfread(&content[0], (int)content.size(), 1, fp));
+	ASSERT_EQ(expected, content);
+
+	char buffer[10];
+	ASSERT_EQ(0, cfseek(fp, 12, CF_SEEK_SET));
+	ASSERT_EQ(1, cfread(buffer, sizeof(buffer), 1, fp));
+	ASSERT_EQ(0, memcmp("123456789\n", buffer, sizeof(buffer)));
+
+	cfclose(fp);
+}
+
 TEST_F(CFileTest, access_default_file) {
 	// We use the controlconfig file since that should stay relatively stable
 	ASSERT_TRUE(cf_exists("controlconfigdefaults.tbl", CF_TYPE_TABLES));
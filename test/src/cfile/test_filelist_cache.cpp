@@ -0,0 +1,234 @@
+#include <cfile/cfilesystem.h>
+#include <cmdline/cmdline.h>
+#include <gtest/gtest.h>
+
+#include "util/FSTestFixture.h"
+
+#include <sys/stat.h>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#include <chrono>
+#include <thread>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace {
+SCP_string join(const SCP_string& dir, const char* name) {
+	return dir + DIR_SEPARATOR_CHAR + name;
+}
+
+void write_file(const SCP_string& path, const void* data, size_t size) {
+	FILE* fp = fopen(path.c_str(), "wb");
+	ASSERT_TRUE(fp != nullptr);
+	ASSERT_EQ((size_t)1, fwrite(data, size, 1, fp));
+	fclose(fp);
+}
+
+// Writes a pack with data/tables/packed.tbl. Both layouts have the same size but a different header.
+void write_pack(const SCP_string& path, bool index_first) {
+	struct entry {
+		int offset;
+		int size;
+		char filename[32];
+		int write_time;
+	};
+	static_assert(sizeof(entry) == 44, "VP index entries are 44 bytes long");
+
+	const char data[] = "asdf\n";
+	const int data_size = sizeof(data) - 1;
+	const int num_entries = 5;
+
+	int header[4];
+	memcpy(header, "VPVP", 4);
+	header[1] = 2;
+	header[2] = index_first ? 16 : 16 + data_size;
+	header[3] = num_entries;
+
+	int data_offset = index_first ? 16 + num_entries * (int)sizeof(entry) : 16;
+
+	entry entries[num_entries] = {
+		{0, 0, "data", 0},
+		{0, 0, "tables", 0},
+		{data_offset, data_size, "packed.tbl", 0},
+		{0, 0, "..", 0},
+		{0, 0, "..", 0},
+	};
+
+	SCP_string content(reinterpret_cast<const char*>(header), sizeof(header));
+	if (index_first) {
+		content.append(reinterpret_cast<const char*>(entries), sizeof(entries));
+		content.append(data, data_size);
+	} else {
+		content.append(data, data_size);
+		content.append(reinterpret_cast<const char*>(entries), sizeof(entries));
+	}
+
+	write_file(path, content.data(), content.size());
+}
+
+time_t get_modification_time(const SCP_string& path) {
+	struct stat buf;
+	if (stat(path.c_str(), &buf) != 0) {
+		return -1;
+	}
+	return buf.st_mtime;
+}
+
+void set_modification_time(const SCP_string& path, time_t time) {
+	struct utimbuf times;
+	times.actime = time;
+	times.modtime = time;
+	utime(path.c_str(), &times);
+}
+}
+
+class FileListCacheTest : public test::FSTestFixture {
+ public:
+	FileListCacheTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	SCP_string _root;
+	char _working_dir[CF_MAX_PATHNAME_LENGTH];
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		// cfile changes into the directory of the test root, which is deleted at the end
+		ASSERT_TRUE(_getcwd(_working_dir, sizeof(_working_dir)) != 0);
+
+		// The fixture disables the cache for every other test
+		Cmdline_no_filelist_cache = false;
+
+		_root = ::testing::TempDir() + "filelist_cache_test";
+		remove_tree();
+
+		_mkdir(_root.c_str());
+		_mkdir(data_dir().c_str());
+		_mkdir(tables_dir().c_str());
+		_mkdir(join(data_dir(), "cache").c_str());
+
+		write_file(join(tables_dir(), "loose.tbl"), "asdf\n", 5);
+		write_pack(pack_path(), false);
+
+		make_old();
+	}
+	void TearDown() override {
+		cfile_close();
+
+		_chdir(_working_dir);
+		remove_tree();
+
+		Cmdline_no_filelist_cache = true;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	SCP_string data_dir() const { return join(_root, "data"); }
+	SCP_string tables_dir() const { return join(data_dir(), "tables"); }
+	SCP_string pack_path() const { return join(_root, "pack.vp"); }
+
+	// Anything changed within the last second is never taken from the cache, so everything is made older than that
+	void make_old() {
+#ifdef _WIN32
+		// Directory times can't be set here
+		std::this_thread::sleep_for(std::chrono::seconds(2));
+#else
+		auto old_time = time(nullptr) - 100;
+
+		set_modification_time(join(tables_dir(), "loose.tbl"), old_time);
+		set_modification_time(pack_path(), old_time);
+		set_modification_time(tables_dir(), old_time);
+		set_modification_time(join(data_dir(), "cache"), old_time);
+		set_modification_time(data_dir(), old_time);
+		set_modification_time(_root, old_time);
+#endif
+	}
+
+	void build_file_list() {
+		cfile_close();
+
+		// Cfile expects something after the path
+		ASSERT_FALSE(cfile_init(join(_root, "test").c_str()));
+	}
+
+	void remove_tree() {
+		remove(join(join(data_dir(), "cache"), "filelist.cache").c_str());
+		remove(join(join(data_dir(), "cache"), "filelist.cache.tmp").c_str());
+		remove(join(tables_dir(), "loose.tbl").c_str());
+		remove(join(tables_dir(), "new.tbl").c_str());
+		remove(pack_path().c_str());
+
+		rmdir(join(data_dir(), "cache").c_str());
+		rmdir(tables_dir().c_str());
+		rmdir(data_dir().c_str());
+		rmdir(_root.c_str());
+	}
+};
+
+TEST_F(FileListCacheTest, cold_and_warm_cache) {
+	build_file_list();
+
+	ASSERT_TRUE(cf_exists_full("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_exists_full("packed.tbl", CF_TYPE_TABLES));
+	ASSERT_FALSE(cf_file_list_cache_used("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_FALSE(cf_file_list_cache_used("packed.tbl", CF_TYPE_TABLES));
+
+	ASSERT_GT(get_modification_time(join(join(data_dir(), "cache"), "filelist.cache")), 0);
+
+	build_file_list();
+
+	ASSERT_TRUE(cf_exists_full("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_exists_full("packed.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_file_list_cache_used("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_file_list_cache_used("packed.tbl", CF_TYPE_TABLES));
+
+	// Files from the cache are still read from the right place
+	auto fp = cfopen("packed.tbl", "rb", CFILE_NORMAL, CF_TYPE_TABLES);
+	ASSERT_TRUE(fp != nullptr);
+	ASSERT_EQ(5, cfilelength(fp));
+	cfclose(fp);
+}
+
+TEST_F(FileListCacheTest, changed_directory_rebuilds_its_root) {
+	build_file_list();
+	cfile_close();
+
+	write_file(join(tables_dir(), "new.tbl"), "asdf\n", 5);
+
+	build_file_list();
+
+	ASSERT_TRUE(cf_exists_full("new.tbl", CF_TYPE_TABLES));
+	ASSERT_FALSE(cf_file_list_cache_used("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_file_list_cache_used("packed.tbl", CF_TYPE_TABLES));
+}
+
+TEST_F(FileListCacheTest, changed_pack_header_rebuilds_its_root) {
+	build_file_list();
+	// Packs are mapped into memory, so they can only be written once cfile is done with them
+	cfile_close();
+
+	// Same size and modification time, only the header differs
+	auto pack_time = get_modification_time(pack_path());
+	write_pack(pack_path(), true);
+	set_modification_time(pack_path(), pack_time);
+
+	build_file_list();
+
+	ASSERT_TRUE(cf_exists_full("packed.tbl", CF_TYPE_TABLES));
+	ASSERT_TRUE(cf_file_list_cache_used("loose.tbl", CF_TYPE_TABLES));
+	ASSERT_FALSE(cf_file_list_cache_used("packed.tbl", CF_TYPE_TABLES));
+
+	auto fp = cfopen("packed.tbl", "rb", CFILE_NORMAL, CF_TYPE_TABLES);
+	ASSERT_TRUE(fp != nullptr);
+
+	char buffer[5];
+	ASSERT_EQ(1, cfread(buffer, sizeof(buffer), 1, fp));
+	ASSERT_EQ(0, memcmp("asdf\n", buffer, sizeof(buffer)));
+	cfclose(fp);
+}
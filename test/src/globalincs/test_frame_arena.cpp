@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <globalincs/pstypes.h>
+
+namespace {
+// Starts every test with a freshly rewound arena
+void start_frame() {
+	ASSERT_EQ((size_t)0, memory::frame_arena_get_stats().live);
+
+	memory::frame_arena_reset();
+
+	// The arena rewinds lazily, so the first allocation of a frame is what actually rewinds it
+	memory::frame_free(memory::frame_alloc(1, 1), 1);
+	ASSERT_EQ((size_t)0, memory::frame_arena_get_stats().used);
+}
+}
+
+TEST(FrameArenaTest, ReusesMemoryAfterReset) {
+	start_frame();
+
+	auto first = memory::frame_alloc(64, 16);
+	auto second = memory::frame_alloc(64, 16);
+	ASSERT_NE(first, second);
+
+	memory::frame_free(first, 64);
+	memory::frame_free(second, 64);
+
+	memory::frame_arena_reset();
+
+	ASSERT_EQ(first, memory::frame_alloc(64, 16));
+	memory::frame_free(first, 64);
+}
+
+TEST(FrameArenaTest, GivesBackLastAllocation) {
+	start_frame();
+
+	auto first = memory::frame_alloc(32, 16);
+	auto second = memory::frame_alloc(32, 16);
+	auto used = memory::frame_arena_get_stats().used;
+
+	memory::frame_free(second, 32);
+	ASSERT_EQ(used - 32, memory::frame_arena_get_stats().used);
+
+	// The space of the last allocation gets handed out again right away
+	ASSERT_EQ(second, memory::frame_alloc(32, 16));
+
+	memory::frame_free(second, 32);
+	memory::frame_free(first, 32);
+}
+
+TEST(FrameArenaTest, OverflowGrowsBlock) {
+	start_frame();
+
+	auto block_size = memory::frame_arena_get_stats().block_size;
+	ASSERT_GT(block_size, (size_t)0);
+
+	auto in_block = memory::frame_alloc(16, 16);
+	auto overflow = memory::frame_alloc(block_size, 16);
+	ASSERT_NE(nullptr, overflow);
+	ASSERT_EQ(block_size, memory::frame_arena_get_stats().overflow_bytes);
+
+	// Overflow memory must not be mistaken for the end of the block
+	auto used = memory::frame_arena_get_stats().used;
+	memory::frame_free(overflow, block_size);
+	ASSERT_EQ(used, memory::frame_arena_get_stats().used);
+
+	memory::frame_free(in_block, 16);
+
+	memory::frame_arena_reset();
+
+	// The block now has room for everything the last frame needed
+	auto stats = memory::frame_arena_get_stats();
+	ASSERT_GE(stats.block_size, block_size + 16);
+	ASSERT_EQ((size_t)0, stats.overflow_bytes);
+
+	auto fits = memory::frame_alloc(block_size, 16);
+	ASSERT_EQ((size_t)0, memory::frame_arena_get_stats().overflow_bytes);
+	memory::frame_free(fits, block_size);
+}
+
+TEST(FrameArenaTest, DoesNotRewindWhileAllocationsAreLive) {
+	start_frame();
+
+	auto held = memory::frame_alloc(32, 16);
+
+	memory::frame_arena_reset();
+
+	// The held memory must not be handed out a second time
+	auto other = memory::frame_alloc(32, 16);
+	ASSERT_NE(held, other);
+	ASSERT_EQ((size_t)2, memory::frame_arena_get_stats().live);
+
+	memory::frame_free(held, 32);
+	memory::frame_free(other, 32);
+
+	// Once everything is freed the arena catches up with the missed rewind
+	ASSERT_EQ(held, memory::frame_alloc(32, 16));
+	ASSERT_EQ((size_t)1, memory::frame_arena_get_stats().live);
+	memory::frame_free(held, 32);
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <graphics/2d.h>
+#include <graphics/grstub.h>
+#include <graphics/material.h>
+#include <model/modelrender.h>
+
+#include "util/FSTestFixture.h"
+
+#include <chrono>
+#include <iostream>
+
+class GrStubTest : public test::FSTestFixture {
+ public:
+	GrStubTest() : test::FSTestFixture(INIT_CFILE | INIT_GRAPHICS) {
+		pushModDir("graphics");
+	}
+
+ protected:
+	void SetUp() override {
+		// Recording has to be enabled before the renderer creates its buffers
+		gr_stub_set_recording(true, true);
+		gr_stub_reset_recording();
+
+		test::FSTestFixture::SetUp();
+	}
+	void TearDown() override {
+		test::FSTestFixture::TearDown();
+
+		gr_stub_set_recording(false);
+		gr_stub_reset_recording();
+	}
+
+	void draw_test_frame(int buffer) {
+		float data[12] = {};
+		gr_update_buffer_data(buffer, sizeof(data), data);
+
+		vertex_layout layout;
+		layout.add_vertex_component(vertex_format_data::POSITION3, sizeof(float) * 3, 0);
+
+		material mat;
+		mat.set_texture_map(TM_BASE_TYPE, 5);
+
+		// The second draw uses the same state and texture so it must not count as a change
+		gr_render_primitives(&mat, PRIM_TYPE_TRIS, &layout, 0, 3, buffer);
+		gr_render_primitives(&mat, PRIM_TYPE_TRIS, &layout, 0, 3, buffer);
+
+		mat.set_cull_mode(!mat.get_cull_mode());
+		mat.set_texture_map(TM_BASE_TYPE, 6);
+		gr_render_primitives(&mat, PRIM_TYPE_TRIS, &layout, 0, 3, buffer);
+
+		gr_flip(false);
+	}
+};
+
+TEST_F(GrStubTest, counts_render_work) {
+	auto buffer = gr_create_buffer(BufferType::Vertex, BufferUsageHint::Static);
+	ASSERT_GE(buffer, 0);
+
+	ASSERT_EQ((uint64_t)1, gr_stub_get_stats().buffers_created);
+
+	gr_stub_reset_recording();
+
+	draw_test_frame(buffer);
+
+	auto& stats = gr_stub_get_stats();
+	ASSERT_EQ((uint64_t)3, stats.draw_calls);
+	ASSERT_EQ((uint64_t)9, stats.vertices);
+	ASSERT_EQ((uint64_t)2, stats.state_changes);
+	ASSERT_EQ((uint64_t)2, stats.texture_binds);
+	ASSERT_EQ((uint64_t)1, stats.buffer_uploads);
+	ASSERT_EQ((uint64_t)(sizeof(float) * 12), stats.buffer_upload_bytes);
+	ASSERT_EQ((uint64_t)1, stats.frames);
+}
+
+TEST_F(GrStubTest, command_stream_is_reproducible) {
+	auto buffer = gr_create_buffer(BufferType::Vertex, BufferUsageHint::Static);
+
+	gr_stub_reset_recording();
+	draw_test_frame(buffer);
+	auto first = gr_stub_get_commands();
+
+	gr_stub_reset_recording();
+	draw_test_frame(buffer);
+	auto second = gr_stub_get_commands();
+
+	ASSERT_FALSE(first.empty());
+	ASSERT_EQ(first, second);
+}
+
+// Measures the CPU cost of queueing, sorting and submitting model draws, run with --gtest_also_run_disabled_tests
+TEST_F(GrStubTest, DISABLED_model_draw_list_benchmark) {
+	const int num_draws = 4000;
+	const int num_buffers = 16;
+	const int num_textures = 64;
+	const int frames = 200;
+
+	SCP_vector<indexed_vertex_source> sources(num_buffers);
+	for (auto& source : sources) {
+		source.Vbuffer_handle = gr_create_buffer(BufferType::Vertex, BufferUsageHint::Static);
+		source.Ibuffer_handle = gr_create_buffer(BufferType::Index, BufferUsageHint::Static);
+	}
+
+	vertex_buffer buffer;
+	buffer.tex_buf.push_back(buffer_data(300));
+
+	gr_stub_reset_recording();
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (int frame = 0; frame < frames; ++frame) {
+		model_draw_list scene;
+		scene.init();
+
+		for (int i = 0; i < num_draws; ++i) {
+			vec3d pos = vmd_zero_vector;
+			pos.xyz.z = (float)i;
+
+			model_material mat;
+			mat.set_texture_map(TM_BASE_TYPE, (i * 7) % num_textures);
+			mat.set_texture_map(TM_NORMAL_TYPE, (i * 13) % num_textures);
+
+			scene.push_transform(&pos, nullptr);
+			scene.add_buffer_draw(&mat, &sources[i % num_buffers], &buffer, 0, 0);
+			scene.pop_transform();
+		}
+
+		scene.init_render();
+		scene.render_all();
+
+		gr_flip(false);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	auto us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+
+	auto& stats = gr_stub_get_stats();
+	std::cout << "CPU time per frame: " << (double)us / frames << " us" << std::endl;
+	std::cout << "Per frame: " << stats.draw_calls / frames << " draws, " << stats.state_changes / frames
+			  << " state changes, " << stats.texture_binds / frames << " texture binds, "
+			  << stats.buffer_upload_bytes / frames << " bytes uploaded, " << stats.uniform_buffer_binds / frames
+			  << " uniform binds" << std::endl;
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <math/vecmat.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+
+namespace {
+SCP_vector<vec3d> random_vectors(size_t count) {
+	std::mt19937 gen(1234);
+	std::uniform_real_distribution<float> dist(-1000.0f, 1000.0f);
+
+	SCP_vector<vec3d> vectors(count);
+	for (auto& v : vectors) {
+		v.xyz.x = dist(gen);
+		v.xyz.y = dist(gen);
+		v.xyz.z = dist(gen);
+	}
+	return vectors;
+}
+
+matrix test_matrix() {
+	angles angs = { 0.3f, 1.2f, -2.1f };
+	matrix m;
+	vm_angles_2_matrix(&m, &angs);
+	return m;
+}
+
+void expect_vec_near(const vec3d& expected, const vec3d& actual) {
+	ASSERT_NEAR(expected.xyz.x, actual.xyz.x, 1e-3f);
+	ASSERT_NEAR(expected.xyz.y, actual.xyz.y, 1e-3f);
+	ASSERT_NEAR(expected.xyz.z, actual.xyz.z, 1e-3f);
+}
+
+// Runs the test for every instruction set the cpu supports and restores the default afterwards
+template<typename Func>
+void for_each_instruction_set(Func f) {
+	int best = vm_batch_get_instruction_set();
+
+	for (int set = VM_BATCH_SCALAR; set <= best; ++set) {
+		SCOPED_TRACE(set);
+		vm_batch_set_instruction_set(set);
+
+		f();
+	}
+
+	vm_batch_set_instruction_set(best);
+}
+}
+
+// 37 vectors cover the 8 and 4 wide paths as well as the scalar tail
+TEST(VecmatBatchTest, transforms_match_single_vector_functions) {
+	auto src = random_vectors(37);
+	auto m = test_matrix();
+	vec3d origin = { { { 10.0f, -20.0f, 30.0f } } };
+
+	for_each_instruction_set([&]() {
+		SCP_vector<vec3d> dest(src.size());
+
+		vm_vec_rotate_batch(dest.data(), src.data(), src.size(), &m);
+		for (size_t i = 0; i < src.size(); ++i) {
+			vec3d expected;
+			vm_vec_rotate(&expected, &src[i], &m);
+			expect_vec_near(expected, dest[i]);
+		}
+
+		vm_vec_sub_rotate_batch(dest.data(), src.data(), src.size(), &origin, &m);
+		for (size_t i = 0; i < src.size(); ++i) {
+			vec3d tmp, expected;
+			vm_vec_sub(&tmp, &src[i], &origin);
+			vm_vec_rotate(&expected, &tmp, &m);
+			expect_vec_near(expected, dest[i]);
+		}
+
+		vm_vec_unrotate_batch(dest.data(), src.data(), src.size(), &m);
+		for (size_t i = 0; i < src.size(); ++i) {
+			vec3d expected;
+			vm_vec_unrotate(&expected, &src[i], &m);
+			expect_vec_near(expected, dest[i]);
+		}
+
+		// In place
+		dest = src;
+		vm_vec_unrotate_add_batch(dest.data(), dest.data(), dest.size(), &m, &origin);
+		for (size_t i = 0; i < src.size(); ++i) {
+			vec3d expected;
+			vm_vec_unrotate(&expected, &src[i], &m);
+			vm_vec_add2(&expected, &origin);
+			expect_vec_near(expected, dest[i]);
+		}
+	});
+}
+
+TEST(VecmatBatchTest, normalize_and_distance_match_single_vector_functions) {
+	auto src = random_vectors(37);
+	vm_vec_zero(&src[3]);
+	vm_vec_zero(&src[30]);
+	vec3d point = { { { 10.0f, -20.0f, 30.0f } } };
+
+	for_each_instruction_set([&]() {
+		auto normalized = src;
+		SCP_vector<float> mags(src.size());
+		vm_vec_normalize_safe_batch(normalized.data(), normalized.size(), mags.data());
+
+		SCP_vector<float> dists(src.size());
+		vm_vec_dist_squared_batch(dists.data(), &point, src.data(), src.size());
+
+		for (size_t i = 0; i < src.size(); ++i) {
+			vec3d expected = src[i];
+			float mag = vm_vec_normalize_safe(&expected);
+
+			ASSERT_FLOAT_EQ(mag, mags[i]);
+			ASSERT_FLOAT_EQ(expected.xyz.x, normalized[i].xyz.x);
+			ASSERT_FLOAT_EQ(expected.xyz.y, normalized[i].xyz.y);
+			ASSERT_FLOAT_EQ(expected.xyz.z, normalized[i].xyz.z);
+
+			ASSERT_FLOAT_EQ(vm_vec_dist_squared(&point, &src[i]), dists[i]);
+		}
+	});
+}
+
+// Microbenchmark comparing the instruction sets, run with --gtest_also_run_disabled_tests
+TEST(VecmatBatchTest, DISABLED_benchmark) {
+	const size_t count = 4096;
+	const int iterations = 2000;
+
+	auto src = random_vectors(count);
+	auto m = test_matrix();
+	vec3d origin = { { { 10.0f, -20.0f, 30.0f } } };
+	SCP_vector<vec3d> dest(count);
+
+	auto time_it = [&](const char* name, std::function<void()> f) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < iterations; ++i) {
+			f();
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+		std::cout << "  " << name << ": " << (double)ns / ((double)iterations * count) << " ns/vector" << std::endl;
+	};
+
+	for_each_instruction_set([&]() {
+		std::cout << "Instruction set " << vm_batch_get_instruction_set() << std::endl;
+
+		time_it("sub_rotate", [&]() { vm_vec_sub_rotate_batch(dest.data(), src.data(), count, &origin, &m); });
+		time_it("unrotate_add", [&]() { vm_vec_unrotate_add_batch(dest.data(), src.data(), count, &m, &origin); });
+		time_it("normalize_safe", [&]() {
+			dest = src;
+			vm_vec_normalize_safe_batch(dest.data(), count);
+		});
+	});
+
+	std::cout << "Single vector functions" << std::endl;
+	time_it("sub_rotate", [&]() {
+		for (size_t i = 0; i < count; ++i) {
+			vec3d tmp;
+			vm_vec_sub(&tmp, &src[i], &origin);
+			vm_vec_rotate(&dest[i], &tmp, &m);
+		}
+	});
+}
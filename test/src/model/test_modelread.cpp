@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <model/model.h>
+
+#include "util/FSTestFixture.h"
+
+class ModelReadTest : public test::FSTestFixture {
+ public:
+	ModelReadTest() : test::FSTestFixture(INIT_CFILE) {
+		pushModDir("model");
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+	}
+	void TearDown() override {
+		test::FSTestFixture::TearDown();
+	}
+};
+
+TEST_F(ModelReadTest, read_bounding_box) {
+	vec3d mins, maxs;
+
+	// The header is not the first chunk of this model and its z values are inverted
+	ASSERT_TRUE(model_read_bounding_box("box.pof", &mins, &maxs));
+
+	ASSERT_FLOAT_EQ(-1.0f, mins.xyz.x);
+	ASSERT_FLOAT_EQ(-2.0f, mins.xyz.y);
+	ASSERT_FLOAT_EQ(-3.0f, mins.xyz.z);
+
+	ASSERT_FLOAT_EQ(1.0f, maxs.xyz.x);
+	ASSERT_FLOAT_EQ(2.0f, maxs.xyz.y);
+	ASSERT_FLOAT_EQ(6.0f, maxs.xyz.z);
+
+	ASSERT_FALSE(model_read_bounding_box("missing.pof", &mins, &maxs));
+}
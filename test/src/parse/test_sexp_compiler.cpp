@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <parse/parselo.h>
+#include <parse/sexp.h>
+#include <parse/sexp/sexp_compiler.h>
+
+#include "util/FSTestFixture.h"
+
+class SexpCompilerTest : public test::FSTestFixture {
+ public:
+	SexpCompilerTest() : test::FSTestFixture(INIT_CFILE) {
+	}
+
+ protected:
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		init_sexp();
+	}
+	void TearDown() override {
+		sexp::clear_compiled_formulas();
+
+		test::FSTestFixture::TearDown();
+	}
+
+	static int parse_formula(const char* text) {
+		char buf[TOKEN_LENGTH * 4];
+		strcpy_s(buf, text);
+
+		char* oldMp = Mp;
+		Mp = buf;
+		int node = get_sexp_main();
+		Mp = oldMp;
+
+		return node;
+	}
+
+	static SCP_vector<int> node_values() {
+		SCP_vector<int> values;
+		for (int i = 0; i < Num_sexp_nodes; i++) {
+			values.push_back(Sexp_nodes[i].value);
+		}
+		return values;
+	}
+};
+
+// Evaluates every formula a few times with the tree interpreter and with the compiled form and checks that the
+// results and everything that is left behind in the nodes is identical
+TEST_F(SexpCompilerTest, matches_tree_interpreter) {
+	const char* formulas[] = {
+		"( true )",
+		"( false )",
+		"( and ( true ) ( = 1 1 ) )",
+		"( and ( true ) ( false ) ( = 1 1 ) )",
+		"( or ( false ) ( < 1 2 ) )",
+		"( or ( false ) ( false ) )",
+		"( not ( false ) )",
+		"( not ( > 1 2 ) )",
+		"( = ( + 1 2 3 ) 6 )",
+		"( = ( - 10 3 2 ) ( * 5 1 ) )",
+		"( >= ( / 100 7 ) ( mod 100 7 ) )",
+		"( <= 1 2 3 )",
+		"( != 1 2 1 )",
+		"( > ( + ( * 2 3 ) ( - 4 5 ) ) 4 3 )",
+		"( xor ( true ) ( < 2 1 ) )",
+		"( < ( abs ( - 1 5 ) ) ( + 2 3 ) )",
+		"( has-time-elapsed ( - 1 5 ) )",
+		"( when ( and ( true ) ( = 2 ( + 1 1 ) ) ) ( do-nothing ) )",
+		"( when ( or ( false ) ( > 1 2 ) ) ( do-nothing ) )",
+		"( when ( false ) ( do-nothing ) )",
+		"( when ( true ) ( do-nothing ) ( do-nothing ) )",
+	};
+
+	for (auto text : formulas) {
+		SCOPED_TRACE(text);
+
+		int node = parse_formula(text);
+		ASSERT_GE(node, 0);
+
+		SCP_vector<int> tree_results;
+		for (int i = 0; i < 3; i++) {
+			tree_results.push_back(eval_sexp(node));
+		}
+		auto tree_values = node_values();
+
+		flush_sexp_tree(node);
+		sexp::compile_formula(node);
+
+		SCP_vector<int> compiled_results;
+		for (int i = 0; i < 3; i++) {
+			compiled_results.push_back(sexp::eval_formula(node));
+		}
+		auto compiled_values = node_values();
+
+		ASSERT_EQ(tree_results, compiled_results);
+		ASSERT_EQ(tree_values, compiled_values);
+
+		free_sexp2(node);
+	}
+}
+
+TEST_F(SexpCompilerTest, only_compiles_when_useful) {
+	ASSERT_TRUE(sexp::compile_formula(parse_formula("( and ( true ) ( = 1 1 ) )")));
+	ASSERT_TRUE(sexp::compile_formula(parse_formula("( when ( true ) ( do-nothing ) )")));
+	ASSERT_FALSE(sexp::compile_formula(parse_formula("( xor ( true ) ( false ) )")));
+	ASSERT_FALSE(sexp::compile_formula(-1));
+}
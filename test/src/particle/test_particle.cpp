@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+#include "particle/particle.h"
+
+class ParticleTest : public ::testing::Test {
+ protected:
+	void TearDown() override { particle::kill_all(); }
+
+	static particle::WeakParticlePtr create_debug_particle(float lifetime)
+	{
+		particle::particle_info info;
+		info.type = particle::PARTICLE_DEBUG;
+		info.lifetime = lifetime;
+		info.rad = 1.0f;
+
+		return particle::createPersistent(&info);
+	}
+};
+
+TEST_F(ParticleTest, persistent_handle_expires_with_particle) {
+	auto short_lived = create_debug_particle(1.0f);
+	auto long_lived = create_debug_particle(10.0f);
+
+	ASSERT_FALSE(short_lived.expired());
+	ASSERT_FALSE(long_lived.expired());
+
+	particle::move_all(2.0f);
+	particle::move_all(2.0f);
+
+	ASSERT_TRUE(short_lived.expired());
+	ASSERT_EQ(nullptr, short_lived.lock());
+
+	// The remaining particle has been moved in memory but the handle still has to find it
+	ASSERT_FALSE(long_lived.expired());
+	ASSERT_FLOAT_EQ(10.0f, long_lived.lock()->max_life);
+}
+
+TEST_F(ParticleTest, reused_slot_does_not_revive_handle) {
+	auto old_handle = create_debug_particle(1.0f);
+
+	particle::move_all(2.0f);
+	particle::move_all(2.0f);
+	ASSERT_TRUE(old_handle.expired());
+
+	auto new_handle = create_debug_particle(5.0f);
+
+	ASSERT_NE(old_handle, new_handle);
+	ASSERT_TRUE(old_handle.expired());
+	ASSERT_FALSE(new_handle.expired());
+	ASSERT_FLOAT_EQ(5.0f, new_handle.lock()->max_life);
+}
+
+TEST_F(ParticleTest, kill_all_expires_handles) {
+	auto handle = create_debug_particle(10.0f);
+	ASSERT_FALSE(handle.expired());
+
+	particle::kill_all();
+
+	ASSERT_TRUE(handle.expired());
+	ASSERT_FALSE(particle::WeakParticlePtr().lock());
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <math/vecmat.h>
+#include <physics/physics.h>
+
+#include <random>
+
+namespace {
+float random_float(std::mt19937& gen, float range) {
+	std::uniform_real_distribution<float> dist(-range, range);
+	return dist(gen);
+}
+}
+
+// 37 objects cover the 8 and 4 wide paths as well as the scalar tail
+TEST(PhysicsTest, const_vel_batch_matches_physics_sim) {
+	const size_t count = 37;
+	const float frametime = 0.016f;
+
+	std::mt19937 gen(1234);
+
+	SCP_vector<vec3d> positions(count);
+	SCP_vector<physics_info> infos(count);
+	for (size_t i = 0; i < count; ++i) {
+		positions[i].xyz.x = random_float(gen, 10000.0f);
+		positions[i].xyz.y = random_float(gen, 10000.0f);
+		positions[i].xyz.z = random_float(gen, 10000.0f);
+
+		physics_init(&infos[i]);
+		infos[i].flags |= PF_CONST_VEL;
+		infos[i].vel.xyz.x = random_float(gen, 1000.0f);
+		infos[i].vel.xyz.y = random_float(gen, 1000.0f);
+		infos[i].vel.xyz.z = random_float(gen, 1000.0f);
+	}
+
+	SCP_vector<vec3d> expected = positions;
+	for (size_t i = 0; i < count; ++i) {
+		matrix orient = vmd_identity_matrix;
+		physics_sim(&expected[i], &orient, &infos[i], frametime);
+	}
+
+	SCP_vector<vec3d> vels(count);
+	for (size_t i = 0; i < count; ++i) {
+		vels[i] = infos[i].vel;
+	}
+
+	int best = vm_batch_get_instruction_set();
+
+	for (int set = VM_BATCH_SCALAR; set <= best; ++set) {
+		SCOPED_TRACE(set);
+		vm_batch_set_instruction_set(set);
+
+		auto batch = positions;
+		physics_sim_const_vel_batch(batch.data(), vels.data(), count, frametime);
+
+		for (size_t i = 0; i < count; ++i) {
+			ASSERT_EQ(expected[i].xyz.x, batch[i].xyz.x);
+			ASSERT_EQ(expected[i].xyz.y, batch[i].xyz.y);
+			ASSERT_EQ(expected[i].xyz.z, batch[i].xyz.z);
+		}
+	}
+
+	vm_batch_set_instruction_set(best);
+}
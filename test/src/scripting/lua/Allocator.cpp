@@ -0,0 +1,55 @@
+
+#include "TestUtil.h"
+
+#include "scripting/lua/LuaAllocator.h"
+
+using namespace luacpp;
+
+TEST(LuaAllocatorTest, Realloc) {
+	LuaAllocator allocator;
+
+	auto block = static_cast<char*>(LuaAllocator::allocate(&allocator, nullptr, 0, 20));
+	ASSERT_NE(nullptr, block);
+	strcpy(block, "0123456789");
+
+	// Same size class, the block stays where it is
+	ASSERT_EQ(block, LuaAllocator::allocate(&allocator, block, 20, 30));
+
+	// Moving between size classes and to and from the heap keeps the contents
+	block = static_cast<char*>(LuaAllocator::allocate(&allocator, block, 30, 100));
+	ASSERT_STREQ("0123456789", block);
+	block = static_cast<char*>(LuaAllocator::allocate(&allocator, block, 100, 1000));
+	ASSERT_STREQ("0123456789", block);
+	block = static_cast<char*>(LuaAllocator::allocate(&allocator, block, 1000, 11));
+	ASSERT_STREQ("0123456789", block);
+
+	ASSERT_EQ((size_t)11, allocator.stats().bytes_in_use);
+
+	ASSERT_EQ(nullptr, LuaAllocator::allocate(&allocator, block, 11, 0));
+	ASSERT_EQ((size_t)0, allocator.stats().bytes_in_use);
+}
+
+TEST(LuaAllocatorTest, ReusesFreedBlocks) {
+	LuaAllocator allocator;
+
+	auto first = LuaAllocator::allocate(&allocator, nullptr, 0, 48);
+	LuaAllocator::allocate(&allocator, first, 48, 0);
+
+	ASSERT_EQ(first, LuaAllocator::allocate(&allocator, nullptr, 0, 40));
+}
+
+TEST(LuaAllocatorTest, LuaState) {
+	LuaAllocator allocator;
+
+	auto L = lua_newstate(LuaAllocator::allocate, &allocator);
+	luaL_openlibs(L);
+
+	ASSERT_EQ(0, luaL_dostring(L, "local t = {} for i = 1, 10000 do t[i] = { tostring(i) } end collectgarbage()"));
+
+	ASSERT_GT(allocator.stats().allocations, (uint64_t)20000);
+
+	lua_close(L);
+
+	ASSERT_EQ((size_t)0, allocator.stats().bytes_in_use);
+	ASSERT_EQ(allocator.stats().allocations, allocator.stats().frees);
+}
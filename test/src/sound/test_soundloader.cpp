@@ -0,0 +1,305 @@
+#include <cfile/cfile.h>
+#include <cmdline/cmdline.h>
+#include <libs/ffmpeg/FFmpeg.h>
+#include <sound/audiostr.h>
+#include <sound/ds.h>
+#include <sound/ffmpeg/WaveFile.h>
+#include <sound/sound.h>
+#include <sound/soundloader.h>
+#include <gtest/gtest.h>
+
+#include "util/FSTestFixture.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <unistd.h>
+#include <utime.h>
+#endif
+
+namespace {
+SCP_string join(const SCP_string& dir, const char* name) {
+	return dir + DIR_SEPARATOR_CHAR + name;
+}
+
+void write_file(const SCP_string& path, const SCP_vector<uint8_t>& data) {
+	FILE* fp = fopen(path.c_str(), "wb");
+	ASSERT_TRUE(fp != nullptr);
+	ASSERT_EQ((size_t)1, fwrite(data.data(), data.size(), 1, fp));
+	fclose(fp);
+}
+
+void put_le(SCP_vector<uint8_t>& out, uint32_t value, int size) {
+	for (int i = 0; i < size; ++i) {
+		out.push_back((uint8_t)(value >> (8 * i)));
+	}
+}
+
+// A 16 bit PCM wave file with a different tone in every channel
+SCP_vector<uint8_t> make_wav(int channels, int sample_rate, int num_frames) {
+	const uint32_t data_size = (uint32_t)(num_frames * channels * 2);
+
+	SCP_vector<uint8_t> wav;
+	wav.insert(wav.end(), {'R', 'I', 'F', 'F'});
+	put_le(wav, 36 + data_size, 4);
+	wav.insert(wav.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+	put_le(wav, 16, 4);
+	put_le(wav, 1, 2); // PCM
+	put_le(wav, (uint32_t)channels, 2);
+	put_le(wav, (uint32_t)sample_rate, 4);
+	put_le(wav, (uint32_t)(sample_rate * channels * 2), 4);
+	put_le(wav, (uint32_t)(channels * 2), 2);
+	put_le(wav, 16, 2);
+	wav.insert(wav.end(), {'d', 'a', 't', 'a'});
+	put_le(wav, data_size, 4);
+
+	for (int i = 0; i < num_frames; ++i) {
+		for (int c = 0; c < channels; ++c) {
+			auto sample = (int16_t)(10000.0 * sin(2.0 * PI * 440.0 * (c + 1) * i / sample_rate));
+			put_le(wav, (uint16_t)sample, 2);
+		}
+	}
+
+	return wav;
+}
+
+void set_modification_time(const SCP_string& path, time_t time) {
+	struct utimbuf times;
+	times.actime = time;
+	times.modtime = time;
+	utime(path.c_str(), &times);
+}
+}
+
+TEST(SoundLoaderCacheTest, cache_round_trip) {
+	snd_decoded_sound sound;
+	sound.source_channels = 2;
+	sound.pcm.format = AL_FORMAT_MONO16;
+	sound.pcm.sample_rate = 22050;
+	sound.pcm.n_channels = 1;
+	sound.pcm.bits_per_sample = 16;
+	sound.pcm.duration = 0.5;
+	for (int i = 0; i < 1000; ++i) {
+		sound.pcm.data.push_back((uint8_t)i);
+	}
+
+	auto path = ::testing::TempDir() + "snd_pcm-round_trip.bin";
+	snd_loader_write_cache(path, sound);
+
+	snd_decoded_sound read;
+	ASSERT_TRUE(snd_loader_read_cache(path, read));
+
+	ASSERT_EQ(sound.source_channels, read.source_channels);
+	ASSERT_EQ(sound.pcm.format, read.pcm.format);
+	ASSERT_EQ(sound.pcm.sample_rate, read.pcm.sample_rate);
+	ASSERT_EQ(sound.pcm.n_channels, read.pcm.n_channels);
+	ASSERT_EQ(sound.pcm.bits_per_sample, read.pcm.bits_per_sample);
+	ASSERT_EQ(sound.pcm.duration, read.pcm.duration);
+	ASSERT_EQ(sound.pcm.data, read.pcm.data);
+
+	// A file that ends early is not used
+	write_file(path, SCP_vector<uint8_t>(sound.pcm.data.begin(), sound.pcm.data.begin() + 40));
+	ASSERT_FALSE(snd_loader_read_cache(path, read));
+
+	remove(path.c_str());
+	ASSERT_FALSE(snd_loader_read_cache(path, read));
+}
+
+class SoundLoaderTest : public test::FSTestFixture {
+ public:
+	SoundLoaderTest() : test::FSTestFixture(INIT_NONE) {
+	}
+
+ protected:
+	SCP_string _root;
+	char _working_dir[CF_MAX_PATHNAME_LENGTH];
+	bool _cfile_inited = false;
+	bool _sound_inited = false;
+
+	void SetUp() override {
+		test::FSTestFixture::SetUp();
+
+		// cfile changes into the directory of the test root, which is deleted at the end
+		ASSERT_TRUE(_getcwd(_working_dir, sizeof(_working_dir)) != 0);
+
+		// The cache is written to the game root so it has to be somewhere temporary
+		_root = ::testing::TempDir() + "soundloader_test";
+		_mkdir(_root.c_str());
+		_mkdir(data_dir().c_str());
+		_mkdir(join(data_dir(), "sounds").c_str());
+		_mkdir(cache_dir().c_str());
+
+		write_file(join(join(data_dir(), "sounds"), "mono.wav"), make_wav(1, 22050, 11025));
+		write_file(join(join(data_dir(), "sounds"), "stereo.wav"), make_wav(2, 44100, 22050));
+
+		// Cfile expects something after the path
+		ASSERT_FALSE(cfile_init(join(_root, "test").c_str()));
+		_cfile_inited = true;
+
+		// OpenAL Soft can run without an audio device
+#ifdef _WIN32
+		_putenv_s("ALSOFT_DRIVERS", "null");
+#else
+		setenv("ALSOFT_DRIVERS", "null", 1);
+#endif
+
+		libs::ffmpeg::initialize();
+
+		Cmdline_no_async_sound = false;
+		Cmdline_no_sound_cache = false;
+
+		if (!snd_init()) {
+			GTEST_SKIP() << "OpenAL could not be initialized";
+		}
+		_sound_inited = true;
+	}
+	void TearDown() override {
+		if (_sound_inited) {
+			audiostream_close();
+			snd_close();
+		}
+
+		if (_cfile_inited) {
+			for (auto& name : cache_files()) {
+				remove(join(cache_dir(), (name + ".bin").c_str()).c_str());
+			}
+
+			cfile_close();
+		}
+
+		_chdir(_working_dir);
+
+		remove(join(join(data_dir(), "sounds"), "mono.wav").c_str());
+		remove(join(join(data_dir(), "sounds"), "stereo.wav").c_str());
+		rmdir(cache_dir().c_str());
+		rmdir(join(data_dir(), "sounds").c_str());
+		rmdir(data_dir().c_str());
+		rmdir(_root.c_str());
+
+		Cmdline_no_async_sound = false;
+
+		test::FSTestFixture::TearDown();
+	}
+
+	SCP_string data_dir() const { return join(_root, "data"); }
+	SCP_string cache_dir() const { return join(data_dir(), "cache"); }
+
+	SCP_vector<SCP_string> cache_files() const {
+		SCP_vector<SCP_string> names;
+		cf_get_file_list(names, CF_TYPE_CACHE, "snd_pcm-*.bin", CF_SORT_NONE, nullptr,
+		                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+		return names;
+	}
+
+	static snd_decoded_sound decode_in_background(const char* filename, bool mono) {
+		snd_decoded_sound result;
+		EXPECT_TRUE(snd_loader_queue(-1, -1, filename, mono));
+		EXPECT_TRUE(snd_loader_get_decoded(result, true));
+		EXPECT_TRUE(result.success);
+		return result;
+	}
+};
+
+TEST_F(SoundLoaderTest, background_decode_matches_direct_decode) {
+	for (auto mono : {false, true}) {
+		SCOPED_TRACE(mono);
+
+		auto result = decode_in_background("stereo.wav", mono);
+		ASSERT_EQ(2, result.source_channels);
+
+		ffmpeg::WaveFile audio_file;
+		ASSERT_TRUE(audio_file.Open("stereo.wav", false));
+		if (mono) {
+			auto current = audio_file.getAudioProperties();
+			current.channel_layout = AV_CH_LAYOUT_MONO;
+			audio_file.setAdjustedAudioProperties(current);
+		}
+
+		ds_pcm_data expected;
+		ASSERT_TRUE(ds_decode_file(&audio_file, &expected));
+
+		ASSERT_EQ(expected.format, result.pcm.format);
+		ASSERT_EQ(expected.sample_rate, result.pcm.sample_rate);
+		ASSERT_EQ(expected.n_channels, result.pcm.n_channels);
+		ASSERT_EQ(expected.bits_per_sample, result.pcm.bits_per_sample);
+		ASSERT_EQ(expected.data, result.pcm.data);
+	}
+}
+
+TEST_F(SoundLoaderTest, preload_matches_synchronous_load) {
+	for (auto flags : {0, GAME_SND_USE_DS3D}) {
+		SCOPED_TRACE(flags);
+
+		int sizes[2], bits[2], frequencies[2], durations[2];
+
+		for (int async = 0; async < 2; ++async) {
+			Cmdline_no_async_sound = async == 0;
+
+			game_snd_entry entry;
+			strcpy_s(entry.filename, "stereo.wav");
+
+			auto id = snd_preload(&entry, flags);
+			ASSERT_TRUE(id.isValid());
+
+			ASSERT_EQ(0, snd_size(id, &sizes[async]));
+			snd_get_format(id, &bits[async], &frequencies[async]);
+			durations[async] = snd_get_duration(id);
+
+			snd_unload_all();
+		}
+
+		ASSERT_GT(sizes[0], 0);
+		ASSERT_EQ(sizes[0], sizes[1]);
+		ASSERT_EQ(bits[0], bits[1]);
+		ASSERT_EQ(frequencies[0], frequencies[1]);
+		ASSERT_EQ(durations[0], durations[1]);
+	}
+}
+
+TEST_F(SoundLoaderTest, decoded_sounds_are_cached) {
+	auto decoded = decode_in_background("mono.wav", false);
+	ASSERT_FALSE(decoded.from_cache);
+	ASSERT_EQ((size_t)1, cache_files().size());
+
+	auto cached = decode_in_background("mono.wav", false);
+	ASSERT_TRUE(cached.from_cache);
+	ASSERT_EQ(decoded.pcm.format, cached.pcm.format);
+	ASSERT_EQ(decoded.pcm.sample_rate, cached.pcm.sample_rate);
+	ASSERT_EQ(decoded.pcm.duration, cached.pcm.duration);
+	ASSERT_EQ(decoded.pcm.data, cached.pcm.data);
+
+	// The output format is part of the key
+	auto mono = decode_in_background("mono.wav", true);
+	ASSERT_FALSE(mono.from_cache);
+	ASSERT_EQ((size_t)2, cache_files().size());
+}
+
+TEST_F(SoundLoaderTest, pruning_removes_least_recently_used_sounds) {
+	decode_in_background("mono.wav", false);
+	auto stereo = decode_in_background("stereo.wav", false);
+
+	auto names = cache_files();
+	ASSERT_EQ((size_t)2, names.size());
+
+	// Make every file old, then use the stereo sound again which marks it as recently used
+	for (auto& name : names) {
+		set_modification_time(join(cache_dir(), (name + ".bin").c_str()), time(nullptr) - 1000);
+	}
+	ASSERT_TRUE(decode_in_background("stereo.wav", false).from_cache);
+
+	// Only the stereo sound fits
+	snd_loader_prune_cache(stereo.pcm.data.size() + 1024);
+
+	ASSERT_EQ((size_t)1, cache_files().size());
+	ASSERT_TRUE(decode_in_background("stereo.wav", false).from_cache);
+	ASSERT_FALSE(decode_in_background("mono.wav", false).from_cache);
+
+	// Everything fits so nothing is removed
+	snd_loader_prune_cache(100 * 1024 * 1024);
+	ASSERT_EQ((size_t)2, cache_files().size());
+}
@@ -6,18 +6,29 @@ add_file_folder(""
     test_stubs.cpp
 )
 
+add_file_folder("Asteroid"
+    asteroid/test_asteroid.cpp
+)
+
 add_file_folder("CFile"
     cfile/cfile.cpp
+    cfile/test_filelist_cache.cpp
 )
 
 add_file_folder("Globalincs"
     globalincs/test_flagset.cpp
+    globalincs/test_frame_arena.cpp
     globalincs/test_safe_strings.cpp
     globalincs/test_version.cpp
 )
 
 add_file_folder("Graphics"
 	   graphics/test_font.cpp
+	   graphics/test_grstub.cpp
+)
+
+add_file_folder("Math"
+    math/test_vecmat_batch.cpp
 )
 
 add_file_folder("menuui"
@@ -28,8 +39,21 @@ add_file_folder("mod"
     mod/test_mod_table.cpp
 )
 
+add_file_folder("Model"
+    model/test_modelread.cpp
+)
+
 add_file_folder("Parse"
     parse/test_parselo.cpp
+    parse/test_sexp_compiler.cpp
+)
+
+add_file_folder("Particle"
+    particle/test_particle.cpp
+)
+
+add_file_folder("Physics"
+    physics/test_physics.cpp
 )
 
 add_file_folder("Pilotfile"
@@ -50,6 +74,7 @@ add_file_folder("Scripting\\\\API"
 )
 
 add_file_folder("Scripting\\\\Lua"
+    scripting/lua/Allocator.cpp
     scripting/lua/Args.cpp
     scripting/lua/Convert.cpp
     scripting/lua/Function.cpp
@@ -60,6 +85,10 @@ add_file_folder("Scripting\\\\Lua"
     scripting/lua/Value.cpp
 )
 
+add_file_folder("Sound"
+    sound/test_soundloader.cpp
+)
+
 add_file_folder("Test Util"
     util/FSTestFixture.cpp
     util/FSTestFixture.h
@@ -68,6 +97,8 @@ add_file_folder("Test Util"
 
 add_file_folder("Utils"
     utils/HeapAllocatorTest.cpp
+    utils/ParallelTest.cpp
+    utils/RadixSortTest.cpp
 )
 
 add_file_folder("Weapon"
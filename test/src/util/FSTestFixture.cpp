@@ -15,6 +15,8 @@ test::FSTestFixture::FSTestFixture(uint64_t init_flags) : testing::Test(), _init
 	addCommandlineArg("-parse_cmdline_only");
 	addCommandlineArg("-standalone");
 	addCommandlineArg("-portable_mode");
+	// The test data lives in the source tree, so the file list cache must not be written there
+	addCommandlineArg("-no_filelist_cache");
 }
 void test::FSTestFixture::SetUp() {
 	auto currentTest = ::testing::UnitTest::GetInstance()->current_test_info();
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <atomic>
+
+#include "utils/parallel.h"
+
+using namespace util;
+
+TEST(ParallelTests, processesEveryElementOnce) {
+	SCP_vector<int> visits(10000, 0);
+
+	// Run several times so the worker threads get reused
+	for (int run = 0; run < 20; ++run) {
+		parallel_for(visits.size(), 16, [&visits](size_t begin, size_t end) {
+			for (auto i = begin; i < end; ++i) {
+				++visits[i];
+			}
+		});
+	}
+
+	for (auto count : visits) {
+		ASSERT_EQ(20, count);
+	}
+}
+
+TEST(ParallelTests, respectsMinimumChunkSize) {
+	std::atomic<size_t> calls(0);
+
+	parallel_for(100, 100, [&calls](size_t begin, size_t end) {
+		ASSERT_EQ((size_t)0, begin);
+		ASSERT_EQ((size_t)100, end);
+		++calls;
+	});
+
+	ASSERT_EQ((size_t)1, calls.load());
+
+	parallel_for(0, 1, [&calls](size_t, size_t) { ++calls; });
+
+	ASSERT_EQ((size_t)1, calls.load());
+}
+
+TEST(ParallelTests, restartsAfterShutdown) {
+	parallel_shutdown();
+
+	std::atomic<size_t> sum(0);
+	parallel_for(1000, 1, [&sum](size_t begin, size_t end) {
+		for (auto i = begin; i < end; ++i) {
+			sum += i;
+		}
+	});
+
+	ASSERT_EQ((size_t)(999 * 1000 / 2), sum.load());
+}
@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+#include "utils/RadixSort.h"
+
+using namespace util;
+
+namespace {
+SCP_vector<RadixSortEntry> random_entries(size_t count, std::uint64_t key_mask) {
+	std::mt19937_64 gen(42);
+
+	SCP_vector<RadixSortEntry> entries(count);
+	for (size_t i = 0; i < count; ++i) {
+		entries[i].key = gen() & key_mask;
+		entries[i].index = (int)i;
+	}
+	return entries;
+}
+
+void check_sorted(SCP_vector<RadixSortEntry> entries) {
+	auto expected = entries;
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const RadixSortEntry& a, const RadixSortEntry& b) { return a.key < b.key; });
+
+	SCP_vector<RadixSortEntry> scratch;
+	radix_sort(entries, scratch);
+
+	ASSERT_EQ(expected.size(), entries.size());
+	for (size_t i = 0; i < entries.size(); ++i) {
+		ASSERT_EQ(expected[i].key, entries[i].key);
+		ASSERT_EQ(expected[i].index, entries[i].index);
+	}
+}
+}
+
+TEST(RadixSortTests, fullKeys) {
+	check_sorted(random_entries(5000, ~UINT64_C(0)));
+}
+
+TEST(RadixSortTests, duplicateKeysKeepOrder) {
+	// Only a few different keys in the upper bits so most passes are skipped and ties have to stay stable
+	check_sorted(random_entries(5000, UINT64_C(0x0F00000000000000)));
+}
+
+TEST(RadixSortTests, smallInput) {
+	check_sorted(random_entries(10, UINT64_C(0xFF)));
+	check_sorted(SCP_vector<RadixSortEntry>());
+}